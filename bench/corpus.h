@@ -0,0 +1,105 @@
+/*
+ corpus.h
+
+ MIT License
+
+ Copyright (c) 2026 uChttpserver contributors
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+  Created on: Oct 18, 2026
+      Author: uChttpserver contributors
+ */
+
+#ifndef BENCH_CORPUS_H_
+#define BENCH_CORPUS_H_
+
+/*****************************************************************************/
+/* Requests shared by the host and Cortex-M parser benchmarks                */
+/*****************************************************************************/
+
+/* Names every corpus request targets, present in each table                 */
+#define BENCH_CORPUS_RESOURCES (5U)
+
+typedef struct BenchCorpus
+{
+  const char *name;
+  const char *data;
+  unsigned int requests;        /* Responses expected per pass */
+} tBenchCorpus;
+
+static const char *const corpusResources[BENCH_CORPUS_RESOURCES] = {
+  "/api/v1/items",
+  "/favicon.ico",
+  "/index.html",
+  "/login",
+  "/static/app.js"
+};
+
+static const tBenchCorpus corpora[] = {
+  {"curl",
+        "GET /index.html HTTP/1.1\r\n"
+        "Host: device.local\r\n"
+        "User-Agent: curl/8.5.0\r\n"
+        "Accept: */*\r\n"
+        "\r\n", 1U},
+  {"browser",
+        "GET /static/app.js HTTP/1.1\r\n"
+        "Host: device.local\r\n"
+        "Connection: keep-alive\r\n"
+        "sec-ch-ua: \"Chromium\";v=\"124\", \"Google Chrome\";v=\"124\", "
+        "\"Not-A.Brand\";v=\"99\"\r\n"
+        "sec-ch-ua-mobile: ?0\r\n"
+        "User-Agent: Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 "
+        "(KHTML, like Gecko) Chrome/124.0.0.0 Safari/537.36\r\n"
+        "sec-ch-ua-platform: \"Linux\"\r\n"
+        "Accept: */*\r\n"
+        "Sec-Fetch-Site: same-origin\r\n"
+        "Sec-Fetch-Mode: no-cors\r\n"
+        "Sec-Fetch-Dest: script\r\n"
+        "Referer: http://device.local/index.html\r\n"
+        "Accept-Encoding: gzip, deflate, br, zstd\r\n"
+        "Accept-Language: en-US,en;q=0.9,pl;q=0.8\r\n"
+        "Cookie: session=5f2b7c1e9a0d4e3f8b6a2c1d0e9f8a7b; theme=dark; "
+        "lang=en; _ga=GA1.1.1234567890.1700000000\r\n"
+        "If-None-Match: \"5d41402abc4b2a76b9719d911017c592\"\r\n"
+        "\r\n", 1U},
+  {"form-post",
+        "POST /login HTTP/1.1\r\n"
+        "Host: device.local\r\n"
+        "User-Agent: Mozilla/5.0 (X11; Linux x86_64; rv:125.0) "
+        "Gecko/20100101 Firefox/125.0\r\n"
+        "Accept: text/html,application/xhtml+xml\r\n"
+        "Content-Type: application/x-www-form-urlencoded\r\n"
+        "Content-Length: 44\r\n"
+        "Origin: http://device.local\r\n"
+        "\r\n"
+        "user=admin&password=s3cr3t%21&remember=on&x=", 1U},
+  {"pipelined",
+        "GET /api/v1/items?page=1 HTTP/1.1\r\nHost: device.local\r\n\r\n"
+        "GET /api/v1/items?page=2 HTTP/1.1\r\nHost: device.local\r\n\r\n"
+        "GET /favicon.ico HTTP/1.1\r\nHost: device.local\r\n\r\n"
+        "GET /index.html HTTP/1.1\r\nHost: device.local\r\n\r\n"
+        "GET /api/v1/items?page=3 HTTP/1.1\r\nHost: device.local\r\n\r\n"
+        "GET /static/app.js HTTP/1.1\r\nHost: device.local\r\n\r\n"
+        "GET /api/v1/items?page=4 HTTP/1.1\r\nHost: device.local\r\n\r\n"
+        "GET /favicon.ico HTTP/1.1\r\nHost: device.local\r\n\r\n", 8U}
+};
+
+#endif /* BENCH_CORPUS_H_ */
@@ -0,0 +1,341 @@
+/*
+ cortex-m-bench.c
+
+ MIT License
+
+ Copyright (c) 2026 uChttpserver contributors
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+  Created on: Oct 18, 2026
+      Author: uChttpserver contributors
+ */
+
+/*****************************************************************************/
+/* Includes                                                                  */
+/*****************************************************************************/
+
+#include "uchttpserver.h"
+#include "corpus.h"
+#include "startup.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*****************************************************************************/
+/* Defines                                                                   */
+/*****************************************************************************/
+
+/* Tables the size of a device web interface, RAM is counted in kilobytes  */
+#define BENCH_MAX_RESOURCES (100U)
+#define BENCH_NAME_LENGTH (16U)
+
+/* Corpus passes per case */
+#ifndef BENCH_PASSES
+#define BENCH_PASSES (16U)
+#endif
+
+/* Frequency of the counted clock, MPS2 boards run at 25 MHz */
+#ifndef BENCH_CORE_HZ
+#define BENCH_CORE_HZ (25000000UL)
+#endif
+
+#ifndef BENCH_CPU
+#define BENCH_CPU "cortex-m"
+#endif
+
+/* Count with DWT CYCCNT - real silicon only, QEMU does not model it */
+#ifndef BENCH_DWT
+#define BENCH_DWT (0)
+#endif
+
+#define BENCH_REGISTER(address) (*(volatile unsigned long *) (address))
+#define BENCH_SYST_CSR BENCH_REGISTER(0xE000E010UL)
+#define BENCH_SYST_RVR BENCH_REGISTER(0xE000E014UL)
+#define BENCH_SYST_CVR BENCH_REGISTER(0xE000E018UL)
+#define BENCH_DEMCR BENCH_REGISTER(0xE000EDFCUL)
+#define BENCH_DWT_CTRL BENCH_REGISTER(0xE0001000UL)
+#define BENCH_DWT_CYCCNT BENCH_REGISTER(0xE0001004UL)
+
+/*****************************************************************************/
+/* Type definitions                                                          */
+/*****************************************************************************/
+
+typedef struct BenchConnection
+{
+  unsigned long responses;
+  unsigned long errors;
+} tBenchConnection;
+
+/*****************************************************************************/
+/* Local functions (declarations)                                            */
+/*****************************************************************************/
+
+void SysTick_Handler(
+    void);
+
+static unsigned int Bench_Send(
+    void *const conn,
+    const char *data,
+    unsigned int length);
+static void Bench_Error(
+    void *const conn,
+    const tErrorInfo *errorInfo);
+static tHttpStatusCode Bench_Resource(
+    void *const conn);
+
+static int Bench_CompareNames(
+    const void *a,
+    const void *b);
+static unsigned int Bench_BuildTable(
+    unsigned int length);
+
+static void Bench_StartCounter(
+    void);
+static unsigned long long Bench_Cycles(
+    void);
+
+/*****************************************************************************/
+/* Local variables and constants                                             */
+/*****************************************************************************/
+
+/* Input delivered per Http_Input call, 0 - whole corpus at once */
+static const unsigned int fragments[] = { 1U, 7U, 1460U, 0U };
+
+static const unsigned int tableSizes[] = { 10U, 100U };
+
+static char names[BENCH_MAX_RESOURCES][BENCH_NAME_LENGTH];
+static tResourceEntry table[BENCH_MAX_RESOURCES];
+
+/* Connection lives in bss like it would in firmware, not on the stack     */
+static tuCHttpServerState sm;
+
+static volatile unsigned long overflows;
+
+/*****************************************************************************/
+/* Entry point                                                               */
+/*****************************************************************************/
+
+int main(
+    void)
+{
+  unsigned int c;
+  unsigned int t;
+  unsigned int f;
+  unsigned long failed = 0UL;
+  int first = 1;
+  char line[192];
+
+  Bench_StartCounter();
+  snprintf(line, sizeof(line), "{\n  \"benchmark\": \"cortex-m\",\n"
+      "  \"cpu\": \"%s\",\n  \"counter\": \"%s\",\n  \"core_hz\": %lu,\n"
+      "  \"state_bytes\": %lu,\n  \"passes_per_case\": %u,\n"
+      "  \"results\": [", BENCH_CPU, BENCH_DWT ? "dwt" : "systick",
+      BENCH_CORE_HZ, (unsigned long) sizeof(tuCHttpServerState),
+      BENCH_PASSES);
+  Startup_Write(line);
+
+  for (c = 0U; c < sizeof(corpora) / sizeof(corpora[0]); c++)
+  {
+    for (t = 0U; t < sizeof(tableSizes) / sizeof(tableSizes[0]); t++)
+    {
+      for (f = 0U; f < sizeof(fragments) / sizeof(fragments[0]); f++)
+      {
+        const unsigned int length = (unsigned int) strlen(corpora[c].data);
+        const unsigned int step = (0U == fragments[f]) ? length :
+            fragments[f];
+        const unsigned long requests = BENCH_PASSES * corpora[c].requests;
+        tBenchConnection bc = { 0UL, 0UL };
+        unsigned long long cycles;
+        unsigned long errors;
+        unsigned int pass;
+
+        Http_InitializeConnection(&sm, &Bench_Send, &Bench_Error, &table,
+            Bench_BuildTable(tableSizes[t]), &bc);
+
+        /* Keep-alive connection fed the corpus again and again */
+        cycles = Bench_Cycles();
+        for (pass = 0U; pass < BENCH_PASSES; pass++)
+        {
+          unsigned int offset = 0U;
+
+          while (offset < length)
+          {
+            unsigned int n = (length - offset < step) ? length - offset :
+                step;
+
+            Http_Input(&sm, corpora[c].data + offset, n);
+            offset += n;
+          }
+        }
+        cycles = Bench_Cycles() - cycles;
+
+        /* Anything but one response per request means the numbers are off */
+        errors = bc.errors + (requests - bc.responses);
+        failed += errors;
+        /* One decimal place, printf of the nano library has no floats */
+        snprintf(line, sizeof(line), "%s\n    {\"corpus\": \"%s\", "
+            "\"resources\": %u, \"fragment\": %u, \"requests\": %lu, "
+            "\"errors\": %lu, \"cycles_per_request\": %lu.%lu, "
+            "\"ns_per_request\": %lu}", first ? "" : ",", corpora[c].name,
+            tableSizes[t], fragments[f], requests, errors,
+            (unsigned long) (cycles / requests),
+            (unsigned long) ((cycles * 10ULL / requests) % 10ULL),
+            (unsigned long) (cycles * 1000000000ULL / BENCH_CORE_HZ /
+                requests));
+        Startup_Write(line);
+        first = 0;
+      }
+    }
+  }
+
+  snprintf(line, sizeof(line), "\n  ],\n  \"stack_peak_bytes\": %lu\n}\n",
+      Startup_StackPeak());
+  Startup_Write(line);
+
+  return (0UL == failed) ? 0 : 1;
+}
+
+/*****************************************************************************/
+/* Global functions                                                          */
+/*****************************************************************************/
+
+void SysTick_Handler(
+    void)
+{
+  ++overflows;
+}
+
+/*****************************************************************************/
+/* Local functions (definitions)                                             */
+/*****************************************************************************/
+
+static unsigned int Bench_Send(
+    void *const conn,
+    const char *data,
+    unsigned int length)
+{
+  /* Responses are discarded, only the parser and engine are measured */
+  return length;
+}
+
+static void Bench_Error(
+    void *const conn,
+    const tErrorInfo *errorInfo)
+{
+  tBenchConnection *const bc = Http_HelperGetContext(conn);
+
+  ++(bc->errors);
+}
+
+static tHttpStatusCode Bench_Resource(
+    void *const conn)
+{
+  tBenchConnection *const bc = Http_HelperGetContext(conn);
+
+  ++(bc->responses);
+  Http_HelperSetResponseStatus(conn, HTTP_STATUS_OK);
+  Http_HelperSetResponseHeader(conn, "Content-Length", "0");
+  Http_HelperSend(conn, "\r\n", 2U);
+  Http_HelperFlush(conn);
+
+  return HTTP_STATUS_OK;
+}
+
+static int Bench_CompareNames(
+    const void *a,
+    const void *b)
+{
+  const tResourceEntry *ra = a;
+  const tResourceEntry *rb = b;
+
+  return strcmp(ra->name.str, rb->name.str);
+}
+
+static unsigned int Bench_BuildTable(
+    unsigned int length)
+{
+  unsigned int i;
+
+  /* Corpus targets among generated names of the same shape as real ones */
+  for (i = 0U; i < length; i++)
+  {
+    if (i < BENCH_CORPUS_RESOURCES)
+    {
+      snprintf(names[i], BENCH_NAME_LENGTH, "%s", corpusResources[i]);
+    }
+    else
+    {
+      snprintf(names[i], BENCH_NAME_LENGTH, "/r/%05u", i);
+    }
+    table[i].name.str = names[i];
+    table[i].name.length = (unsigned int) strlen(names[i]);
+    table[i].callback = &Bench_Resource;
+    table[i].flags = 0U;
+    table[i].priority = HTTP_PRIORITY_DEFAULT;
+  }
+  /* Looked up with binary search */
+  qsort(table, length, sizeof(table[0]), &Bench_CompareNames);
+
+  return length;
+}
+
+static void Bench_StartCounter(
+    void)
+{
+#if BENCH_DWT
+  BENCH_DEMCR |= (1UL << 24);   /* TRCENA */
+  BENCH_DWT_CYCCNT = 0UL;
+  BENCH_DWT_CTRL |= 1UL;        /* CYCCNTENA */
+#else
+  /* Core clock, interrupt on each wrap of the 24-bit down-counter. Under
+   * QEMU with -icount the clock follows executed instructions */
+  BENCH_SYST_RVR = 0x00FFFFFFUL;
+  BENCH_SYST_CVR = 0UL;
+  BENCH_SYST_CSR = 0x7UL;       /* CLKSOURCE | TICKINT | ENABLE */
+#endif
+}
+
+static unsigned long long Bench_Cycles(
+    void)
+{
+#if BENCH_DWT
+  static unsigned long last;
+  static unsigned long long total;
+  unsigned long now = BENCH_DWT_CYCCNT;
+
+  /* Read often enough that the 32-bit counter wraps at most once */
+  total += now - last;
+  last = now;
+  return total;
+#else
+  unsigned long high;
+  unsigned long low;
+
+  do
+  {
+    high = overflows;
+    low = BENCH_SYST_CVR;
+  }
+  while (high != overflows);
+
+  return ((unsigned long long) high << 24) + (0x00FFFFFFUL - low);
+#endif
+}
@@ -0,0 +1,182 @@
+/*
+ startup.c
+
+ MIT License
+
+ Copyright (c) 2026 uChttpserver contributors
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+  Created on: Oct 18, 2026
+      Author: uChttpserver contributors
+ */
+
+/*****************************************************************************/
+/* Includes                                                                  */
+/*****************************************************************************/
+
+#include "startup.h"
+
+/*****************************************************************************/
+/* Defines                                                                   */
+/*****************************************************************************/
+
+#define STARTUP_SYS_WRITE0 (0x04)
+#define STARTUP_SYS_EXIT (0x18)
+#define STARTUP_APPLICATION_EXIT (0x20026UL)
+#define STARTUP_RUNTIME_ERROR (0x20023UL)
+
+/* Written over the stack area at reset, overwritten words were used        */
+#define STARTUP_PAINT (0xDEADBEEFUL)
+
+/*****************************************************************************/
+/* Linker script symbols                                                     */
+/*****************************************************************************/
+
+extern unsigned long _sidata;
+extern unsigned long _sdata;
+extern unsigned long _edata;
+extern unsigned long _sbss;
+extern unsigned long _ebss;
+extern unsigned long _sstack;
+extern unsigned long _estack;
+
+/*****************************************************************************/
+/* Local functions (declarations)                                            */
+/*****************************************************************************/
+
+int main(
+    void);
+
+void Reset_Handler(
+    void);
+void Default_Handler(
+    void);
+void SysTick_Handler(
+    void) __attribute__ ((weak, alias("Default_Handler")));
+
+static int Startup_Semihost(
+    int operation,
+    const void *argument);
+
+/*****************************************************************************/
+/* Vector table                                                              */
+/*****************************************************************************/
+
+__attribute__ ((section(".vectors"), used))
+static void (*const vectors[16])(
+    void) = {
+  (void (*)(void)) &_estack,
+  &Reset_Handler,
+  &Default_Handler,             /* NMI */
+  &Default_Handler,             /* HardFault */
+  &Default_Handler,             /* MemManage */
+  &Default_Handler,             /* BusFault */
+  &Default_Handler,             /* UsageFault */
+  0, 0, 0, 0,
+  &Default_Handler,             /* SVCall */
+  &Default_Handler,             /* DebugMon */
+  0,
+  &Default_Handler,             /* PendSV */
+  &SysTick_Handler
+};
+
+/*****************************************************************************/
+/* Global functions                                                          */
+/*****************************************************************************/
+
+void Reset_Handler(
+    void)
+{
+  unsigned long *src = &_sidata;
+  unsigned long *dst;
+  unsigned long *sp;
+
+  for (dst = &_sdata; dst < &_edata; dst++)
+  {
+    *dst = *(src++);
+  }
+  for (dst = &_sbss; dst < &_ebss; dst++)
+  {
+    *dst = 0UL;
+  }
+
+  /* Paint the stack below this frame, the margin keeps it intact */
+  __asm__ volatile ("mov %0, sp" : "=r" (sp));
+  for (dst = &_sstack; dst < sp - 16; dst++)
+  {
+    *dst = STARTUP_PAINT;
+  }
+
+  Startup_Exit(main());
+}
+
+void Default_Handler(
+    void)
+{
+  Startup_Write("unexpected exception\n");
+  Startup_Exit(1);
+}
+
+void Startup_Write(
+    const char *text)
+{
+  (void) Startup_Semihost(STARTUP_SYS_WRITE0, text);
+}
+
+void Startup_Exit(
+    int status)
+{
+  /* 32-bit semihosting exit carries a reason instead of a status, QEMU
+   * exits with 1 for anything but a normal application exit */
+  (void) Startup_Semihost(STARTUP_SYS_EXIT, (const void *)
+      ((0 == status) ? STARTUP_APPLICATION_EXIT : STARTUP_RUNTIME_ERROR));
+  for (;;)
+  {
+  }
+}
+
+unsigned long Startup_StackPeak(
+    void)
+{
+  const unsigned long *word = &_sstack;
+
+  while (word < &_estack && STARTUP_PAINT == *word)
+  {
+    ++word;
+  }
+
+  return (unsigned long) ((const char *) &_estack - (const char *) word);
+}
+
+/*****************************************************************************/
+/* Local functions (definitions)                                             */
+/*****************************************************************************/
+
+static int Startup_Semihost(
+    int operation,
+    const void *argument)
+{
+  register int r0 __asm__ ("r0") = operation;
+  register const void *r1 __asm__ ("r1") = argument;
+
+  __asm__ volatile ("bkpt 0xAB" : "+r" (r0) : "r" (r1) : "memory");
+
+  return r0;
+}
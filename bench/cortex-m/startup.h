@@ -0,0 +1,56 @@
+/*
+ startup.h
+
+ MIT License
+
+ Copyright (c) 2026 uChttpserver contributors
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+  Created on: Oct 18, 2026
+      Author: uChttpserver contributors
+ */
+
+#ifndef STARTUP_H_
+#define STARTUP_H_
+
+/*****************************************************************************/
+/* Bare-metal startup of the Cortex-M benchmark                              */
+/* - output and exit go through semihosting, QEMU or a debugger serves them  */
+/*****************************************************************************/
+
+/**
+ * \brief Print null-terminated text on the host console
+ */
+void Startup_Write(
+    const char *text);
+
+/**
+ * \brief End the run, QEMU exits with the given status
+ */
+void Startup_Exit(
+    int status);
+
+/**
+ * \brief Deepest stack use since reset, found in the painted stack area
+ */
+unsigned long Startup_StackPeak(
+    void);
+
+#endif /* STARTUP_H_ */
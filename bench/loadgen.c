@@ -0,0 +1,895 @@
+/*
+ loadgen.c
+
+ MIT License
+
+ Copyright (c) 2026 uChttpserver contributors
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+  Created on: Oct 18, 2026
+      Author: uChttpserver contributors
+ */
+
+/*****************************************************************************/
+/* Includes                                                                  */
+/*****************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+
+/*****************************************************************************/
+/* Defines                                                                   */
+/*****************************************************************************/
+
+#define LOAD_MAX_DEPTH (64U)
+#define LOAD_MAX_MIX (16U)
+#define LOAD_LINE_LENGTH (1024U)
+#define LOAD_RECEIVE_LENGTH (65536U)
+/* Requests still unanswered this long after the run are timeouts          */
+#define LOAD_DRAIN_NS (2000000000ULL)
+
+/* Latency histogram, ns - 2^LOAD_SUB_BITS buckets per power of two       */
+#define LOAD_SUB_BITS (5U)
+#define LOAD_MAGNITUDES (40U)
+#define LOAD_BUCKETS ((LOAD_MAGNITUDES + 1U) << LOAD_SUB_BITS)
+
+/*****************************************************************************/
+/* Type definitions                                                          */
+/*****************************************************************************/
+
+typedef enum LoadParseState
+{
+  LOAD_STATUS_LINE,
+  LOAD_HEADER_LINE,
+  LOAD_BODY_LENGTH,
+  LOAD_CHUNK_SIZE,
+  LOAD_CHUNK_DATA,
+  LOAD_CHUNK_END,
+  LOAD_TRAILER_LINE,
+  LOAD_BODY_UNTIL_CLOSE
+} tLoadParseState;
+
+/* Incremental HTTP/1.1 response framing, the body itself is skipped        */
+typedef struct LoadResponse
+{
+  tLoadParseState state;
+  char line[LOAD_LINE_LENGTH];
+  unsigned int lineLength;
+  unsigned long long remaining;
+  long long contentLength;      /* -1 - not given */
+  int chunked;
+  int close;
+  int status;
+} tLoadResponse;
+
+typedef struct LoadRequest
+{
+  char *data;
+  unsigned int length;
+  unsigned int weight;
+} tLoadRequest;
+
+typedef struct LoadConnection
+{
+  int fd;
+  int connected;
+  unsigned int outstanding;
+  unsigned int head;            /* Oldest intended time */
+  unsigned long long intended[LOAD_MAX_DEPTH];
+  char *out;
+  unsigned int outHead;
+  unsigned int outTail;
+  tLoadResponse response;
+} tLoadConnection;
+
+typedef struct LoadConfig
+{
+  struct sockaddr_in address;
+  unsigned int connections;
+  unsigned int depth;
+  double rate;                  /* Requests per second, all connections */
+  double duration;
+  int closeMode;
+  unsigned int bodyLength;
+  tLoadRequest mix[LOAD_MAX_MIX];
+  unsigned int mixLength;
+  unsigned int mixWeight;
+} tLoadConfig;
+
+typedef struct LoadStatistics
+{
+  unsigned long long counts[LOAD_BUCKETS];
+  unsigned long long max;
+  unsigned long long sent;
+  unsigned long long completed;
+  unsigned long long errors;
+  unsigned long long bytes;
+  unsigned long long statuses[6];       /* By first digit */
+} tLoadStatistics;
+
+/*****************************************************************************/
+/* Local functions (declarations)                                            */
+/*****************************************************************************/
+
+static int Load_Configure(
+    tLoadConfig *config,
+    int argc,
+    char **argv);
+static int Load_AddRequests(
+    tLoadConfig *config,
+    const char *mix);
+
+static unsigned long long Load_Now(
+    void);
+
+static int Load_Connect(
+    int epollFd,
+    const tLoadConfig *config,
+    tLoadConnection *c);
+static void Load_Drop(
+    int epollFd,
+    const tLoadConfig *config,
+    tLoadConnection *c,
+    tLoadStatistics *stats);
+static void Load_Flush(
+    int epollFd,
+    const tLoadConfig *config,
+    tLoadConnection *c,
+    tLoadStatistics *stats);
+static void Load_Receive(
+    int epollFd,
+    const tLoadConfig *config,
+    tLoadConnection *c,
+    tLoadStatistics *stats);
+
+static void Load_ResetResponse(
+    tLoadResponse *r);
+static unsigned int Load_Parse(
+    tLoadResponse *r,
+    const char *data,
+    unsigned int length,
+    int *complete);
+static int Load_Line(
+    tLoadResponse *r);
+
+static void Load_Record(
+    tLoadStatistics *stats,
+    unsigned long long value);
+static unsigned long long Load_Percentile(
+    const tLoadStatistics *stats,
+    double share);
+
+/*****************************************************************************/
+/* Entry point                                                               */
+/*****************************************************************************/
+
+int main(
+    int argc,
+    char **argv)
+{
+  static tLoadConfig config;
+  static tLoadStatistics stats;
+  tLoadConnection *pool;
+  struct epoll_event events[256];
+  unsigned long long start;
+  unsigned long long end;
+  unsigned long long now;
+  unsigned long long total;
+  unsigned long long scheduled = 0ULL;
+  unsigned long long outstanding;
+  unsigned int next = 0U;
+  unsigned int i;
+  int epollFd;
+  int timerFd;
+
+  if (0 != Load_Configure(&config, argc, argv))
+  {
+    fprintf(stderr, "usage: %s [-a address] [-p port] [-c connections] "
+        "[-r requests/s] [-d seconds] [-D pipeline depth] [-C close mode] "
+        "[-b POST body bytes] [-m '[METHOD ]path[:weight],...']\n", argv[0]);
+    return 1;
+  }
+
+  /* epoll_wait() sleeps in whole milliseconds, the timer wakes the loop
+   * when the next request is due with the clock resolution instead */
+  epollFd = epoll_create1(EPOLL_CLOEXEC);
+  timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  pool = calloc(config.connections, sizeof(tLoadConnection));
+  if (0 > epollFd || 0 > timerFd || NULL == pool)
+  {
+    perror("loadgen");
+    return 1;
+  }
+  events[0].events = EPOLLIN;
+  events[0].data.ptr = NULL;
+  if (0 != epoll_ctl(epollFd, EPOLL_CTL_ADD, timerFd, &events[0]))
+  {
+    perror("loadgen");
+    return 1;
+  }
+  for (i = 0U; i < config.connections; i++)
+  {
+    pool[i].out = malloc(config.depth * (LOAD_LINE_LENGTH +
+            config.bodyLength));
+    if (NULL == pool[i].out || 0 != Load_Connect(epollFd, &config,
+            &(pool[i])))
+    {
+      perror("loadgen");
+      return 1;
+    }
+  }
+
+  /* Open loop - request n is due at start + n / rate whatever the server
+   * does, latency counts from that moment, so stalls are not hidden */
+  total = (unsigned long long) (config.rate * config.duration);
+  start = Load_Now();
+  end = start + (unsigned long long) (config.duration * 1e9);
+  now = start;
+  do
+  {
+    int timeout = -1;
+    int n;
+
+    while (scheduled < total)
+    {
+      unsigned long long due = start +
+          (unsigned long long) (scheduled * 1e9 / config.rate);
+      unsigned int tried;
+
+      if (due > now)
+      {
+        struct itimerspec at;
+
+        memset(&at, 0, sizeof(at));
+        at.it_value.tv_sec = (time_t) (due / 1000000000ULL);
+        at.it_value.tv_nsec = (long) (due % 1000000000ULL);
+        timerfd_settime(timerFd, TFD_TIMER_ABSTIME, &at, NULL);
+        break;
+      }
+      /* Round-robin over connections with room in their pipeline */
+      for (tried = 0U; tried < config.connections; tried++)
+      {
+        tLoadConnection *c = &(pool[next]);
+
+        next = (next + 1U) % config.connections;
+        if (c->connected && config.depth > c->outstanding &&
+            (!config.closeMode || 0U == c->outstanding))
+        {
+          const tLoadRequest *r = &(config.mix[0]);
+          unsigned int pick = (unsigned int) ((scheduled * 2654435761ULL) %
+              config.mixWeight);
+          unsigned int m;
+
+          /* Weighted, deterministic and spread over the run */
+          for (m = 0U; m < config.mixLength; m++)
+          {
+            if (pick < config.mix[m].weight)
+            {
+              r = &(config.mix[m]);
+              break;
+            }
+            pick -= config.mix[m].weight;
+          }
+          memcpy(c->out + c->outTail, r->data, r->length);
+          c->outTail += r->length;
+          c->intended[(c->head + c->outstanding) % LOAD_MAX_DEPTH] = due;
+          ++(c->outstanding);
+          ++scheduled;
+          ++(stats.sent);
+          Load_Flush(epollFd, &config, c, &stats);
+          break;
+        }
+      }
+      if (tried == config.connections)
+      {
+        /* Every pipeline full - the request waits, its latency grows */
+        timeout = 1;
+        break;
+      }
+    }
+    if (scheduled == total)
+    {
+      timeout = 1;
+    }
+
+    n = epoll_wait(epollFd, events, sizeof(events) / sizeof(events[0]),
+        timeout);
+    for (i = 0U; (int) i < n; i++)
+    {
+      tLoadConnection *c = events[i].data.ptr;
+      unsigned long long expirations;
+
+      if (NULL == c)
+      {
+        (void) read(timerFd, &expirations, sizeof(expirations));
+        continue;
+      }
+      if (!c->connected && (events[i].events & EPOLLOUT))
+      {
+        int error = 0;
+        socklen_t length = sizeof(error);
+
+        getsockopt(c->fd, SOL_SOCKET, SO_ERROR, &error, &length);
+        if (0 != error)
+        {
+          Load_Drop(epollFd, &config, c, &stats);
+          continue;
+        }
+        c->connected = 1;
+      }
+      if (events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR))
+      {
+        Load_Receive(epollFd, &config, c, &stats);
+      }
+      if (c->connected && (events[i].events & EPOLLOUT))
+      {
+        Load_Flush(epollFd, &config, c, &stats);
+      }
+    }
+
+    now = Load_Now();
+    outstanding = stats.sent - stats.completed - stats.errors;
+  }
+  while (now < end || (scheduled < total) ||
+      (0ULL < outstanding && now < end + LOAD_DRAIN_NS));
+
+  printf("{\n  \"benchmark\": \"loadgen\",\n"
+      "  \"target\": \"%s:%u\",\n  \"mode\": \"%s\",\n"
+      "  \"connections\": %u,\n  \"pipeline\": %u,\n"
+      "  \"rate\": %.0f,\n  \"duration\": %.1f,\n"
+      "  \"sent\": %llu,\n  \"completed\": %llu,\n  \"errors\": %llu,\n"
+      "  \"timeouts\": %llu,\n",
+      inet_ntoa(config.address.sin_addr), ntohs(config.address.sin_port),
+      config.closeMode ? "close" : "keep-alive", config.connections,
+      config.depth, config.rate, config.duration, stats.sent,
+      stats.completed, stats.errors, outstanding);
+  printf("  \"status\": {\"1xx\": %llu, \"2xx\": %llu, \"3xx\": %llu, "
+      "\"4xx\": %llu, \"5xx\": %llu},\n", stats.statuses[1],
+      stats.statuses[2], stats.statuses[3], stats.statuses[4],
+      stats.statuses[5]);
+  printf("  \"throughput\": %.1f,\n  \"bytes_received\": %llu,\n",
+      stats.completed / ((now - start) * 1e-9), stats.bytes);
+  printf("  \"latency_us\": {\"p50\": %.1f, \"p90\": %.1f, \"p99\": %.1f, "
+      "\"p999\": %.1f, \"max\": %.1f}\n}\n",
+      Load_Percentile(&stats, 0.5) * 1e-3,
+      Load_Percentile(&stats, 0.9) * 1e-3,
+      Load_Percentile(&stats, 0.99) * 1e-3,
+      Load_Percentile(&stats, 0.999) * 1e-3, stats.max * 1e-3);
+
+  return 0;
+}
+
+/*****************************************************************************/
+/* Local functions (definitions)                                             */
+/*****************************************************************************/
+
+static int Load_Configure(
+    tLoadConfig *config,
+    int argc,
+    char **argv)
+{
+  const char *mix = "/hello";
+  int opt;
+
+  config->address.sin_family = AF_INET;
+  config->address.sin_port = htons(8080);
+  config->address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  config->connections = 16U;
+  config->depth = 1U;
+  config->rate = 1000.0;
+  config->duration = 10.0;
+  config->closeMode = 0;
+  config->bodyLength = 0U;
+
+  while (-1 != (opt = getopt(argc, argv, "a:p:c:r:d:D:Cb:m:")))
+  {
+    switch (opt)
+    {
+      case 'a':
+        if (1 != inet_pton(AF_INET, optarg, &(config->address.sin_addr)))
+        {
+          return -1;
+        }
+        break;
+      case 'p':
+        config->address.sin_port = htons((unsigned short) atoi(optarg));
+        break;
+      case 'c':
+        config->connections = (unsigned int) atoi(optarg);
+        break;
+      case 'r':
+        config->rate = atof(optarg);
+        break;
+      case 'd':
+        config->duration = atof(optarg);
+        break;
+      case 'D':
+        config->depth = (unsigned int) atoi(optarg);
+        break;
+      case 'C':
+        config->closeMode = 1;
+        break;
+      case 'b':
+        config->bodyLength = (unsigned int) atoi(optarg);
+        break;
+      case 'm':
+        mix = optarg;
+        break;
+      default:
+        return -1;
+    }
+  }
+
+  if (0U == config->connections || 0U == config->depth ||
+      LOAD_MAX_DEPTH < config->depth || 0.0 >= config->rate ||
+      0.0 >= config->duration)
+  {
+    return -1;
+  }
+  if (config->closeMode)
+  {
+    config->depth = 1U;
+  }
+  return Load_AddRequests(config, mix);
+}
+
+static int Load_AddRequests(
+    tLoadConfig *config,
+    const char *mix)
+{
+  char *copy = strdup(mix);
+  char *save = NULL;
+  char *item;
+
+  config->mixLength = 0U;
+  config->mixWeight = 0U;
+  for (item = strtok_r(copy, ",", &save); NULL != item;
+      item = strtok_r(NULL, ",", &save))
+  {
+    tLoadRequest *r = &(config->mix[config->mixLength]);
+    const char *method = "GET";
+    char *path = item;
+    char *weight = strrchr(item, ':');
+    char *space = strchr(item, ' ');
+    unsigned int body;
+    int length;
+
+    if (LOAD_MAX_MIX == config->mixLength)
+    {
+      break;
+    }
+    if (NULL != weight)
+    {
+      *weight = '\0';
+      ++weight;
+    }
+    if (NULL != space)
+    {
+      *space = '\0';
+      method = item;
+      path = space + 1;
+    }
+    body = (0 == strcmp(method, "POST") || 0 == strcmp(method, "PUT")) ?
+        config->bodyLength : 0U;
+
+    r->data = malloc(LOAD_LINE_LENGTH + body);
+    if (NULL == r->data)
+    {
+      free(copy);
+      return -1;
+    }
+    length = snprintf(r->data, LOAD_LINE_LENGTH,
+        "%s %s HTTP/1.1\r\nHost: loadgen\r\n%s", method, path,
+        config->closeMode ? "Connection: close\r\n" : "");
+    if (0U < body)
+    {
+      length += snprintf(r->data + length, LOAD_LINE_LENGTH - length,
+          "Content-Type: application/x-www-form-urlencoded\r\n"
+          "Content-Length: %u\r\n", body);
+    }
+    length += snprintf(r->data + length, LOAD_LINE_LENGTH - length, "\r\n");
+    if (0U < body)
+    {
+      /* Single form field d=xxx... */
+      memset(r->data + length, 'x', body);
+      memcpy(r->data + length, "d=", (2U < body) ? 2U : body);
+      length += (int) body;
+    }
+    r->length = (unsigned int) length;
+    r->weight = (NULL != weight) ? (unsigned int) atoi(weight) : 1U;
+    config->mixWeight += r->weight;
+    ++(config->mixLength);
+  }
+  free(copy);
+
+  return (0U < config->mixLength && 0U < config->mixWeight) ? 0 : -1;
+}
+
+static unsigned long long Load_Now(
+    void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (unsigned long long) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static int Load_Connect(
+    int epollFd,
+    const tLoadConfig *config,
+    tLoadConnection *c)
+{
+  struct epoll_event ev;
+  int one = 1;
+
+  c->fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (0 > c->fd)
+  {
+    return -1;
+  }
+  setsockopt(c->fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  c->connected = 0;
+  c->outstanding = 0U;
+  c->head = 0U;
+  c->outHead = 0U;
+  c->outTail = 0U;
+  Load_ResetResponse(&(c->response));
+
+  if (0 > connect(c->fd, (const struct sockaddr *) &(config->address),
+          sizeof(config->address)) && EINPROGRESS != errno)
+  {
+    close(c->fd);
+    return -1;
+  }
+  ev.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+  ev.data.ptr = c;
+  return epoll_ctl(epollFd, EPOLL_CTL_ADD, c->fd, &ev);
+}
+
+static void Load_Drop(
+    int epollFd,
+    const tLoadConfig *config,
+    tLoadConnection *c,
+    tLoadStatistics *stats)
+{
+  /* Requests in flight are lost, the connection is opened again */
+  stats->errors += c->outstanding;
+  close(c->fd);
+  if (0 != Load_Connect(epollFd, config, c))
+  {
+    perror("loadgen");
+    exit(1);
+  }
+}
+
+static void Load_Flush(
+    int epollFd,
+    const tLoadConfig *config,
+    tLoadConnection *c,
+    tLoadStatistics *stats)
+{
+  while (c->connected && c->outHead < c->outTail)
+  {
+    ssize_t n = send(c->fd, c->out + c->outHead, c->outTail - c->outHead,
+        MSG_NOSIGNAL);
+
+    if (0 > n)
+    {
+      if (EAGAIN != errno && EWOULDBLOCK != errno)
+      {
+        Load_Drop(epollFd, config, c, stats);
+      }
+      return;
+    }
+    c->outHead += (unsigned int) n;
+  }
+  c->outHead = 0U;
+  c->outTail = 0U;
+}
+
+static void Load_Receive(
+    int epollFd,
+    const tLoadConfig *config,
+    tLoadConnection *c,
+    tLoadStatistics *stats)
+{
+  char buffer[LOAD_RECEIVE_LENGTH];
+
+  for (;;)
+  {
+    ssize_t n = recv(c->fd, buffer, sizeof(buffer), 0);
+    unsigned int offset = 0U;
+
+    if (0 > n && (EAGAIN == errno || EWOULDBLOCK == errno))
+    {
+      return;
+    }
+    if (0 >= n)
+    {
+      /* Body delimited by close is complete now */
+      if (LOAD_BODY_UNTIL_CLOSE == c->response.state &&
+          0U < c->outstanding)
+      {
+        Load_Record(stats, Load_Now() - c->intended[c->head]);
+        ++(stats->statuses[c->response.status / 100 % 6]);
+        ++(stats->completed);
+        --(c->outstanding);
+      }
+      Load_Drop(epollFd, config, c, stats);
+      return;
+    }
+
+    stats->bytes += (unsigned long long) n;
+    while (offset < (unsigned int) n)
+    {
+      int complete = 0;
+
+      offset += Load_Parse(&(c->response), buffer + offset,
+          (unsigned int) n - offset, &complete);
+      if (0 > complete || (complete && 0U == c->outstanding))
+      {
+        /* Malformed or unsolicited response */
+        Load_Drop(epollFd, config, c, stats);
+        return;
+      }
+      if (complete)
+      {
+        int close = c->response.close || config->closeMode;
+
+        Load_Record(stats, Load_Now() - c->intended[c->head]);
+        ++(stats->statuses[c->response.status / 100 % 6]);
+        ++(stats->completed);
+        c->head = (c->head + 1U) % LOAD_MAX_DEPTH;
+        --(c->outstanding);
+        Load_ResetResponse(&(c->response));
+        if (close)
+        {
+          Load_Drop(epollFd, config, c, stats);
+          return;
+        }
+      }
+    }
+  }
+}
+
+static void Load_ResetResponse(
+    tLoadResponse *r)
+{
+  r->state = LOAD_STATUS_LINE;
+  r->lineLength = 0U;
+  r->remaining = 0ULL;
+  r->contentLength = -1;
+  r->chunked = 0;
+  r->close = 0;
+  r->status = 0;
+}
+
+static unsigned int Load_Parse(
+    tLoadResponse *r,
+    const char *data,
+    unsigned int length,
+    int *complete)
+{
+  unsigned int parsed = 0U;
+
+  while (parsed < length && !(*complete))
+  {
+    if (LOAD_BODY_LENGTH == r->state || LOAD_CHUNK_DATA == r->state ||
+        LOAD_BODY_UNTIL_CLOSE == r->state)
+    {
+      unsigned long long skip = length - parsed;
+
+      if (LOAD_BODY_UNTIL_CLOSE != r->state)
+      {
+        skip = (skip < r->remaining) ? skip : r->remaining;
+        r->remaining -= skip;
+        if (0ULL == r->remaining)
+        {
+          r->state = (LOAD_BODY_LENGTH == r->state) ? LOAD_STATUS_LINE :
+              LOAD_CHUNK_END;
+          *complete = (LOAD_STATUS_LINE == r->state);
+        }
+      }
+      parsed += (unsigned int) skip;
+    }
+    else
+    {
+      char ch = data[parsed++];
+
+      if ('\n' != ch)
+      {
+        if ('\r' != ch && LOAD_LINE_LENGTH - 1U > r->lineLength)
+        {
+          r->line[r->lineLength++] = ch;
+        }
+        continue;
+      }
+      r->line[r->lineLength] = '\0';
+      *complete = Load_Line(r);
+      r->lineLength = 0U;
+    }
+  }
+
+  return parsed;
+}
+
+static int Load_Line(
+    tLoadResponse *r)
+{
+  switch (r->state)
+  {
+    case LOAD_STATUS_LINE:
+      if (0U == r->lineLength)
+      {
+        /* Stray CRLF between responses */
+        return 0;
+      }
+      if (0 != strncmp(r->line, "HTTP/1.", 7) || 12U > r->lineLength)
+      {
+        return -1;
+      }
+      r->status = atoi(r->line + 9);
+      r->state = LOAD_HEADER_LINE;
+      return 0;
+    case LOAD_HEADER_LINE:
+      if (0U < r->lineLength)
+      {
+        if (0 == strncasecmp(r->line, "Content-Length:", 15))
+        {
+          r->contentLength = atoll(r->line + 15);
+        }
+        else if (0 == strncasecmp(r->line, "Transfer-Encoding:", 18) &&
+            NULL != strstr(r->line + 18, "chunked"))
+        {
+          r->chunked = 1;
+        }
+        else if (0 == strncasecmp(r->line, "Connection:", 11) &&
+            NULL != strstr(r->line + 11, "close"))
+        {
+          r->close = 1;
+        }
+        return 0;
+      }
+      if (100 <= r->status && 200 > r->status)
+      {
+        /* Interim response, the final one follows */
+        Load_ResetResponse(r);
+        return 0;
+      }
+      if (r->chunked)
+      {
+        r->state = LOAD_CHUNK_SIZE;
+        return 0;
+      }
+      if (0 <= r->contentLength)
+      {
+        r->remaining = (unsigned long long) r->contentLength;
+        r->state = (0ULL < r->remaining) ? LOAD_BODY_LENGTH :
+            LOAD_STATUS_LINE;
+        return (LOAD_STATUS_LINE == r->state);
+      }
+      r->state = LOAD_BODY_UNTIL_CLOSE;
+      return 0;
+    case LOAD_CHUNK_SIZE:
+      r->remaining = strtoull(r->line, NULL, 16);
+      r->state = (0ULL < r->remaining) ? LOAD_CHUNK_DATA :
+          LOAD_TRAILER_LINE;
+      return 0;
+    case LOAD_CHUNK_END:
+      r->state = LOAD_CHUNK_SIZE;
+      return 0;
+    case LOAD_TRAILER_LINE:
+      if (0U == r->lineLength)
+      {
+        r->state = LOAD_STATUS_LINE;
+        return 1;
+      }
+      return 0;
+    default:
+      return -1;
+  }
+}
+
+static void Load_Record(
+    tLoadStatistics *stats,
+    unsigned long long value)
+{
+  unsigned long long shifted = value >> LOAD_SUB_BITS;
+  unsigned long long idx;
+  unsigned int magnitude = 0U;
+
+  while (0ULL != shifted)
+  {
+    ++magnitude;
+    shifted >>= 1;
+  }
+  idx = (0U == magnitude) ? value : (((unsigned long long) magnitude <<
+          LOAD_SUB_BITS) + ((value >> (magnitude - 1U)) &
+          ((1ULL << LOAD_SUB_BITS) - 1ULL)));
+  if (LOAD_BUCKETS <= idx)
+  {
+    idx = LOAD_BUCKETS - 1U;
+  }
+  ++(stats->counts[idx]);
+  if (value > stats->max)
+  {
+    stats->max = value;
+  }
+}
+
+static unsigned long long Load_Percentile(
+    const tLoadStatistics *stats,
+    double share)
+{
+  unsigned long long recorded = 0ULL;
+  unsigned long long seen = 0ULL;
+  unsigned long long rank;
+  unsigned long long highest;
+  unsigned int i;
+
+  for (i = 0U; i < LOAD_BUCKETS; i++)
+  {
+    recorded += stats->counts[i];
+  }
+  if (0ULL == recorded)
+  {
+    return 0ULL;
+  }
+  rank = (unsigned long long) (recorded * share + 0.999999);
+  rank = (0ULL == rank) ? 1ULL : rank;
+  for (i = 0U; i < LOAD_BUCKETS - 1U; i++)
+  {
+    seen += stats->counts[i];
+    if (seen >= rank)
+    {
+      break;
+    }
+  }
+
+  if ((1U << LOAD_SUB_BITS) > i)
+  {
+    highest = i;
+  }
+  else if (LOAD_BUCKETS - 1U == i)
+  {
+    highest = stats->max;
+  }
+  else
+  {
+    highest = ((((1ULL << LOAD_SUB_BITS) + (i & ((1U << LOAD_SUB_BITS) -
+                    1U)) + 1ULL) << ((i >> LOAD_SUB_BITS) - 1U)) - 1ULL);
+  }
+
+  return (highest < stats->max) ? highest : stats->max;
+}
@@ -0,0 +1,349 @@
+/*
+ parser-bench.c
+
+ MIT License
+
+ Copyright (c) 2026 uChttpserver contributors
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+  Created on: Oct 18, 2026
+      Author: uChttpserver contributors
+ */
+
+/*****************************************************************************/
+/* Includes                                                                  */
+/*****************************************************************************/
+
+#define _GNU_SOURCE
+
+#include "uchttpserver.h"
+#include "corpus.h"
+
+#include <linux/perf_event.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+/*****************************************************************************/
+/* Defines                                                                   */
+/*****************************************************************************/
+
+#define BENCH_MAX_RESOURCES (10000U)
+#define BENCH_NAME_LENGTH (16U)
+
+/*****************************************************************************/
+/* Type definitions                                                          */
+/*****************************************************************************/
+
+typedef struct BenchConnection
+{
+  unsigned long responses;
+  unsigned long errors;
+} tBenchConnection;
+
+typedef struct BenchResult
+{
+  unsigned long requests;
+  unsigned long bytes;
+  unsigned long errors;
+  double nanoseconds;
+  long long instructions;       /* -1 when not available */
+} tBenchResult;
+
+/*****************************************************************************/
+/* Local functions (declarations)                                            */
+/*****************************************************************************/
+
+static unsigned int Bench_Send(
+    void *const conn,
+    const char *data,
+    unsigned int length);
+static void Bench_Error(
+    void *const conn,
+    const tErrorInfo *errorInfo);
+static tHttpStatusCode Bench_Resource(
+    void *const conn);
+
+static int Bench_CompareNames(
+    const void *a,
+    const void *b);
+static unsigned int Bench_BuildTable(
+    unsigned int length);
+
+static int Bench_OpenInstructions(
+    void);
+static double Bench_Now(
+    void);
+static void Bench_Run(
+    const tBenchCorpus *corpus,
+    unsigned int resources,
+    unsigned int fragment,
+    double seconds,
+    int counter,
+    tBenchResult *result);
+
+/*****************************************************************************/
+/* Local variables and constants                                             */
+/*****************************************************************************/
+
+/* Input delivered per Http_Input call, 0 - whole corpus at once */
+static const unsigned int fragments[] = { 1U, 7U, 1460U, 0U };
+
+static const unsigned int tableSizes[] = { 10U, 100U, 1000U, 10000U };
+
+static char names[BENCH_MAX_RESOURCES][BENCH_NAME_LENGTH];
+static tResourceEntry table[BENCH_MAX_RESOURCES];
+
+/*****************************************************************************/
+/* Entry point                                                               */
+/*****************************************************************************/
+
+int main(
+    int argc,
+    char **argv)
+{
+  double seconds = (1 < argc) ? atof(argv[1]) : 0.2;
+  int counter = Bench_OpenInstructions();
+  unsigned int c;
+  unsigned int t;
+  unsigned int f;
+  int first = 1;
+
+  if (0.0 >= seconds)
+  {
+    fprintf(stderr, "usage: %s [seconds per case]\n", argv[0]);
+    return 1;
+  }
+
+  printf("{\n  \"benchmark\": \"parser\",\n  \"seconds_per_case\": %g,\n"
+      "  \"results\": [", seconds);
+  for (c = 0U; c < sizeof(corpora) / sizeof(corpora[0]); c++)
+  {
+    for (t = 0U; t < sizeof(tableSizes) / sizeof(tableSizes[0]); t++)
+    {
+      for (f = 0U; f < sizeof(fragments) / sizeof(fragments[0]); f++)
+      {
+        tBenchResult r;
+
+        Bench_Run(&(corpora[c]), tableSizes[t], fragments[f], seconds,
+            counter, &r);
+        printf("%s\n    {\"corpus\": \"%s\", \"resources\": %u, "
+            "\"fragment\": %u, \"requests\": %lu, \"errors\": %lu, "
+            "\"ns_per_request\": %.1f, \"bytes_per_second\": %.0f, "
+            "\"instructions_per_request\": ", first ? "" : ",",
+            corpora[c].name, tableSizes[t], fragments[f], r.requests,
+            r.errors, r.nanoseconds / r.requests,
+            r.bytes / (r.nanoseconds * 1e-9));
+        if (0 <= r.instructions)
+        {
+          printf("%.1f}", (double) r.instructions / r.requests);
+        }
+        else
+        {
+          printf("null}");
+        }
+        first = 0;
+        fflush(stdout);
+      }
+    }
+  }
+  printf("\n  ]\n}\n");
+
+  if (0 <= counter)
+  {
+    close(counter);
+  }
+  return 0;
+}
+
+/*****************************************************************************/
+/* Local functions (definitions)                                             */
+/*****************************************************************************/
+
+static unsigned int Bench_Send(
+    void *const conn,
+    const char *data,
+    unsigned int length)
+{
+  /* Responses are discarded, only the parser and engine are measured */
+  return length;
+}
+
+static void Bench_Error(
+    void *const conn,
+    const tErrorInfo *errorInfo)
+{
+  tBenchConnection *const bc = Http_HelperGetContext(conn);
+
+  ++(bc->errors);
+}
+
+static tHttpStatusCode Bench_Resource(
+    void *const conn)
+{
+  tBenchConnection *const bc = Http_HelperGetContext(conn);
+
+  ++(bc->responses);
+  Http_HelperSetResponseStatus(conn, HTTP_STATUS_OK);
+  Http_HelperSetResponseHeader(conn, "Content-Length", "0");
+  Http_HelperSend(conn, "\r\n", 2U);
+  Http_HelperFlush(conn);
+
+  return HTTP_STATUS_OK;
+}
+
+static int Bench_CompareNames(
+    const void *a,
+    const void *b)
+{
+  const tResourceEntry *ra = a;
+  const tResourceEntry *rb = b;
+
+  return strcmp(ra->name.str, rb->name.str);
+}
+
+static unsigned int Bench_BuildTable(
+    unsigned int length)
+{
+  unsigned int i;
+
+  /* Corpus targets among generated names of the same shape as real ones */
+  for (i = 0U; i < length; i++)
+  {
+    if (i < BENCH_CORPUS_RESOURCES)
+    {
+      snprintf(names[i], BENCH_NAME_LENGTH, "%s", corpusResources[i]);
+    }
+    else
+    {
+      snprintf(names[i], BENCH_NAME_LENGTH, "/r/%05u", i);
+    }
+    table[i].name.str = names[i];
+    table[i].name.length = (unsigned int) strlen(names[i]);
+    table[i].callback = &Bench_Resource;
+    table[i].flags = 0U;
+    table[i].priority = HTTP_PRIORITY_DEFAULT;
+    table[i].expect = NULL;
+  }
+  /* Looked up with binary search */
+  qsort(table, length, sizeof(table[0]), &Bench_CompareNames);
+
+  return length;
+}
+
+static int Bench_OpenInstructions(
+    void)
+{
+  struct perf_event_attr attr;
+
+  memset(&attr, 0, sizeof(attr));
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.size = sizeof(attr);
+  attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+  attr.disabled = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+
+  /* Fails in most containers and VMs, instructions are then reported null */
+  return (int) syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+static double Bench_Now(
+    void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void Bench_Run(
+    const tBenchCorpus *corpus,
+    unsigned int resources,
+    unsigned int fragment,
+    double seconds,
+    int counter,
+    tBenchResult *result)
+{
+  tuCHttpServerState sm;
+  tBenchConnection bc = { 0UL, 0UL };
+  const unsigned int length = (unsigned int) strlen(corpus->data);
+  const unsigned int step = (0U == fragment) ? length : fragment;
+  unsigned long passes = 0UL;
+  unsigned long batch = 1UL;
+  double start;
+  double elapsed = 0.0;
+  long long instructions = 0;
+
+  Http_InitializeConnection(&sm, &Bench_Send, &Bench_Error, &table,
+      Bench_BuildTable(resources), &bc);
+
+  /* Keep-alive connection fed the corpus again and again */
+  if (0 <= counter)
+  {
+    ioctl(counter, PERF_EVENT_IOC_RESET, 0);
+    ioctl(counter, PERF_EVENT_IOC_ENABLE, 0);
+  }
+  start = Bench_Now();
+  while (elapsed < seconds * 1e9)
+  {
+    unsigned long b;
+
+    for (b = 0UL; b < batch; b++)
+    {
+      unsigned int offset = 0U;
+
+      while (offset < length)
+      {
+        unsigned int n = (length - offset < step) ? length - offset : step;
+
+        Http_Input(&sm, corpus->data + offset, n);
+        offset += n;
+      }
+    }
+    passes += batch;
+    batch *= 2UL;
+    elapsed = Bench_Now() - start;
+  }
+  if (0 <= counter)
+  {
+    ioctl(counter, PERF_EVENT_IOC_DISABLE, 0);
+    if (sizeof(instructions) != read(counter, &instructions,
+            sizeof(instructions)))
+    {
+      instructions = -1;
+    }
+  }
+  else
+  {
+    instructions = -1;
+  }
+
+  result->requests = passes * corpus->requests;
+  result->bytes = passes * length;
+  result->nanoseconds = elapsed;
+  result->instructions = instructions;
+  /* Anything but one response per request means the numbers are off */
+  result->errors = bc.errors + (result->requests - bc.responses);
+}
@@ -0,0 +1,150 @@
+/*
+ uchttpguard.h
+
+ MIT License
+
+ Copyright (c) 2026 uChttpserver contributors
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+  Created on: Oct 18, 2026
+      Author: uChttpserver contributors
+ */
+
+#ifndef UCHTTPGUARD_H_
+#define UCHTTPGUARD_H_
+
+/*****************************************************************************/
+/* Includes                                                                  */
+/*****************************************************************************/
+
+#include "uchttpserver.h"
+
+/*****************************************************************************/
+/* Type definitions                                                          */
+/*****************************************************************************/
+
+typedef enum HttpProgressVerdict
+{
+  HTTP_PROGRESS_OK,
+  HTTP_PROGRESS_TOO_SLOW,        /* Less than minBytes within window */
+  HTTP_PROGRESS_HEAD_TOO_LONG    /* Request line and headers took too long */
+} tHttpProgressVerdict;
+
+/* Time is counted in ticks of the port */
+typedef struct HttpProgressPolicy
+{
+  unsigned long window;          /* Rate measurement period */
+  unsigned long minBytes;        /* Required within window, 0 - no limit */
+  unsigned long headTime;        /* Request head time, 0 - no limit */
+} tHttpProgressPolicy;
+
+/* Refill of tokens per ticks, up to burst; tokens equal 0 disables it */
+typedef struct HttpTokenRate
+{
+  unsigned long tokens;
+  unsigned long ticks;
+  unsigned long burst;
+} tHttpTokenRate;
+
+typedef struct HttpTokenBucket
+{
+  unsigned long credit;          /* In 1/ticks of a token */
+  unsigned long last;
+} tHttpTokenBucket;
+
+typedef struct HttpProgress
+{
+  unsigned long requestStart;    /* First input of current request */
+  unsigned long requestBytes;
+  unsigned long windowStart;
+  unsigned long windowBytes;
+  tHttpPhase phase;
+} tHttpProgress;
+
+/*****************************************************************************/
+/* Progress guard API                                                        */
+/* - tracks input rate of the request in progress, idle connections and     */
+/*   responses are not measured                                              */
+/*****************************************************************************/
+
+/**
+ * \brief Start tracking, also after every answered request
+ */
+void HttpProgress_Initialize(
+    tHttpProgress *const progress,
+    unsigned long now);
+
+/**
+ * \brief Account bytes consumed by Http_Input and judge the connection
+ * Phase is taken from the parser, so call it after Http_Input
+ */
+tHttpProgressVerdict HttpProgress_Update(
+    tHttpProgress *const progress,
+    const tHttpProgressPolicy *policy,
+    tuCHttpServerState *const sm,
+    unsigned int bytes,
+    unsigned long now);
+
+/**
+ * \brief Eviction order under slot pressure, higher is worse
+ * \return ticks per received byte of the request (scaled by 256), 0 for
+ * idle connections and requests younger than one window
+ */
+unsigned long HttpProgress_Score(
+    const tHttpProgress *progress,
+    const tHttpProgressPolicy *policy,
+    unsigned long now);
+
+/*****************************************************************************/
+/* Token bucket API                                                          */
+/* - integer arithmetic only, caller owns buckets and the time base          */
+/*****************************************************************************/
+
+/**
+ * \brief Start with a full bucket
+ */
+void HttpTokenBucket_Initialize(
+    tHttpTokenBucket *const bucket,
+    const tHttpTokenRate *rate,
+    unsigned long now);
+
+/**
+ * \brief Take one token
+ * \return 1 when taken, 0 when bucket is empty
+ */
+unsigned char HttpTokenBucket_Take(
+    tHttpTokenBucket *const bucket,
+    const tHttpTokenRate *rate,
+    unsigned long now);
+
+/**
+ * \brief Take one token from the bucket of a client key (e.g. address)
+ * Direct-mapped table of initialized buckets, keys colliding in a slot
+ * share its credit - table should be sized for concurrent clients
+ * \return 1 when taken, 0 when bucket is empty
+ */
+unsigned char HttpTokenBucket_TakeKeyed(
+    tHttpTokenBucket *const buckets,
+    unsigned int length,
+    const tHttpTokenRate *rate,
+    unsigned long key,
+    unsigned long now);
+
+#endif /* UCHTTPGUARD_H_ */
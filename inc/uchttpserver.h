@@ -47,14 +47,27 @@ typedef enum HttpStatusCode
   HTTP_BAD_REQUEST,
   HTTP_FORBIDDEN,
   HTTP_STATUS_NOT_FOUND,
+  HTTP_STATUS_REQUEST_TIMEOUT,
   HTTP_LENGTH_REQUIRED,
+  HTTP_STATUS_PAYLOAD_TOO_LARGE,
   HTTP_STATUS_REQUEST_URI_TOO_LONG,
+  HTTP_STATUS_EXPECTATION_FAILED,
   HTTP_REQUEST_HEADER_FIELDS_TOO_LARGE,
   HTTP_STATUS_SERVER_FAULT,
   HTTP_STATUS_NOT_IMPLEMENTED,
+  HTTP_STATUS_SERVICE_UNAVAILABLE,
   HTTP_VERSION_NOT_IMPLEMENTED
 } tHttpStatusCode;
 
+typedef enum HttpPhase
+{
+  HTTP_PHASE_IDLE,               /* Between requests */
+  HTTP_PHASE_REQUEST_LINE,
+  HTTP_PHASE_HEADERS,
+  HTTP_PHASE_BODY,
+  HTTP_PHASE_RESPONSE
+} tHttpPhase;
+
 typedef enum HttpMethod
 {
   HTTP_CONNECT = 0,
@@ -87,10 +100,24 @@ typedef tHttpStatusCode (
     *tResourceCallback) (
     void *const);
 
+/* Resource flags                                                            */
+#define HTTP_RESOURCE_OFFLOAD (0x01U)   /* Heavy - may run outside I/O loop */
+
+/* Resource priority classes, lower is served first                          */
+#define HTTP_PRIORITY_DEFAULT (0U)
+#define HTTP_PRIORITY_BACKGROUND (1U)
+#define HTTP_PRIORITY_BULK (2U)
+
 typedef struct ResourceEntry
 {
   tStringWithLength name;
   tResourceCallback callback;
+  unsigned char flags;
+  unsigned char priority;
+  tResourceCallback expect;     /* Before a body sent on Expect: 100-
+                                   continue, HTTP_STATUS_CONTINUE accepts
+                                   it, other status is sent as rejection;
+                                   NULL - always accepted */
 } tResourceEntry;
 
 /*****************************************************************************/
@@ -124,6 +151,82 @@ typedef struct CompareEntity
   unsigned char compareIdx;
 } tCompareEntity;
 
+/*****************************************************************************/
+/* Hot headers                                                               */
+/*****************************************************************************/
+
+/* Headers decoded while parsing, they take no parameter slot                */
+#define HTTP_HEADER_CONTENT_LENGTH (0x0001U)
+#define HTTP_HEADER_CONTENT_TYPE (0x0002U)
+#define HTTP_HEADER_TRANSFER_ENCODING (0x0004U)
+#define HTTP_HEADER_CONNECTION (0x0008U)
+#define HTTP_HEADER_EXPECT (0x0010U)
+#define HTTP_HEADER_HOST (0x0020U)
+#define HTTP_HEADER_ACCEPT_ENCODING (0x0040U)
+#define HTTP_HEADER_IF_NONE_MATCH (0x0080U)
+#define HTTP_HEADER_RANGE (0x0100U)
+
+/* Connection options                                                        */
+#define HTTP_CONNECTION_CLOSE (0x01U)
+#define HTTP_CONNECTION_KEEP_ALIVE (0x02U)
+#define HTTP_CONNECTION_UPGRADE (0x04U)
+
+/* Accept-Encoding content codings, not counted with q=0                     */
+#define HTTP_ENCODING_GZIP (0x01U)
+#define HTTP_ENCODING_DEFLATE (0x02U)
+#define HTTP_ENCODING_BR (0x04U)
+
+/* Expect expectations                                                       */
+#define HTTP_EXPECT_CONTINUE (0x01U)
+#define HTTP_EXPECT_OTHER (0x02U)     /* Any other, 417 in RFC 7231 */
+
+typedef enum HttpMediaType
+{
+  HTTP_MEDIA_NONE,
+  HTTP_MEDIA_OTHER,
+  HTTP_MEDIA_FORM_URLENCODED,
+  HTTP_MEDIA_MULTIPART_FORM_DATA,
+  HTTP_MEDIA_JSON,
+  HTTP_MEDIA_OCTET_STREAM,
+  HTTP_MEDIA_TEXT_PLAIN
+} tHttpMediaType;
+
+typedef struct HttpHeaders
+{
+  unsigned long contentLength;  /* With HTTP_HEADER_CONTENT_LENGTH */
+  const char *contentType;      /* Values as received or NULL, in the */
+  const char *host;             /* parameters buffer */
+  const char *ifNoneMatch;
+  const char *range;
+  unsigned short present;       /* HTTP_HEADER_* received */
+  unsigned char media;          /* tHttpMediaType of Content-Type */
+  unsigned char connection;     /* HTTP_CONNECTION_* */
+  unsigned char encodings;      /* HTTP_ENCODING_* */
+  unsigned char expect;         /* HTTP_EXPECT_* */
+  unsigned char chunked;        /* Last transfer coding is chunked */
+} tHttpHeaders;
+
+/*****************************************************************************/
+/* Header entity                                                             */
+/*****************************************************************************/
+
+/* Longest token told apart - application/x-www-form-urlencoded            */
+#define HTTP_HEADER_TOKEN_LENGTH (33U)
+
+typedef struct HeaderEntity
+{
+  unsigned int nameIdx;         /* Name in the parameters buffer */
+  unsigned short header;        /* HTTP_HEADER_* decoded */
+  unsigned char tokenLength;    /* Above HTTP_HEADER_TOKEN_LENGTH - unknown */
+  unsigned char elements;       /* Comma separated list elements done */
+  unsigned char value;          /* Of the element token, 0 - unknown */
+  unsigned char inParameters;   /* Past ';' of the element */
+  unsigned char rejected;       /* Element with q=0 */
+  unsigned char repeated;       /* Content-Length seen before */
+  unsigned long previousLength; /* Its value, a repeat must match it */
+  char token[HTTP_HEADER_TOKEN_LENGTH + 1U];
+} tHeaderEntity;
+
 /*****************************************************************************/
 /* Parameter entity                                                          */
 /*****************************************************************************/
@@ -138,6 +241,9 @@ typedef struct ParameterEntity
       *parameters)[][2];
   unsigned char parameterIdx;
   unsigned char parameterLength;
+#if HTTP_BUFFER_STATISTICS
+  unsigned char truncated;      /* Buffer or slots were full */
+#endif
 } tParameterEntity;
 
 /*****************************************************************************/
@@ -168,7 +274,24 @@ typedef struct ResponseEntity
   tFlushEntityFunction flush;
   tTransferType type;
   unsigned int bufferIdx;
+  unsigned int bufferStart;
+  unsigned int bufferLength;
+  unsigned char head;           /* Response to HEAD, body is dropped */
+  unsigned char headerEnd;      /* Characters of the empty line passed */
+#if HTTP_ZERO_COPY_RESPONSE || (1 < HTTP_RESPONSE_BUFFERS)
+  char *buffer;                 /* Region acquired from the port or ring */
+#if HTTP_ZERO_COPY_RESPONSE
+  char fallback[32];            /* Passed to send when acquire has none */
+#endif
+#else
   char buffer[HTTP_BUFFER_LENGTH];
+#endif
+#if HTTP_METRICS
+  unsigned int commits;         /* Sends of the current response */
+#endif
+#if HTTP_BUFFER_STATISTICS
+  unsigned long bytes;          /* Committed for the current response */
+#endif
 } tResponseEntity;
 
 /*****************************************************************************/
@@ -180,6 +303,149 @@ typedef struct ErrorInfo
   tHttpStatusCode status;
 } tErrorInfo;
 
+/*****************************************************************************/
+/* Profiling                                                                 */
+/*****************************************************************************/
+
+#if HTTP_PROFILING
+/* Parser states, see Http_ProfileStateName                                  */
+#define HTTP_PROFILE_STATES (25U)
+
+typedef struct HttpProfileCounter
+{
+  unsigned long time;           /* HTTP_CLOCK units */
+  unsigned long calls;
+} tHttpProfileCounter;
+
+typedef struct HttpProfile
+{
+  tHttpProfileCounter states[HTTP_PROFILE_STATES];
+  tHttpProfileCounter *resources;       /* Per resource entry or NULL */
+  unsigned int resourcesLength;
+} tHttpProfile;
+#endif
+
+/*****************************************************************************/
+/* Tracing                                                                   */
+/*****************************************************************************/
+
+#if HTTP_TRACING
+typedef enum HttpTraceType
+{
+  HTTP_TRACE_CONNECTION,        /* Http_SetTrace */
+  HTTP_TRACE_REQUEST_LINE,      /* detail - method, arg - resource index */
+  HTTP_TRACE_HEADERS,
+  HTTP_TRACE_BODY,              /* arg - bytes parsed by one Http_Input */
+  HTTP_TRACE_HANDLER_START,     /* arg - resource index */
+  HTTP_TRACE_HANDLER_END,       /* arg - 1 when callback yielded */
+  HTTP_TRACE_SEND,              /* arg - bytes handed to the port */
+  HTTP_TRACE_FLUSH,
+  HTTP_TRACE_ERROR              /* arg - status code, e.g. 404 */
+} tHttpTraceType;
+
+typedef struct HttpTraceEvent
+{
+  unsigned long time;           /* HTTP_CLOCK units */
+  unsigned long arg;
+  unsigned short connection;    /* Given to Http_SetTrace */
+  unsigned char type;
+  unsigned char detail;
+  unsigned long sequence;       /* Position in the ring + 1, stored last */
+} tHttpTraceEvent;
+
+/* Ring of one thread and the resources it defers, oldest events are
+ * overwritten; a slot is reserved by head and valid once its sequence
+ * matches                                                                   */
+typedef struct HttpTrace
+{
+  tHttpTraceEvent *events;
+  unsigned long mask;           /* Length - 1 */
+  volatile unsigned long head;  /* Events ever recorded */
+} tHttpTrace;
+#endif
+
+/*****************************************************************************/
+/* Buffer statistics                                                         */
+/*****************************************************************************/
+
+#if HTTP_BUFFER_STATISTICS
+/* Peaks to right-size the options in uchttpoption.h                         */
+typedef struct HttpBufferStatistics
+{
+  unsigned long searchPeak;     /* Request target, HTTP_PARAMETERS_BUFFER_LENGTH
+                                   up to 255 */
+  unsigned long parametersPeak; /* Of HTTP_PARAMETERS_BUFFER_LENGTH */
+  unsigned long slotsPeak;      /* Of HTTP_PARAMETERS_MAX */
+  unsigned long responsePeak;   /* Longest response, above HTTP_BUFFER_LENGTH
+                                   it takes more sends */
+  unsigned long truncations;    /* Requests which did not fit */
+} tHttpBufferStatistics;
+#endif
+
+/*****************************************************************************/
+/* Metrics                                                                   */
+/*****************************************************************************/
+
+#if HTTP_METRICS
+#define HTTP_METRICS_METHODS (8U)
+#define HTTP_METRICS_STATUSES (15U)
+/* Sends per response histogram, upper bounds 1, 2, 4, 8, 16 and +Inf       */
+#define HTTP_METRICS_SEND_BUCKETS (6U)
+
+/* Owned by one thread, resources it defers add through HTTP_ATOMIC_ADD -
+ * keep each on its own cache lines                                          */
+typedef struct HttpMetrics
+{
+  unsigned long methods[HTTP_METRICS_METHODS];    /* Parsed methods */
+  unsigned long statuses[HTTP_METRICS_STATUSES];  /* Responses sent */
+  unsigned long errors[HTTP_METRICS_STATUSES];    /* Rejected by parser */
+  unsigned long sendBuckets[HTTP_METRICS_SEND_BUCKETS];
+  unsigned long sends;
+  unsigned long bytesIn;
+  unsigned long bytesOut;
+  unsigned long connections;    /* Open now, maintained by the port */
+#if HTTP_BUFFER_STATISTICS
+  tHttpBufferStatistics buffers;        /* Of all connections */
+#endif
+  unsigned long *resources;     /* Requests per resource entry or NULL */
+  unsigned int resourcesLength;
+  struct HttpMetrics *next;     /* Ring of metrics summed on rendering */
+} tHttpMetrics;
+#endif
+
+/*****************************************************************************/
+/* Latency histograms                                                        */
+/*****************************************************************************/
+
+#if HTTP_LATENCY_HISTOGRAMS
+#define HTTP_LATENCY_BUCKETS \
+  ((HTTP_LATENCY_MAGNITUDES + 1U) << HTTP_LATENCY_SUB_BITS)
+
+/* Values below 2^HTTP_LATENCY_SUB_BITS exact, then that many buckets
+ * per power of two */
+typedef struct HttpHistogram
+{
+  unsigned long counts[HTTP_LATENCY_BUCKETS];
+  unsigned long total;
+  unsigned long max;
+} tHttpHistogram;
+
+typedef struct HttpLatency
+{
+  tHttpHistogram request;       /* First request byte to final flush */
+  tHttpHistogram handler;       /* Each resource callback invocation */
+} tHttpLatency;
+
+/* Owned by one thread, resources it defers record through
+ * HTTP_ATOMIC_ADD, rings are merged on reading                            */
+typedef struct HttpLatencies
+{
+  tHttpLatency *resources;      /* Per resource entry */
+  unsigned int resourcesLength;
+  struct HttpLatencies *next;
+} tHttpLatencies;
+#endif
+
 /*****************************************************************************/
 /* General inteface                                                          */
 /*****************************************************************************/
@@ -195,12 +461,37 @@ typedef void (
     void *const conn,
     const tErrorInfo *errorInfo);
 
-typedef unsigned int (
-    *tParserState) (
-    void *const,
+typedef unsigned char (
+    *tDeferCallback) (
+    void *const conn,
+    const tResourceEntry *resource);
+
+typedef unsigned char (
+    *tAdmitCallback) (
+    void *const conn,
+    const tResourceEntry *resource);
+
+typedef char *(
+    *tAcquireCallback) (
+    void *const conn,
+    unsigned int *length);
+
+typedef void (
+    *tCommitCallback) (
+    void *const conn,
     const char *data,
     unsigned int length);
 
+#if 1 < HTTP_RESPONSE_BUFFERS
+typedef struct ResponseRing
+{
+  char buffer[HTTP_RESPONSE_BUFFERS][HTTP_BUFFER_LENGTH];
+  unsigned char head;
+  unsigned char committed;
+  volatile unsigned char released;      /* Written by completion only */
+} tResponseRing;
+#endif
+
 typedef struct SearchPhaseArea
 {
   tSearchEntity searchEntity;
@@ -211,6 +502,7 @@ typedef struct ParsePhaseArea
 {
   tParameterEntity parameterEntity;
   tCompareEntity compareEntity;
+  tHeaderEntity headerEntity;
 } tParsePhaseArea;
 
 typedef struct ContentPhaseArea
@@ -232,14 +524,53 @@ typedef struct uCHttpServerState
   unsigned char method;
   unsigned char initialization;
   unsigned int resourceIdx;
-  unsigned int contentLength;
-  tParserState state;
+  unsigned int contentLength;   /* Left of the body */
+  tHttpHeaders headers;
+  unsigned char state;           /* Parser state ID */
+  unsigned char close;           /* Connection ends after the response */
+#if HTTP_KEEP_ALIVE_MAX_REQUESTS
+  unsigned int requests;        /* Served on the connection */
+#endif
   const tResourceEntry (
       *resources)[];            /* Or set as singleton */
   unsigned int resourcesLength;
   tSendCallback send;
   tErrorCallback onError;
+#if HTTP_ZERO_COPY_RESPONSE
+  tAcquireCallback acquire;
+  tCommitCallback commit;
+#endif
+#if HTTP_DEFERRED_RESOURCES
+  tDeferCallback defer;
+#endif
+#if HTTP_ADMISSION_CONTROL
+  tAdmitCallback admit;
+#endif
   void *context;
+#if HTTP_PROFILING
+  tHttpProfile *profile;         /* Indexed by parser state ID */
+#endif
+#if HTTP_TRACING
+  tHttpTrace *trace;
+  unsigned short traceId;
+#endif
+#if HTTP_METRICS
+  tHttpMetrics *metrics;
+#endif
+#if HTTP_LATENCY_HISTOGRAMS
+  tHttpLatencies *latencies;
+  unsigned long requestStart;   /* HTTP_CLOCK at first request byte */
+#endif
+#if HTTP_BUFFER_STATISTICS
+  tHttpBufferStatistics buffers;
+#endif
+#if HTTP_RESOURCE_CONTINUATION
+  unsigned long cursor;         /* Progress of yielding resource */
+  unsigned char yielded;
+#endif
+#if 1 < HTTP_RESPONSE_BUFFERS
+  tResponseRing ring;
+#endif
   char parametersBuffer[HTTP_PARAMETERS_BUFFER_LENGTH];
   char *parameters[HTTP_PARAMETERS_MAX][2];
 } tuCHttpServerState;
@@ -261,14 +592,281 @@ void Http_InitializeConnection(
     unsigned int reslen,
     void *context);
 
+#if HTTP_ZERO_COPY_RESPONSE
+/**
+ * \brief Attach transmit buffer of the port
+ * Response is rendered directly into regions handed out by acquire
+ * (at least 32 bytes long). Commit receives the written part, which may
+ * start at an offset within the region, or zero length when region is
+ * released unused. Acquire returns NULL when the port has no region free,
+ * the engine then renders into a small buffer of its own and passes it to
+ * the send callback, which must queue the copy. Must be called after
+ * Http_InitializeConnection, without it all output takes the latter path
+ */
+void Http_InitializeTransmitBuffer(
+    tuCHttpServerState *const sm,
+    tAcquireCallback acquire,
+    tCommitCallback commit);
+#endif
+
+#if 1 < HTTP_RESPONSE_BUFFERS
+/**
+ * \brief Release the oldest response buffer passed to send callback
+ * In this mode send callback only starts the transfer, data stays valid
+ * until completion. Call once per send, may be called from interrupt
+ */
+void Http_OutputComplete(
+    tuCHttpServerState *const sm);
+#endif
+
+#if HTTP_DEFERRED_RESOURCES
+/**
+ * \brief Attach deferral decision of the port
+ * Called when request is complete, returning 1 suspends the connection
+ * before resource callback runs. Callback only decides, the request may
+ * be handed to another thread after Http_Input returns
+ */
+void Http_SetDeferCallback(
+    tuCHttpServerState *const sm,
+    tDeferCallback defer);
+
+/**
+ * \brief Run resource callback of a suspended connection
+ * Request parameters stay intact while suspended. Afterwards connection
+ * accepts input again, starting with bytes not consumed by Http_Input,
+ * unless the callback yielded
+ */
+void Http_RunDeferred(
+    tuCHttpServerState *const sm);
+#endif
+
+#if HTTP_ADMISSION_CONTROL
+/**
+ * \brief Attach admission decision of the port
+ * Called after the request line, before headers are parsed. Returning 0
+ * rejects the request with a pre-rendered 503, the rest of the stream is
+ * discarded and the port should close the connection after output
+ */
+void Http_SetAdmitCallback(
+    tuCHttpServerState *const sm,
+    tAdmitCallback admit);
+#endif
+
+#if HTTP_PROFILING
+/**
+ * \brief Account time spent by the connection in the given profile
+ * Profile may be shared by connections served by one thread, and by
+ * resources it defers to others through HTTP_ATOMIC_ADD, NULL stops
+ * accounting. Time of a state includes resource callbacks it calls
+ */
+void Http_SetProfile(
+    tuCHttpServerState *const sm,
+    tHttpProfile *profile);
+
+/**
+ * \brief Zero state and resource counters
+ */
+void Http_ProfileReset(
+    tHttpProfile *profile);
+
+/**
+ * \brief Name of the state counted at idx, NULL past the last one
+ */
+const char *Http_ProfileStateName(
+    unsigned int idx);
+#endif
+
+#if HTTP_TRACING
+/**
+ * \brief Prepare ring of events, length must be a power of two
+ */
+void Http_TraceInitialize(
+    tHttpTrace *trace,
+    tHttpTraceEvent *events,
+    unsigned long length);
+
+/**
+ * \brief Record events of the connection in the given ring
+ * Ring may be shared by connections served by one thread, and by
+ * resources it defers to others (slots are reserved with HTTP_ATOMIC_ADD),
+ * NULL stops recording. Id tells connections apart in the ring
+ */
+void Http_SetTrace(
+    tuCHttpServerState *const sm,
+    tHttpTrace *trace,
+    unsigned short id);
+
+/**
+ * \brief Copy the newest events, oldest first
+ * May run concurrently with writers, events they overwrote meanwhile or
+ * did not finish yet are left out
+ * \return number of copied events
+ */
+unsigned long Http_TraceCopy(
+    const tHttpTrace *trace,
+    tHttpTraceEvent *events,
+    unsigned long length);
+#endif
+
+#if HTTP_METRICS
+/**
+ * \brief Zero counters, resources may be NULL
+ * Metrics form a ring of one until linked with others
+ */
+void Http_MetricsInitialize(
+    tHttpMetrics *metrics,
+    unsigned long *resources,
+    unsigned int resourcesLength);
+
+/**
+ * \brief Add other metrics to the ring rendered together with these
+ * Link before serving starts, e.g. one metrics per worker thread
+ */
+void Http_MetricsLink(
+    tHttpMetrics *metrics,
+    tHttpMetrics *other);
+
+/**
+ * \brief Count requests of the connection in the given metrics
+ * Metrics may be shared by connections served by one thread, and by
+ * resources it defers to others through HTTP_ATOMIC_ADD, NULL stops
+ * counting
+ */
+void Http_SetMetrics(
+    tuCHttpServerState *const sm,
+    tHttpMetrics *metrics);
+
+/**
+ * \brief Resource callback rendering the metrics ring of the connection
+ * in Prometheus text format
+ * Counters of other threads are read without locking
+ */
+tHttpStatusCode Http_MetricsResource(
+    void *const conn);
+#endif
+
+#if HTTP_BUFFER_STATISTICS
+/**
+ * \brief Take peaks and add truncations of source into destination
+ * E.g. to aggregate connections before they are reused; destination is
+ * updated with HTTP_ATOMIC_CAS and HTTP_ATOMIC_ADD
+ */
+void Http_BufferStatisticsMerge(
+    tHttpBufferStatistics *destination,
+    const tHttpBufferStatistics *source);
+#endif
+
+#if HTTP_LATENCY_HISTOGRAMS
+/**
+ * \brief Zero histograms of all resources
+ * Latencies form a ring of one until linked with others
+ */
+void Http_LatencyInitialize(
+    tHttpLatencies *latencies,
+    tHttpLatency *resources,
+    unsigned int resourcesLength);
+
+/**
+ * \brief Add other latencies to the ring merged by Http_LatencyMerge
+ * Link before serving starts, e.g. one per worker thread
+ */
+void Http_LatencyLink(
+    tHttpLatencies *latencies,
+    tHttpLatencies *other);
+
+/**
+ * \brief Record requests of the connection in the given latencies
+ * Latencies may be shared by connections served by one thread, and by
+ * resources it defers to others through HTTP_ATOMIC_ADD, NULL stops
+ * recording
+ */
+void Http_SetLatencies(
+    tuCHttpServerState *const sm,
+    tHttpLatencies *latencies);
+
+/**
+ * \brief Sum histograms of one resource over the whole ring
+ * Histograms of other threads are read without locking
+ */
+void Http_LatencyMerge(
+    const tHttpLatencies *latencies,
+    unsigned int resourceIdx,
+    tHttpLatency *merged);
+
+void Http_HistogramReset(
+    tHttpHistogram *histogram);
+
+void Http_HistogramRecord(
+    tHttpHistogram *histogram,
+    unsigned long value);
+
+/**
+ * \brief Add counts of source to destination
+ */
+void Http_HistogramMerge(
+    tHttpHistogram *destination,
+    const tHttpHistogram *source);
+
+/**
+ * \brief Value at or below which the given share of samples lies
+ * \param basisPoints 5000 - median, 9900 - p99, 9990 - p999
+ * \return Highest value of the matching bucket, at most the maximum
+ * recorded, or 0 when empty
+ */
+unsigned long Http_HistogramPercentile(
+    const tHttpHistogram *histogram,
+    unsigned int basisPoints);
+#endif
+
+#if HTTP_RESOURCE_CONTINUATION
+/**
+ * \brief Check if resource callback yielded and waits for Http_Continue
+ * Http_Input does not consume input until the response is complete
+ */
+unsigned char Http_HasContinuation(
+    tuCHttpServerState *const sm);
+
+/**
+ * \brief Run next slice of yielded resource callback
+ * \return 1 when it yielded again
+ */
+unsigned char Http_Continue(
+    tuCHttpServerState *const sm);
+#endif
+
 /**
  * \brief Entry point for input stream processing
+ * \return number of consumed bytes, less than length only when
+ * connection got suspended
  */
-void Http_Input(
+unsigned int Http_Input(
     tuCHttpServerState *const sm,
     const char *data,
     unsigned int length);
 
+/**
+ * \brief Input stream processing bounded by a budget
+ * Length is the byte budget, requests (NULL - unlimited) holds number of
+ * requests which may be answered and is decremented for each of them.
+ * Remaining input is passed in the next call, parser resumes where it
+ * stopped
+ * \return number of consumed bytes
+ */
+unsigned int Http_InputBudget(
+    tuCHttpServerState *const sm,
+    const char *data,
+    unsigned int length,
+    unsigned int *requests);
+
+/**
+ * \brief Check if the last response ended the connection
+ * Set after Connection: close, HTTP_KEEP_ALIVE_MAX_REQUESTS requests, an
+ * error or a body that cannot be skipped. Further input is discarded, the
+ * port should close the connection once pending output is written
+ */
+unsigned char Http_ShouldClose(
+    tuCHttpServerState *const sm);
+
 /*****************************************************************************/
 /* Helper API                                                                */
 /*****************************************************************************/
@@ -276,13 +874,87 @@ void Http_Input(
 tHttpMethod Http_HelperGetMethod(
     tuCHttpServerState *const sm);
 
+/**
+ * \brief Check if only the header of the response is sent (HEAD request)
+ * Body bytes are dropped by the engine anyway, resource may skip rendering
+ * them but should send the same header as for GET
+ */
+unsigned char Http_HelperHeadOnly(
+    tuCHttpServerState *const sm);
+
 void *Http_HelperGetContext(
     tuCHttpServerState *const sm);
 
+/**
+ * \brief Resource of the request in progress, NULL before it is known
+ */
+const tResourceEntry *Http_HelperGetResource(
+    tuCHttpServerState *const sm);
+
+/**
+ * \brief Part of the request the connection is in, lets port pick timeouts
+ */
+tHttpPhase Http_HelperGetPhase(
+    tuCHttpServerState *const sm);
+
+#if HTTP_PROFILING
+tHttpProfile *Http_HelperGetProfile(
+    tuCHttpServerState *const sm);
+#endif
+
+#if HTTP_TRACING
+tHttpTrace *Http_HelperGetTrace(
+    tuCHttpServerState *const sm);
+#endif
+
+#if HTTP_METRICS
+tHttpMetrics *Http_HelperGetMetrics(
+    tuCHttpServerState *const sm);
+#endif
+
+#if HTTP_LATENCY_HISTOGRAMS
+tHttpLatencies *Http_HelperGetLatencies(
+    tuCHttpServerState *const sm);
+#endif
+
+#if HTTP_BUFFER_STATISTICS
+/**
+ * \brief Peaks of the connection since Http_InitializeConnection, with
+ * HTTP_METRICS aggregated in metrics as well
+ */
+const tHttpBufferStatistics *Http_HelperGetBufferStatistics(
+    tuCHttpServerState *const sm);
+#endif
+
+#if HTTP_RESOURCE_CONTINUATION
+/**
+ * \brief Return from resource callback without finishing the response
+ * Callback is called again with the same response in progress, cursor
+ * tells where to continue (0 on the first call of each request)
+ */
+void Http_HelperYield(
+    tuCHttpServerState *const sm,
+    unsigned long cursor);
+
+unsigned long Http_HelperGetCursor(
+    tuCHttpServerState *const sm);
+#endif
+
+/**
+ * \brief Query and form parameters and headers; of hot headers only the ones
+ * kept as received (Content-Type, Host, If-None-Match, Range)
+ */
 const char *Http_HelperGetParameter(
     tuCHttpServerState *const sm,
     const char *param);
 
+/**
+ * \brief Hot headers of the request, valid from its resource callback until
+ * the next request (HTTP_HEADER_* in present tells which were received)
+ */
+const tHttpHeaders *Http_HelperGetHeaders(
+    tuCHttpServerState *const sm);
+
 void Http_HelperSetResponseStatus(
     tuCHttpServerState *const sm,
     tHttpStatusCode code);
@@ -292,9 +964,25 @@ void Http_HelperSetResponseHeader(
     const char *name,
     const char *value);
 
+/**
+ * \brief End the response header, chunked body follows unless
+ * Content-Length was set
+ * Adds Connection: keep-alive or close, whichever the connection will do
+ */
 void Http_HelperSendHeader(
     tuCHttpServerState *const sm);
 
+/**
+ * \brief End the response header with Content-Length and send the body
+ * For content rendered in advance, e.g. static files. Content-Type is left
+ * out when NULL, the body is not touched for HEAD. Flushes the response
+ */
+void Http_HelperSendContent(
+    tuCHttpServerState *const sm,
+    const char *contentType,
+    const char *data,
+    unsigned int length);
+
 void Http_HelperSendMessageBody(
     tuCHttpServerState *const sm,
     const char *body);
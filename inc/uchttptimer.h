@@ -0,0 +1,126 @@
+/*
+ uchttptimer.h
+
+ MIT License
+
+ Copyright (c) 2026 uChttpserver contributors
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+  Created on: Oct 18, 2026
+      Author: uChttpserver contributors
+ */
+
+#ifndef UCHTTPTIMER_H_
+#define UCHTTPTIMER_H_
+
+/*****************************************************************************/
+/* Includes                                                                  */
+/*****************************************************************************/
+
+#include "uchttpoption.h"
+
+/*****************************************************************************/
+/* Defines                                                                   */
+/*****************************************************************************/
+
+#define HTTP_TIMER_SLOTS (1U << HTTP_TIMER_LEVEL_BITS)
+
+/*****************************************************************************/
+/* Type definitions                                                          */
+/*****************************************************************************/
+
+typedef struct HttpTimerLink
+{
+  struct HttpTimerLink *next;
+  struct HttpTimerLink *prev;
+} tHttpTimerLink;
+
+struct HttpTimer;
+
+typedef void (
+    *tHttpTimerCallback) (
+    struct HttpTimer *timer);
+
+typedef struct HttpTimer
+{
+  tHttpTimerLink link;           /* Must stay first */
+  unsigned long expires;
+  tHttpTimerCallback callback;
+  void *context;
+} tHttpTimer;
+
+typedef struct HttpTimerWheel
+{
+  unsigned long now;             /* Next tick to be processed */
+  tHttpTimerLink slots[HTTP_TIMER_LEVELS][HTTP_TIMER_SLOTS];
+} tHttpTimerWheel;
+
+/*****************************************************************************/
+/* Timer wheel API                                                           */
+/* - hierarchical hashed wheel, timers are owned by the caller, scheduling   */
+/*   and cancelling is O(1), far timers cascade towards level 0 once        */
+/*   per wrap of the level below                                             */
+/*****************************************************************************/
+
+/**
+ * \brief Prepare wheel, now is the current tick
+ */
+void HttpTimer_InitializeWheel(
+    tHttpTimerWheel *const wheel,
+    unsigned long now);
+
+/**
+ * \brief Prepare timer, context is available to the callback
+ */
+void HttpTimer_Initialize(
+    tHttpTimer *const timer,
+    tHttpTimerCallback callback,
+    void *context);
+
+/**
+ * \brief Arm timer to expire after given number of ticks, rearms pending one
+ * Delays beyond the wheel range are clamped to its end
+ */
+void HttpTimer_Schedule(
+    tHttpTimerWheel *const wheel,
+    tHttpTimer *const timer,
+    unsigned long ticks);
+
+/**
+ * \brief Disarm timer, no-op when it is not pending
+ */
+void HttpTimer_Cancel(
+    tHttpTimer *const timer);
+
+/**
+ * \brief Check if timer is armed
+ */
+unsigned char HttpTimer_IsPending(
+    const tHttpTimer *timer);
+
+/**
+ * \brief Process ticks up to now, calling callbacks of expired timers
+ * Callbacks may schedule and cancel any timer, including their own
+ */
+void HttpTimer_Advance(
+    tHttpTimerWheel *const wheel,
+    unsigned long now);
+
+#endif /* UCHTTPTIMER_H_ */
@@ -0,0 +1,358 @@
+/*
+ capture-replay.c
+
+ MIT License
+
+ Copyright (c) 2026 uChttpserver contributors
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+  Created on: Oct 18, 2026
+      Author: uChttpserver contributors
+ */
+
+/*****************************************************************************/
+/* Includes                                                                  */
+/*****************************************************************************/
+
+#define _GNU_SOURCE
+
+#include "capture.h"
+#include "example-resources.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/*****************************************************************************/
+/* Type definitions                                                          */
+/*****************************************************************************/
+
+typedef struct ReplayStatistics
+{
+  unsigned long long records;
+  unsigned long long connections;
+  unsigned long long bytesIn;
+  unsigned long long sends;
+  unsigned long long bytesOut;
+  unsigned long long errors;
+  unsigned long long stalls;     /* Input the state machine did not take */
+} tReplayStatistics;
+
+/*****************************************************************************/
+/* Local functions (declarations)                                            */
+/*****************************************************************************/
+
+static char *Replay_Load(
+    const char *path,
+    unsigned long *length);
+static int Replay_Run(
+    const char *capture,
+    unsigned long length,
+    double speedup,
+    tReplayStatistics *stats);
+static void Replay_Input(
+    tuCHttpServerState *const sm,
+    const char *data,
+    unsigned int length,
+    tReplayStatistics *stats);
+static unsigned long long Replay_Clock(
+    clockid_t clock);
+
+static unsigned int Replay_Send(
+    void *const conn,
+    const char *data,
+    unsigned int length);
+static void Replay_Error(
+    void *const conn,
+    const tErrorInfo *errorInfo);
+
+/*****************************************************************************/
+/* Entry point                                                               */
+/*****************************************************************************/
+
+int main(
+    int argc,
+    char **argv)
+{
+  tReplayStatistics stats;
+  double speedup = 0.0;
+  unsigned long repeat = 1UL;
+  unsigned long length;
+  unsigned long long cpu;
+  unsigned long long wall;
+  unsigned long i;
+  char *capture;
+  int opt;
+
+  /* capture-replay [-x speedup, 0 - no pauses] [-n repeat] file */
+  while (-1 != (opt = getopt(argc, argv, "x:n:")))
+  {
+    switch (opt)
+    {
+      case 'x':
+        speedup = atof(optarg);
+        break;
+      case 'n':
+        repeat = strtoul(optarg, NULL, 10);
+        break;
+      default:
+        optind = argc;
+        break;
+    }
+  }
+  if (optind + 1 != argc || 0.0 > speedup || 0UL == repeat)
+  {
+    fprintf(stderr, "usage: %s [-x speedup] [-n repeat] capture\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  capture = Replay_Load(argv[optind], &length);
+  if (NULL == capture)
+  {
+    perror(argv[optind]);
+    return EXIT_FAILURE;
+  }
+
+  /* Thread CPU time excludes pauses, wall time includes them */
+  memset(&stats, 0, sizeof(stats));
+  cpu = Replay_Clock(CLOCK_THREAD_CPUTIME_ID);
+  wall = Replay_Clock(CLOCK_MONOTONIC);
+  for (i = 0UL; i < repeat; i++)
+  {
+    if (0 != Replay_Run(capture, length, speedup, &stats))
+    {
+      fprintf(stderr, "%s: malformed capture\n", argv[optind]);
+      free(capture);
+      return EXIT_FAILURE;
+    }
+  }
+  cpu = Replay_Clock(CLOCK_THREAD_CPUTIME_ID) - cpu;
+  wall = Replay_Clock(CLOCK_MONOTONIC) - wall;
+
+  printf("{\n  \"benchmark\": \"capture-replay\",\n  \"capture\": \"%s\",\n"
+      "  \"repeat\": %lu,\n  \"speedup\": %g,\n  \"records\": %llu,\n"
+      "  \"connections\": %llu,\n  \"bytes_in\": %llu,\n  \"sends\": %llu,\n"
+      "  \"bytes_out\": %llu,\n  \"errors\": %llu,\n  \"stalls\": %llu,\n",
+      argv[optind], repeat, speedup, stats.records, stats.connections,
+      stats.bytesIn, stats.sends, stats.bytesOut, stats.errors,
+      stats.stalls);
+  printf("  \"cpu_ms\": %.3f,\n  \"wall_ms\": %.3f,\n"
+      "  \"cpu_ns_per_byte\": %.2f,\n  \"sends_per_connection\": %.2f\n}\n",
+      cpu * 1e-6, wall * 1e-6,
+      (0ULL < stats.bytesIn) ? (double) cpu / stats.bytesIn : 0.0,
+      (0ULL < stats.connections) ?
+          (double) stats.sends / stats.connections : 0.0);
+
+  free(capture);
+  return EXIT_SUCCESS;
+}
+
+/*****************************************************************************/
+/* Local functions (definitions)                                             */
+/*****************************************************************************/
+
+static char *Replay_Load(
+    const char *path,
+    unsigned long *length)
+{
+  FILE *file = fopen(path, "rb");
+  char *capture = NULL;
+  long size;
+
+  if (NULL == file)
+  {
+    return NULL;
+  }
+  if (0 == fseek(file, 0L, SEEK_END) && 0L <= (size = ftell(file)) &&
+      0 == fseek(file, 0L, SEEK_SET))
+  {
+    capture = malloc((size_t) size + 1U);
+    if (NULL != capture &&
+        (size_t) size != fread(capture, 1U, (size_t) size, file))
+    {
+      free(capture);
+      capture = NULL;
+    }
+    *length = (unsigned long) size;
+  }
+  fclose(file);
+
+  return capture;
+}
+
+static int Replay_Run(
+    const char *capture,
+    unsigned long length,
+    double speedup,
+    tReplayStatistics *stats)
+{
+  tuCHttpServerState **connections = NULL;
+  unsigned long connectionsLength = 0UL;
+  unsigned long long start = Replay_Clock(CLOCK_MONOTONIC);
+  unsigned long offset = 0UL;
+  tHttpCaptureRecord record;
+  unsigned long i;
+  int result;
+
+  /* Recording is loaded before, only the state machine is measured */
+  while (1 == (result = HttpCapture_Next(capture, length, &offset,
+      &record)))
+  {
+    tuCHttpServerState *sm = NULL;
+
+    if (0.0 < speedup)
+    {
+      unsigned long long due = start +
+          (unsigned long long) (record.time * 1000.0 / speedup);
+      unsigned long long now = Replay_Clock(CLOCK_MONOTONIC);
+
+      if (due > now)
+      {
+        struct timespec pause;
+
+        pause.tv_sec = (time_t) ((due - now) / 1000000000ULL);
+        pause.tv_nsec = (long) ((due - now) % 1000000000ULL);
+        nanosleep(&pause, NULL);
+      }
+    }
+
+    ++(stats->records);
+    if (record.connection >= connectionsLength)
+    {
+      unsigned long grown = (0UL < connectionsLength) ?
+          connectionsLength : 64UL;
+      tuCHttpServerState **table;
+
+      while (grown <= record.connection)
+      {
+        grown *= 2UL;
+      }
+      table = realloc(connections, grown * sizeof(*connections));
+      if (NULL == table)
+      {
+        result = -1;
+        break;
+      }
+      memset(table + connectionsLength, 0,
+          (grown - connectionsLength) * sizeof(*connections));
+      connections = table;
+      connectionsLength = grown;
+    }
+    sm = connections[record.connection];
+
+    switch (record.kind)
+    {
+      case HTTP_CAPTURE_OPEN:
+        free(sm);
+        sm = malloc(sizeof(tuCHttpServerState));
+        if (NULL != sm)
+        {
+          Http_InitializeConnection(sm, &Replay_Send, &Replay_Error,
+              &exampleResources, exampleResourcesLength, stats);
+          ++(stats->connections);
+        }
+        connections[record.connection] = sm;
+        break;
+      case HTTP_CAPTURE_INPUT:
+        if (NULL != sm)
+        {
+          Replay_Input(sm, record.data, record.length, stats);
+        }
+        break;
+      default:
+        free(sm);
+        connections[record.connection] = NULL;
+        break;
+    }
+  }
+
+  for (i = 0UL; i < connectionsLength; i++)
+  {
+    free(connections[i]);
+  }
+  free(connections);
+
+  return (0 > result) ? -1 : 0;
+}
+
+static void Replay_Input(
+    tuCHttpServerState *const sm,
+    const char *data,
+    unsigned int length,
+    tReplayStatistics *stats)
+{
+  unsigned int consumed = 0U;
+
+  stats->bytesIn += length;
+  while (consumed < length)
+  {
+    unsigned int parsed = Http_Input(sm, data + consumed, length - consumed);
+
+    consumed += parsed;
+#if HTTP_RESOURCE_CONTINUATION
+    if (Http_HasContinuation(sm))
+    {
+      /* Slices the port ran between other connections, back to back */
+      while (Http_Continue(sm))
+      {
+      }
+      continue;
+    }
+#endif
+    if (0U == parsed)
+    {
+      ++(stats->stalls);
+      break;
+    }
+  }
+}
+
+static unsigned long long Replay_Clock(
+    clockid_t clock)
+{
+  struct timespec ts;
+
+  clock_gettime(clock, &ts);
+  return (unsigned long long) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static unsigned int Replay_Send(
+    void *const conn,
+    const char *data,
+    unsigned int length)
+{
+  tReplayStatistics *const stats = Http_HelperGetContext(conn);
+
+  /* Responses are counted and discarded */
+  ++(stats->sends);
+  stats->bytesOut += length;
+  return length;
+}
+
+static void Replay_Error(
+    void *const conn,
+    const tErrorInfo *errorInfo)
+{
+  tReplayStatistics *const stats = Http_HelperGetContext(conn);
+
+  ++(stats->errors);
+}
@@ -0,0 +1,253 @@
+/*
+ capture.c
+
+ MIT License
+
+ Copyright (c) 2026 uChttpserver contributors
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+  Created on: Oct 18, 2026
+      Author: uChttpserver contributors
+ */
+
+/*****************************************************************************/
+/* Includes                                                                  */
+/*****************************************************************************/
+
+#include "capture.h"
+
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+
+/*****************************************************************************/
+/* Constants                                                                 */
+/*****************************************************************************/
+
+static const char captureMagic[5] = { 'u', 'C', 'H', 'c', 1 };
+
+/*****************************************************************************/
+/* Local functions (declarations)                                            */
+/*****************************************************************************/
+
+static void Capture_Record(
+    tHttpCapture *const capture,
+    unsigned long connection,
+    tHttpCaptureKind kind,
+    const char *data,
+    unsigned int length);
+static unsigned int Capture_Put(
+    unsigned char *out,
+    unsigned long long value);
+static int Capture_Get(
+    const char *capture,
+    unsigned long length,
+    unsigned long *offset,
+    unsigned long long *value);
+
+/*****************************************************************************/
+/* Global functions                                                          */
+/*****************************************************************************/
+
+int HttpCapture_Open(
+    tHttpCapture *const capture,
+    const char *path)
+{
+  capture->file = fopen(path, "wb");
+  if (NULL == capture->file)
+  {
+    return -1;
+  }
+  if (sizeof(captureMagic) != fwrite(captureMagic, 1U, sizeof(captureMagic),
+      capture->file))
+  {
+    int error = errno;
+
+    fclose(capture->file);
+    errno = error;
+    return -1;
+  }
+  pthread_mutex_init(&(capture->lock), NULL);
+  capture->last = 0ULL;
+  capture->connections = 0UL;
+
+  return 0;
+}
+
+unsigned long HttpCapture_Connection(
+    tHttpCapture *const capture)
+{
+  unsigned long connection;
+
+  pthread_mutex_lock(&(capture->lock));
+  connection = capture->connections++;
+  pthread_mutex_unlock(&(capture->lock));
+  Capture_Record(capture, connection, HTTP_CAPTURE_OPEN, NULL, 0U);
+
+  return connection;
+}
+
+void HttpCapture_Input(
+    tHttpCapture *const capture,
+    unsigned long connection,
+    const char *data,
+    unsigned int length)
+{
+  Capture_Record(capture, connection, HTTP_CAPTURE_INPUT, data, length);
+}
+
+void HttpCapture_Closed(
+    tHttpCapture *const capture,
+    unsigned long connection)
+{
+  Capture_Record(capture, connection, HTTP_CAPTURE_CLOSE, NULL, 0U);
+}
+
+void HttpCapture_Close(
+    tHttpCapture *const capture)
+{
+  fclose(capture->file);
+  capture->file = NULL;
+  pthread_mutex_destroy(&(capture->lock));
+}
+
+int HttpCapture_Next(
+    const char *capture,
+    unsigned long length,
+    unsigned long *offset,
+    tHttpCaptureRecord *record)
+{
+  unsigned long long delta;
+  unsigned long long tagged;
+  unsigned long long bytes = 0ULL;
+
+  if (0UL == *offset)
+  {
+    if (sizeof(captureMagic) > length ||
+        0 != memcmp(capture, captureMagic, sizeof(captureMagic)))
+    {
+      return -1;
+    }
+    *offset = sizeof(captureMagic);
+    record->time = 0ULL;
+  }
+  if (*offset == length)
+  {
+    return 0;
+  }
+
+  if (0 != Capture_Get(capture, length, offset, &delta) ||
+      0 != Capture_Get(capture, length, offset, &tagged) ||
+      HTTP_CAPTURE_CLOSE < (tagged & 3ULL) ||
+      (HTTP_CAPTURE_INPUT == (tagged & 3ULL) &&
+          (0 != Capture_Get(capture, length, offset, &bytes) ||
+              length - *offset < bytes)))
+  {
+    return -1;
+  }
+  record->time += delta;
+  record->connection = (unsigned long) (tagged >> 2);
+  record->kind = (tHttpCaptureKind) (tagged & 3ULL);
+  record->length = (unsigned int) bytes;
+  record->data = capture + *offset;
+  *offset += (unsigned long) bytes;
+
+  return 1;
+}
+
+/*****************************************************************************/
+/* Local functions (definitions)                                             */
+/*****************************************************************************/
+
+static void Capture_Record(
+    tHttpCapture *const capture,
+    unsigned long connection,
+    tHttpCaptureKind kind,
+    const char *data,
+    unsigned int length)
+{
+  unsigned char header[30];
+  unsigned int used;
+  unsigned long long now;
+  struct timespec ts;
+
+  /* Time is read under the lock, deltas never go negative */
+  pthread_mutex_lock(&(capture->lock));
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  now = (unsigned long long) ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+  if (0ULL == capture->last)
+  {
+    capture->last = now;
+  }
+  used = Capture_Put(header, now - capture->last);
+  used += Capture_Put(header + used,
+      ((unsigned long long) connection << 2) | kind);
+  if (HTTP_CAPTURE_INPUT == kind)
+  {
+    used += Capture_Put(header + used, length);
+  }
+  capture->last = now;
+  fwrite(header, 1U, used, capture->file);
+  if (0U < length)
+  {
+    fwrite(data, 1U, length, capture->file);
+  }
+  pthread_mutex_unlock(&(capture->lock));
+}
+
+static unsigned int Capture_Put(
+    unsigned char *out,
+    unsigned long long value)
+{
+  unsigned int used = 0U;
+
+  while (0x80ULL <= value)
+  {
+    out[used++] = (unsigned char) (value | 0x80ULL);
+    value >>= 7;
+  }
+  out[used++] = (unsigned char) value;
+
+  return used;
+}
+
+static int Capture_Get(
+    const char *capture,
+    unsigned long length,
+    unsigned long *offset,
+    unsigned long long *value)
+{
+  unsigned int shift = 0U;
+
+  *value = 0ULL;
+  while (*offset < length && 64U > shift)
+  {
+    unsigned char byte = (unsigned char) capture[(*offset)++];
+
+    *value |= (unsigned long long) (byte & 0x7FU) << shift;
+    if (0U == (byte & 0x80U))
+    {
+      return 0;
+    }
+    shift += 7U;
+  }
+
+  return -1;
+}
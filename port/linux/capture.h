@@ -0,0 +1,125 @@
+/*
+ capture.h
+
+ MIT License
+
+ Copyright (c) 2026 uChttpserver contributors
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+  Created on: Oct 18, 2026
+      Author: uChttpserver contributors
+ */
+
+#ifndef CAPTURE_H_
+#define CAPTURE_H_
+
+/*****************************************************************************/
+/* Includes                                                                  */
+/*****************************************************************************/
+
+#include <pthread.h>
+#include <stdio.h>
+
+/*****************************************************************************/
+/* Type definitions                                                          */
+/*****************************************************************************/
+
+/* File starts with "uCHc" and a version byte, then records of unsigned
+ * LEB128 fields: microseconds since the previous record, connection id
+ * shifted left by 2 with the kind below in the low bits and, for input
+ * only, length followed by the bytes themselves */
+typedef enum HttpCaptureKind
+{
+  HTTP_CAPTURE_OPEN = 0,
+  HTTP_CAPTURE_INPUT = 1,        /* Bytes consumed by one Http_Input */
+  HTTP_CAPTURE_CLOSE = 2
+} tHttpCaptureKind;
+
+typedef struct HttpCapture
+{
+  FILE *file;
+  pthread_mutex_t lock;          /* Event loops of all workers write */
+  unsigned long long last;       /* Time of the previous record (us) */
+  unsigned long connections;     /* Next connection id */
+} tHttpCapture;
+
+typedef struct HttpCaptureRecord
+{
+  unsigned long long time;       /* Microseconds since the first record */
+  unsigned long connection;
+  tHttpCaptureKind kind;
+  unsigned int length;
+  const char *data;              /* Points into the read buffer */
+} tHttpCaptureRecord;
+
+/*****************************************************************************/
+/* Capture API                                                               */
+/* - a diagnostic mode, records are serialised on one lock                   */
+/*****************************************************************************/
+
+/**
+ * \brief Create capture file, replacing an existing one
+ * \return 0 or -1 with errno set
+ */
+int HttpCapture_Open(
+    tHttpCapture *const capture,
+    const char *path);
+
+/**
+ * \brief Record accepted connection
+ * \return its id, unique within the capture
+ */
+unsigned long HttpCapture_Connection(
+    tHttpCapture *const capture);
+
+/**
+ * \brief Record bytes consumed by Http_Input of the connection
+ */
+void HttpCapture_Input(
+    tHttpCapture *const capture,
+    unsigned long connection,
+    const char *data,
+    unsigned int length);
+
+/**
+ * \brief Record released connection
+ */
+void HttpCapture_Closed(
+    tHttpCapture *const capture,
+    unsigned long connection);
+
+/**
+ * \brief Flush and close capture file
+ */
+void HttpCapture_Close(
+    tHttpCapture *const capture);
+
+/**
+ * \brief Decode next record of a capture loaded into memory
+ * Offset starts at 0 and time at 0 too, both are advanced
+ * \return 1 on record, 0 at the end, -1 on malformed or unknown input
+ */
+int HttpCapture_Next(
+    const char *capture,
+    unsigned long length,
+    unsigned long *offset,
+    tHttpCaptureRecord *record);
+
+#endif /* CAPTURE_H_ */
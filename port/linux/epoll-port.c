@@ -0,0 +1,1331 @@
+/*
+ epoll-port.c
+
+ MIT License
+
+ Copyright (c) 2026 uChttpserver contributors
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+  Created on: Oct 18, 2026
+      Author: uChttpserver contributors
+ */
+
+/*****************************************************************************/
+/* Includes                                                                  */
+/*****************************************************************************/
+
+#define _GNU_SOURCE
+
+#include "epoll-port.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+
+/*****************************************************************************/
+/* Constants                                                                 */
+/*****************************************************************************/
+
+/* Rendered once, expiry must not depend on the state of the parser */
+static const char requestTimeout[] = "HTTP/1.1 408 Request Timeout\r\n"
+    "Content-Length: 0\r\nConnection: close\r\n\r\n";
+
+/*****************************************************************************/
+/* Local functions (declarations)                                            */
+/*****************************************************************************/
+
+static unsigned int EpollPort_Send(
+    void *const conn,
+    const char *data,
+    unsigned int length);
+static void EpollPort_Error(
+    void *const conn,
+    const tErrorInfo *errorInfo);
+#if HTTP_ADMISSION_CONTROL
+static unsigned char EpollPort_Admit(
+    void *const conn,
+    const tResourceEntry *resource);
+#endif
+#if HTTP_DEFERRED_RESOURCES
+static unsigned char EpollPort_Defer(
+    void *const conn,
+    const tResourceEntry *resource);
+#endif
+
+static void EpollPort_Accept(
+    tHttpEpollServer *const server);
+static unsigned long EpollPort_PeerKey(
+    const struct sockaddr_storage *address);
+static void EpollPort_Ready(
+    tHttpEpollConnection *const c);
+static void EpollPort_Schedule(
+    tHttpEpollServer *const server);
+static void EpollPort_Serve(
+    tHttpEpollConnection *const c);
+#if HTTP_DEFERRED_RESOURCES
+static void EpollPort_Offloaded(
+    void *arg);
+static void EpollPort_Resume(
+    tHttpEpollServer *const server);
+#endif
+static void EpollPort_Deadline(
+    tHttpEpollConnection *const c);
+static void EpollPort_Expired(
+    tHttpTimer *timer);
+static void EpollPort_Evict(
+    tHttpEpollConnection *const c);
+static int EpollPort_EvictSlowest(
+    tHttpEpollServer *const server);
+static unsigned long EpollPort_Now(
+    void);
+static unsigned int EpollPort_Pending(
+    const tHttpEpollConnection *const c);
+static int EpollPort_Spill(
+    tHttpEpollConnection *const c,
+    const char *data,
+    unsigned int length);
+static int EpollPort_Drain(
+    tHttpEpollConnection *const c);
+static void EpollPort_Release(
+    tHttpEpollConnection *const c);
+static void EpollPort_Recycle(
+    tHttpEpollServer *const server);
+
+/*****************************************************************************/
+/* Global functions                                                          */
+/*****************************************************************************/
+
+int HttpEpoll_Initialize(
+    tHttpEpollServer *const server,
+    int listenFd,
+    tHttpEpollConnection *pool,
+    unsigned int poolLength,
+    const tResourceEntry (*resources)[],
+    unsigned int reslen)
+{
+  struct epoll_event ev;
+  unsigned int i;
+
+  server->listenFd = listenFd;
+  server->pool = pool;
+  server->poolLength = poolLength;
+  server->active = 0U;
+  server->resources = resources;
+  server->resourcesLength = reslen;
+  server->releaseList = NULL;
+  server->freeList = NULL;
+  for (i = 0U; i < HTTP_EPOLL_PRIORITIES; i++)
+  {
+    server->readyHead[i] = NULL;
+    server->readyTail[i] = NULL;
+  }
+  server->running = 1;
+  HttpTimer_InitializeWheel(&(server->wheel), EpollPort_Now());
+  server->policy.window = HTTP_EPOLL_PROGRESS_WINDOW / HTTP_EPOLL_TICK;
+  server->policy.minBytes = HTTP_EPOLL_PROGRESS_MIN_BYTES;
+  server->policy.headTime = HTTP_EPOLL_HEADER_TIMEOUT / HTTP_EPOLL_TICK;
+#if HTTP_ADMISSION_CONTROL
+  server->admitRate.tokens = 0UL;
+  server->clientRate.tokens = 0UL;
+  server->clients = NULL;
+  server->clientsLength = 0U;
+#endif
+#if HTTP_PROFILING
+  server->profile = NULL;
+#endif
+#if HTTP_TRACING
+  server->trace = NULL;
+#endif
+#if HTTP_METRICS
+  server->metrics = NULL;
+#endif
+#if HTTP_LATENCY_HISTOGRAMS
+  server->latencies = NULL;
+#endif
+#if HTTP_EPOLL_CAPTURE
+  server->capture = NULL;
+#endif
+#if HTTP_DEFERRED_RESOURCES
+  server->executor = NULL;
+  server->completed = NULL;
+  pthread_mutex_init(&(server->completedLock), NULL);
+#endif
+
+  for (i = poolLength; i > 0U; i--)
+  {
+    pool[i - 1U].fd = -1;
+    pool[i - 1U].server = server;
+    pool[i - 1U].spill = NULL;
+    /* Cleared when popped only, a released slot may stay queued */
+    pool[i - 1U].ready = 0U;
+    HttpTimer_Initialize(&(pool[i - 1U].timer), &EpollPort_Expired,
+        &(pool[i - 1U]));
+    pool[i - 1U].next = server->freeList;
+    server->freeList = &(pool[i - 1U]);
+  }
+
+  server->epollFd = epoll_create1(EPOLL_CLOEXEC);
+  if (0 > server->epollFd)
+  {
+    return -1;
+  }
+  server->wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+  /* Listener is level-triggered, pending connections are never lost */
+  ev.events = EPOLLIN;
+  ev.data.ptr = NULL;
+  if (0 > server->wakeFd ||
+      0 > epoll_ctl(server->epollFd, EPOLL_CTL_ADD, listenFd, &ev))
+  {
+    int error = errno;
+
+    close(server->wakeFd);
+    close(server->epollFd);
+    errno = error;
+    return -1;
+  }
+
+  /* Wakes the loop from other threads, server itself marks it */
+  ev.data.ptr = server;
+  if (0 > epoll_ctl(server->epollFd, EPOLL_CTL_ADD, server->wakeFd, &ev))
+  {
+    int error = errno;
+
+    close(server->wakeFd);
+    close(server->epollFd);
+    errno = error;
+    return -1;
+  }
+
+  return 0;
+}
+
+#if HTTP_DEFERRED_RESOURCES
+void HttpEpoll_SetExecutor(
+    tHttpEpollServer *const server,
+    tHttpExecutor *executor)
+{
+  server->executor = executor;
+}
+#endif
+
+#if HTTP_PROFILING
+void HttpEpoll_SetProfile(
+    tHttpEpollServer *const server,
+    tHttpProfile *profile)
+{
+  server->profile = profile;
+}
+#endif
+
+#if HTTP_TRACING
+void HttpEpoll_SetTrace(
+    tHttpEpollServer *const server,
+    tHttpTrace *trace)
+{
+  server->trace = trace;
+}
+#endif
+
+#if HTTP_METRICS
+void HttpEpoll_SetMetrics(
+    tHttpEpollServer *const server,
+    tHttpMetrics *metrics)
+{
+  server->metrics = metrics;
+}
+#endif
+
+#if HTTP_LATENCY_HISTOGRAMS
+void HttpEpoll_SetLatencies(
+    tHttpEpollServer *const server,
+    tHttpLatencies *latencies)
+{
+  server->latencies = latencies;
+}
+#endif
+
+#if HTTP_EPOLL_CAPTURE
+void HttpEpoll_SetCapture(
+    tHttpEpollServer *const server,
+    tHttpCapture *capture)
+{
+  server->capture = capture;
+}
+#endif
+
+void HttpEpoll_SetProgressPolicy(
+    tHttpEpollServer *const server,
+    const tHttpProgressPolicy *policy)
+{
+  server->policy = *policy;
+}
+
+#if HTTP_ADMISSION_CONTROL
+void HttpEpoll_SetAdmission(
+    tHttpEpollServer *const server,
+    const tHttpTokenRate *rate,
+    const tHttpTokenRate *clientRate,
+    tHttpTokenBucket *clients,
+    unsigned int clientsLength)
+{
+  server->admitRate.tokens = 0UL;
+  if (NULL != rate)
+  {
+    server->admitRate = *rate;
+    HttpTokenBucket_Initialize(&(server->admitBucket), rate,
+        server->wheel.now);
+  }
+  server->clientRate.tokens = 0UL;
+  server->clients = NULL;
+  server->clientsLength = 0U;
+  if (NULL != clientRate && NULL != clients && 0U < clientsLength)
+  {
+    unsigned int i;
+
+    server->clientRate = *clientRate;
+    server->clients = clients;
+    server->clientsLength = clientsLength;
+    for (i = 0U; i < clientsLength; i++)
+    {
+      HttpTokenBucket_Initialize(&(clients[i]), clientRate,
+          server->wheel.now);
+    }
+  }
+}
+#endif
+
+int HttpEpoll_Poll(
+    tHttpEpollServer *const server,
+    int timeout)
+{
+  struct epoll_event events[HTTP_EPOLL_EVENTS];
+  int count;
+  int i;
+
+  i = 0;
+  while (HTTP_EPOLL_PRIORITIES > i && NULL == server->readyHead[i])
+  {
+    ++i;
+  }
+  if (HTTP_EPOLL_PRIORITIES > i)
+  {
+    /* Input left over from previous turn must not wait for new events */
+    timeout = 0;
+  }
+  else if (0U < server->active &&
+      (0 > timeout || HTTP_EPOLL_TICK < timeout))
+  {
+    /* Deadlines are checked once per tick */
+    timeout = HTTP_EPOLL_TICK;
+  }
+  count = epoll_wait(server->epollFd, events, HTTP_EPOLL_EVENTS, timeout);
+
+  /* Before events - deadlines set below count from the current tick */
+  HttpTimer_Advance(&(server->wheel), EpollPort_Now());
+
+  for (i = 0; i < count; i++)
+  {
+    tHttpEpollConnection *c = events[i].data.ptr;
+
+    if (NULL == c)
+    {
+      EpollPort_Accept(server);
+      continue;
+    }
+    if ((void *) server == (void *) c)
+    {
+      eventfd_t value;
+
+      eventfd_read(server->wakeFd, &value);
+#if HTTP_DEFERRED_RESOURCES
+      EpollPort_Resume(server);
+#endif
+      continue;
+    }
+    if (0 > c->fd)
+    {
+      /* Released earlier in this batch */
+      continue;
+    }
+#if HTTP_DEFERRED_RESOURCES
+    if (c->deferred)
+    {
+      /* Socket is drained when executor returns the connection */
+      continue;
+    }
+#endif
+
+    if (events[i].events & (EPOLLERR | EPOLLHUP))
+    {
+      EpollPort_Release(c);
+      continue;
+    }
+    if ((events[i].events & EPOLLOUT) && EpollPort_Pending(c))
+    {
+      if (0 > EpollPort_Drain(c))
+      {
+        EpollPort_Release(c);
+        continue;
+      }
+      if (EpollPort_Pending(c))
+      {
+        /* Peer takes output - its deadline moves on */
+        EpollPort_Deadline(c);
+      }
+#if HTTP_RESOURCE_CONTINUATION
+      else if (0U == c->closing && (c->rxHead != c->rxTail ||
+          c->readable || Http_HasContinuation(&(c->state))))
+#else
+      else if (0U == c->closing && (c->rxHead != c->rxTail || c->readable))
+#endif
+      {
+        /* Output drained - suspended input or next slice is due */
+        EpollPort_Ready(c);
+      }
+    }
+    if (events[i].events & (EPOLLIN | EPOLLRDHUP))
+    {
+      /* Served in turn with other connections */
+      c->readable = 1U;
+      EpollPort_Ready(c);
+    }
+    else if (c->closing && 0U == EpollPort_Pending(c))
+    {
+      EpollPort_Release(c);
+    }
+  }
+
+  EpollPort_Schedule(server);
+  EpollPort_Recycle(server);
+
+  return count;
+}
+
+void HttpEpoll_Run(
+    tHttpEpollServer *const server)
+{
+  while (server->running)
+  {
+    if (0 > HttpEpoll_Poll(server, -1) && EINTR != errno)
+    {
+      break;
+    }
+  }
+}
+
+void HttpEpoll_Stop(
+    tHttpEpollServer *const server)
+{
+  server->running = 0;
+  eventfd_write(server->wakeFd, 1U);
+}
+
+void HttpEpoll_Close(
+    tHttpEpollServer *const server)
+{
+  unsigned int i;
+
+  for (i = 0U; i < server->poolLength; i++)
+  {
+    if (0 <= server->pool[i].fd)
+    {
+      EpollPort_Release(&(server->pool[i]));
+    }
+  }
+  EpollPort_Recycle(server);
+  for (i = 0U; i < HTTP_EPOLL_PRIORITIES; i++)
+  {
+    server->readyHead[i] = NULL;
+    server->readyTail[i] = NULL;
+  }
+  close(server->wakeFd);
+  close(server->epollFd);
+  close(server->listenFd);
+#if HTTP_DEFERRED_RESOURCES
+  pthread_mutex_destroy(&(server->completedLock));
+#endif
+}
+
+/*****************************************************************************/
+/* Port callbacks                                                            */
+/*****************************************************************************/
+
+static unsigned int EpollPort_Send(
+    void *const conn,
+    const char *data,
+    unsigned int length)
+{
+  tHttpEpollConnection *const c = Http_HelperGetContext(conn);
+  unsigned int left = length;
+
+  if (c->closing > 1U)
+  {
+    /* Peer is gone - output is dropped */
+    return length;
+  }
+
+  /* Bypass pending output when nothing is queued */
+  if (0U == EpollPort_Pending(c))
+  {
+    ssize_t written = send(c->fd, data, left, MSG_NOSIGNAL);
+
+    if (0 < written)
+    {
+      data += written;
+      left -= (unsigned int) written;
+    }
+    else if (0 > written && EAGAIN != errno && EWOULDBLOCK != errno)
+    {
+      c->closing = 2U;
+      return length;
+    }
+  }
+
+  /* Once spilled, output stays behind the spill to keep its order */
+  if (0U < left && c->spillHead == c->spillTail)
+  {
+    unsigned int room;
+
+    if (HTTP_EPOLL_TX_LENGTH - c->txTail < left && 0U < c->txHead)
+    {
+      memmove(c->txBuffer, c->txBuffer + c->txHead, c->txTail - c->txHead);
+      c->txTail -= c->txHead;
+      c->txHead = 0U;
+    }
+
+    room = HTTP_EPOLL_TX_LENGTH - c->txTail;
+    if (room > left)
+    {
+      room = left;
+    }
+    memcpy(c->txBuffer + c->txTail, data, room);
+    c->txTail += room;
+    data += room;
+    left -= room;
+  }
+
+  /* Handler produces faster than peer reads - never wait for the socket,
+   * input of the connection is suspended until EPOLLOUT drains it */
+  if (0U < left && 0 > EpollPort_Spill(c, data, left))
+  {
+    c->closing = 2U;
+  }
+
+  return length;
+}
+
+static void EpollPort_Error(
+    void *const conn,
+    const tErrorInfo *errorInfo)
+{
+  tHttpEpollConnection *const c = Http_HelperGetContext(conn);
+
+  Http_HelperSetResponseStatus(conn, errorInfo->status);
+  Http_HelperSetResponseHeader(conn, "Content-Length", "0");
+  Http_HelperSetResponseHeader(conn, "Connection", "close");
+  Http_HelperSend(conn, "\r\n", 2);
+  Http_HelperFlush(conn);
+
+  /* Rest of the stream cannot be trusted */
+  if (0U == c->closing)
+  {
+    c->closing = 1U;
+  }
+}
+
+#if HTTP_ADMISSION_CONTROL
+static unsigned char EpollPort_Admit(
+    void *const conn,
+    const tResourceEntry *resource)
+{
+  tHttpEpollConnection *const c = Http_HelperGetContext(conn);
+  tHttpEpollServer *const server = c->server;
+
+  /* Client first, a flooding client must not drain the shared bucket */
+  if ((NULL == server->clients ||
+          1U == HttpTokenBucket_TakeKeyed(server->clients,
+              server->clientsLength, &(server->clientRate), c->peer,
+              server->wheel.now)) &&
+      1U == HttpTokenBucket_Take(&(server->admitBucket), &(server->admitRate),
+          server->wheel.now))
+  {
+    return 1U;
+  }
+
+  /* Core sends 503 and discards the rest of the stream */
+  c->closing = 1U;
+  return 0U;
+}
+#endif
+
+#if HTTP_DEFERRED_RESOURCES
+static unsigned char EpollPort_Defer(
+    void *const conn,
+    const tResourceEntry *resource)
+{
+  tHttpEpollConnection *const c = Http_HelperGetContext(conn);
+
+  if (NULL == c->server->executor ||
+      0U == (resource->flags & HTTP_RESOURCE_OFFLOAD))
+  {
+    return 0U;
+  }
+
+  /* Submitted when Http_Input returns */
+  c->deferred = 1U;
+  return 1U;
+}
+#endif
+
+/*****************************************************************************/
+/* Local functions (definitions)                                             */
+/*****************************************************************************/
+
+static void EpollPort_Accept(
+    tHttpEpollServer *const server)
+{
+  unsigned int accepted = 0U;
+
+  for (;;)
+  {
+    tHttpEpollConnection *c;
+    struct epoll_event ev;
+    struct sockaddr_storage address;
+    socklen_t addressLength = sizeof(address);
+    int enable = 1;
+    int fd;
+
+    if (NULL == server->freeList &&
+        (0U < accepted || 0 == EpollPort_EvictSlowest(server)))
+    {
+      /* Slot of the slowest or idlest client is free after this batch,
+       * listener is level-triggered so the pending connection is accepted
+       * then; once this call took one, another may not be pending at all
+       * and the next readiness decides */
+      break;
+    }
+
+    fd = accept4(server->listenFd, (struct sockaddr *) &address,
+        &addressLength, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+    if (0 > fd)
+    {
+      /* EAGAIN or transient error (e.g. ECONNABORTED, EMFILE) */
+      break;
+    }
+    if (NULL == server->freeList)
+    {
+      /* Pool exhausted - shed the connection instead of spinning */
+      close(fd);
+      continue;
+    }
+
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+    c = server->freeList;
+    server->freeList = c->next;
+    c->next = NULL;
+    c->fd = fd;
+    c->closing = 0U;
+    c->priority = HTTP_PRIORITY_DEFAULT;
+    c->readable = 0U;
+    c->rxHead = 0U;
+    c->rxTail = 0U;
+    c->txHead = 0U;
+    c->txTail = 0U;
+    c->spillHead = 0U;
+    c->spillTail = 0U;
+    c->spillLength = 0U;
+    c->peer = EpollPort_PeerKey(&address);
+    c->phase = HTTP_PHASE_IDLE;
+    HttpProgress_Initialize(&(c->progress), server->wheel.now);
+    HttpTimer_Schedule(&(server->wheel), &(c->timer),
+        HTTP_EPOLL_IDLE_TIMEOUT / HTTP_EPOLL_TICK);
+    Http_InitializeConnection(&(c->state), &EpollPort_Send,
+        &EpollPort_Error, server->resources, server->resourcesLength, c);
+#if HTTP_DEFERRED_RESOURCES
+    c->deferred = 0U;
+    Http_SetDeferCallback(&(c->state), &EpollPort_Defer);
+#endif
+#if HTTP_ADMISSION_CONTROL
+    Http_SetAdmitCallback(&(c->state), &EpollPort_Admit);
+#endif
+#if HTTP_PROFILING
+    Http_SetProfile(&(c->state), server->profile);
+#endif
+#if HTTP_TRACING
+    Http_SetTrace(&(c->state), server->trace,
+        (unsigned short) (c - server->pool));
+#endif
+#if HTTP_METRICS
+    Http_SetMetrics(&(c->state), server->metrics);
+#endif
+#if HTTP_LATENCY_HISTOGRAMS
+    Http_SetLatencies(&(c->state), server->latencies);
+#endif
+
+    ev.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+    ev.data.ptr = c;
+    if (0 > epoll_ctl(server->epollFd, EPOLL_CTL_ADD, fd, &ev))
+    {
+      HttpTimer_Cancel(&(c->timer));
+      close(fd);
+      c->fd = -1;
+      c->next = server->freeList;
+      server->freeList = c;
+      continue;
+    }
+    ++(server->active);
+    ++accepted;
+#if HTTP_METRICS
+    if (NULL != server->metrics)
+    {
+      ++(server->metrics->connections);
+    }
+#endif
+#if HTTP_EPOLL_CAPTURE
+    if (NULL != server->capture)
+    {
+      c->captured = HttpCapture_Connection(server->capture);
+    }
+#endif
+  }
+}
+
+static unsigned long EpollPort_PeerKey(
+    const struct sockaddr_storage *address)
+{
+  unsigned long key = 0UL;
+
+  if (AF_INET == address->ss_family)
+  {
+    key = ((const struct sockaddr_in *) address)->sin_addr.s_addr;
+  }
+  else if (AF_INET6 == address->ss_family)
+  {
+    const unsigned char *bytes =
+        ((const struct sockaddr_in6 *) address)->sin6_addr.s6_addr;
+    unsigned int i;
+
+    /* /64 prefix - one client usually owns the whole of it */
+    for (i = 0U; i < 8U; i++)
+    {
+      key = key * 31UL + bytes[i];
+    }
+  }
+
+  return key;
+}
+
+static void EpollPort_Ready(
+    tHttpEpollConnection *const c)
+{
+  tHttpEpollServer *const server = c->server;
+  const unsigned char priority = c->priority;
+
+  if (c->ready)
+  {
+    return;
+  }
+  c->ready = 1U;
+  c->readyNext = NULL;
+  if (NULL == server->readyTail[priority])
+  {
+    server->readyHead[priority] = c;
+  }
+  else
+  {
+    server->readyTail[priority]->readyNext = c;
+  }
+  server->readyTail[priority] = c;
+}
+
+static void EpollPort_Schedule(
+    tHttpEpollServer *const server)
+{
+  unsigned int turns = HTTP_EPOLL_LOW_TURNS;
+  unsigned int priority;
+
+  for (priority = 0U; priority < HTTP_EPOLL_PRIORITIES; priority++)
+  {
+    /* Connections queued again during this pass wait for the next one */
+    tHttpEpollConnection *const last = server->readyTail[priority];
+
+    while (NULL != server->readyHead[priority])
+    {
+      tHttpEpollConnection *const c = server->readyHead[priority];
+
+      server->readyHead[priority] = c->readyNext;
+      if (NULL == server->readyHead[priority])
+      {
+        server->readyTail[priority] = NULL;
+      }
+      c->ready = 0U;
+
+      if (0 <= c->fd)
+      {
+        EpollPort_Serve(c);
+      }
+      if (last == c)
+      {
+        break;
+      }
+      if (0U < priority && 0U == --turns)
+      {
+        /* Bulk work is time-sliced, urgent requests are not kept waiting */
+        return;
+      }
+    }
+  }
+}
+
+static void EpollPort_Serve(
+    tHttpEpollConnection *const c)
+{
+  unsigned int requests = HTTP_EPOLL_REQUEST_BUDGET;
+  unsigned int bytes = HTTP_EPOLL_BYTE_BUDGET;
+  const tResourceEntry *resource;
+
+  while (0U == c->closing && 0U == Http_ShouldClose(&(c->state)) &&
+      0U < requests && 0U < bytes)
+  {
+    unsigned int length;
+    unsigned int answered;
+
+    if (EpollPort_Pending(c))
+    {
+      /* Parsing resumes (or next slice follows) once EPOLLOUT drained
+       * the output of the previous response */
+      break;
+    }
+
+#if HTTP_RESOURCE_CONTINUATION
+    if (Http_HasContinuation(&(c->state)))
+    {
+#if HTTP_DEFERRED_RESOURCES
+      if (NULL != c->server->executor &&
+          (Http_HelperGetResource(&(c->state))->flags &
+              HTTP_RESOURCE_OFFLOAD))
+      {
+        HttpTimer_Cancel(&(c->timer));
+        c->deferred = 1U;
+        if (0 == HttpExecutor_Submit(c->server->executor,
+            &EpollPort_Offloaded, c))
+        {
+          return;
+        }
+        c->deferred = 0U;
+      }
+#endif
+      if (0U == Http_Continue(&(c->state)))
+      {
+        /* Response complete, pipelined input is parsed again */
+        continue;
+      }
+      /* One slice per turn - other connections go first */
+      break;
+    }
+#endif
+
+    if (c->rxHead == c->rxTail)
+    {
+      ssize_t received;
+
+      if (0U == c->readable)
+      {
+        /* Waits for next edge */
+        break;
+      }
+      c->rxHead = 0U;
+      c->rxTail = 0U;
+      received = recv(c->fd, c->rxBuffer, sizeof(c->rxBuffer), 0);
+      if (0 < received)
+      {
+        c->rxTail = (unsigned int) received;
+      }
+      else if (0 == received)
+      {
+        /* Peer finished sending, pending output is still delivered */
+        c->closing = 1U;
+      }
+      else if (EAGAIN == errno || EWOULDBLOCK == errno)
+      {
+        c->readable = 0U;
+      }
+      else if (EINTR != errno)
+      {
+        c->closing = 2U;
+      }
+      continue;
+    }
+
+    length = c->rxTail - c->rxHead;
+    if (length > bytes)
+    {
+      length = bytes;
+    }
+    answered = requests;
+    length = Http_InputBudget(&(c->state), c->rxBuffer + c->rxHead, length,
+        &requests);
+#if HTTP_EPOLL_CAPTURE
+    if (NULL != c->server->capture && 0U < length)
+    {
+      HttpCapture_Input(c->server->capture, c->captured,
+          c->rxBuffer + c->rxHead, length);
+    }
+#endif
+    c->rxHead += length;
+    bytes -= length;
+
+    if (answered != requests)
+    {
+      HttpProgress_Initialize(&(c->progress), c->server->wheel.now);
+    }
+    if (HTTP_PROGRESS_OK != HttpProgress_Update(&(c->progress),
+        &(c->server->policy), &(c->state), length, c->server->wheel.now))
+    {
+      EpollPort_Evict(c);
+      return;
+    }
+
+#if HTTP_DEFERRED_RESOURCES
+    if (c->deferred)
+    {
+      /* Executor thread owns the connection, no expiry in the meantime */
+      HttpTimer_Cancel(&(c->timer));
+      c->phase = HTTP_PHASE_RESPONSE;
+
+      /* Pipelined input stays in rxBuffer until the response is sent */
+      if (0 == HttpExecutor_Submit(c->server->executor,
+          &EpollPort_Offloaded, c))
+      {
+        /* Connection belongs to executor now */
+        return;
+      }
+
+      /* Executor saturated - run it here rather than reject the request */
+      Http_RunDeferred(&(c->state));
+      c->deferred = 0U;
+      --requests;
+    }
+#endif
+  }
+
+  if (HTTP_EPOLL_REQUEST_BUDGET > requests)
+  {
+    /* Request answered - next one starts its own clock */
+    c->phase = HTTP_PHASE_RESPONSE;
+  }
+#if HTTP_RESOURCE_CONTINUATION
+  if (HTTP_EPOLL_BYTE_BUDGET > bytes || EpollPort_Pending(c) ||
+      Http_HasContinuation(&(c->state)))
+#else
+  if (HTTP_EPOLL_BYTE_BUDGET > bytes || EpollPort_Pending(c))
+#endif
+  {
+    EpollPort_Deadline(c);
+  }
+
+  /* Requests without a known resource yet stay in the first class */
+  resource = Http_HelperGetResource(&(c->state));
+  c->priority = HTTP_PRIORITY_DEFAULT;
+  if (NULL != resource)
+  {
+    c->priority = (HTTP_EPOLL_PRIORITIES > resource->priority) ?
+        resource->priority : (HTTP_EPOLL_PRIORITIES - 1U);
+  }
+
+  if (0U == c->closing && 1U == Http_ShouldClose(&(c->state)))
+  {
+    /* Response said close, pending output is still delivered */
+    c->closing = 1U;
+  }
+  if (1U < c->closing)
+  {
+    EpollPort_Release(c);
+  }
+#if HTTP_RESOURCE_CONTINUATION
+  else if (0U == c->closing && Http_HasContinuation(&(c->state)))
+  {
+    if (0U == EpollPort_Pending(c))
+    {
+      /* Socket took the whole slice - next one in turn with others */
+      EpollPort_Ready(c);
+    }
+  }
+#endif
+  else if (0U == c->closing)
+  {
+    if (0U == EpollPort_Pending(c) && (c->rxHead != c->rxTail || c->readable))
+    {
+      /* Budget spent - rest waits behind other ready connections */
+      EpollPort_Ready(c);
+    }
+  }
+  else if (0U == EpollPort_Pending(c))
+  {
+    EpollPort_Release(c);
+  }
+}
+
+#if HTTP_DEFERRED_RESOURCES
+static void EpollPort_Offloaded(
+    void *arg)
+{
+  tHttpEpollConnection *const c = arg;
+  tHttpEpollServer *const server = c->server;
+
+  /* Executor thread - response goes through the usual send callback */
+  Http_RunDeferred(&(c->state));
+
+  pthread_mutex_lock(&(server->completedLock));
+  c->next = server->completed;
+  server->completed = c;
+  pthread_mutex_unlock(&(server->completedLock));
+  eventfd_write(server->wakeFd, 1U);
+}
+
+static void EpollPort_Resume(
+    tHttpEpollServer *const server)
+{
+  tHttpEpollConnection *c;
+
+  pthread_mutex_lock(&(server->completedLock));
+  c = server->completed;
+  server->completed = NULL;
+  pthread_mutex_unlock(&(server->completedLock));
+
+  while (NULL != c)
+  {
+    tHttpEpollConnection *const next = c->next;
+
+    c->next = NULL;
+    c->deferred = 0U;
+    if (0 > EpollPort_Drain(c))
+    {
+      c->closing = 2U;
+    }
+    EpollPort_Deadline(c);
+    /* Edges that arrived while deferred were skipped */
+    c->readable = 1U;
+    EpollPort_Ready(c);
+    c = next;
+  }
+}
+#endif
+
+static void EpollPort_Deadline(
+    tHttpEpollConnection *const c)
+{
+  tHttpPhase phase = Http_HelperGetPhase(&(c->state));
+  unsigned long timeout;
+
+  switch (phase)
+  {
+    case HTTP_PHASE_IDLE:
+      /* Reached only after a response */
+      timeout = HTTP_EPOLL_IDLE_TIMEOUT;
+      break;
+    case HTTP_PHASE_REQUEST_LINE:
+    case HTTP_PHASE_HEADERS:
+      if (HTTP_PHASE_REQUEST_LINE == c->phase ||
+          HTTP_PHASE_HEADERS == c->phase)
+      {
+        /* Whole request head shares one deadline - slow senders lose */
+        return;
+      }
+      timeout = HTTP_EPOLL_HEADER_TIMEOUT;
+      break;
+    case HTTP_PHASE_BODY:
+      /* Any progress rearms it */
+      timeout = HTTP_EPOLL_BODY_TIMEOUT;
+      break;
+    default:
+#if HTTP_RESOURCE_CONTINUATION
+      if (EpollPort_Pending(c) || Http_HasContinuation(&(c->state)))
+#else
+      if (EpollPort_Pending(c))
+#endif
+      {
+        /* Peer must take each part of a long response in time */
+        timeout = HTTP_EPOLL_SEND_TIMEOUT;
+        break;
+      }
+      HttpTimer_Cancel(&(c->timer));
+      c->phase = phase;
+      return;
+  }
+
+  c->phase = phase;
+  HttpTimer_Schedule(&(c->server->wheel), &(c->timer),
+      timeout / HTTP_EPOLL_TICK);
+}
+
+static void EpollPort_Expired(
+    tHttpTimer *timer)
+{
+  tHttpEpollConnection *const c = timer->context;
+
+  if (HTTP_PHASE_IDLE == c->phase)
+  {
+    EpollPort_Release(c);
+  }
+  else
+  {
+    EpollPort_Evict(c);
+  }
+}
+
+static void EpollPort_Evict(
+    tHttpEpollConnection *const c)
+{
+  if (0U == c->closing && 0U == EpollPort_Pending(c) &&
+      HTTP_PHASE_RESPONSE != c->phase)
+  {
+    /* Best effort, connection is closed regardless */
+    send(c->fd, requestTimeout, sizeof(requestTimeout) - 1U,
+        MSG_NOSIGNAL | MSG_DONTWAIT);
+  }
+  EpollPort_Release(c);
+}
+
+static int EpollPort_EvictSlowest(
+    tHttpEpollServer *const server)
+{
+  tHttpEpollConnection *slowest = NULL;
+  tHttpEpollConnection *idlest = NULL;
+  unsigned long worst = 0UL;
+  unsigned long soonest = 0UL;
+  unsigned int i;
+
+  /* Only under pressure - linear scan is cheaper than keeping an order */
+  for (i = 0U; i < server->poolLength; i++)
+  {
+    tHttpEpollConnection *const c = &(server->pool[i]);
+    unsigned long score;
+
+#if HTTP_DEFERRED_RESOURCES
+    if (c->deferred)
+    {
+      continue;
+    }
+#endif
+    if (0 > c->fd)
+    {
+      continue;
+    }
+    if (HTTP_PHASE_IDLE == c->phase)
+    {
+      /* Idle timeout runs from the last response, the first to expire has
+       * waited longest; unsent output or pipelined input is not idle */
+      if (0U == EpollPort_Pending(c) && c->rxHead == c->rxTail &&
+          (NULL == idlest ||
+              c->timer.expires - server->wheel.now < soonest))
+      {
+        soonest = c->timer.expires - server->wheel.now;
+        idlest = c;
+      }
+      continue;
+    }
+    score = HttpProgress_Score(&(c->progress), &(server->policy),
+        server->wheel.now);
+    if (score > worst)
+    {
+      worst = score;
+      slowest = c;
+    }
+  }
+
+  if (NULL != slowest)
+  {
+    EpollPort_Evict(slowest);
+  }
+  else if (NULL != idlest)
+  {
+    /* Keep-alive wait scores 0, reclaimed like on its idle timeout */
+    EpollPort_Release(idlest);
+  }
+  else
+  {
+    return -1;
+  }
+  return 0;
+}
+
+static unsigned long EpollPort_Now(
+    void)
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (unsigned long) now.tv_sec * (1000UL / HTTP_EPOLL_TICK) +
+      (unsigned long) now.tv_nsec / (1000000UL * HTTP_EPOLL_TICK);
+}
+
+static unsigned int EpollPort_Pending(
+    const tHttpEpollConnection *const c)
+{
+  return (c->txHead != c->txTail || c->spillHead != c->spillTail) ? 1U : 0U;
+}
+
+static int EpollPort_Spill(
+    tHttpEpollConnection *const c,
+    const char *data,
+    unsigned int length)
+{
+  if (c->spillHead == c->spillTail)
+  {
+    c->spillHead = 0U;
+    c->spillTail = 0U;
+  }
+  else if (c->spillLength - c->spillTail < length && 0U < c->spillHead)
+  {
+    memmove(c->spill, c->spill + c->spillHead, c->spillTail - c->spillHead);
+    c->spillTail -= c->spillHead;
+    c->spillHead = 0U;
+  }
+
+  if (HTTP_EPOLL_SPILL_MAX - c->spillTail < length)
+  {
+    return -1;
+  }
+  if (c->spillLength - c->spillTail < length)
+  {
+    unsigned int size = (0U < c->spillLength) ? c->spillLength :
+        HTTP_EPOLL_TX_LENGTH;
+    char *grown;
+
+    while (size - c->spillTail < length)
+    {
+      size *= 2U;
+    }
+    if (HTTP_EPOLL_SPILL_MAX < size)
+    {
+      size = HTTP_EPOLL_SPILL_MAX;
+    }
+    grown = realloc(c->spill, size);
+    if (NULL == grown)
+    {
+      return -1;
+    }
+    c->spill = grown;
+    c->spillLength = size;
+  }
+
+  memcpy(c->spill + c->spillTail, data, length);
+  c->spillTail += length;
+  return 0;
+}
+
+static int EpollPort_Drain(
+    tHttpEpollConnection *const c)
+{
+  while (EpollPort_Pending(c))
+  {
+    const unsigned int spilled = (c->txHead == c->txTail) ? 1U : 0U;
+    ssize_t written = spilled ?
+        send(c->fd, c->spill + c->spillHead, c->spillTail - c->spillHead,
+            MSG_NOSIGNAL) :
+        send(c->fd, c->txBuffer + c->txHead, c->txTail - c->txHead,
+            MSG_NOSIGNAL);
+
+    if (0 < written && spilled)
+    {
+      c->spillHead += (unsigned int) written;
+    }
+    else if (0 < written)
+    {
+      c->txHead += (unsigned int) written;
+    }
+    else if (0 > written && (EAGAIN == errno || EWOULDBLOCK == errno))
+    {
+      return 0;
+    }
+    else if (0 > written && EINTR == errno)
+    {
+      continue;
+    }
+    else
+    {
+      return -1;
+    }
+  }
+
+  /* Spill is kept only while a response outgrows the socket */
+  c->txHead = 0U;
+  c->txTail = 0U;
+  free(c->spill);
+  c->spill = NULL;
+  c->spillHead = 0U;
+  c->spillTail = 0U;
+  c->spillLength = 0U;
+  return 0;
+}
+
+static void EpollPort_Release(
+    tHttpEpollConnection *const c)
+{
+  tHttpEpollServer *const server = c->server;
+
+  /* Closing removes descriptor from epoll set */
+  HttpTimer_Cancel(&(c->timer));
+  close(c->fd);
+  c->fd = -1;
+  free(c->spill);
+  c->spill = NULL;
+  --(server->active);
+#if HTTP_METRICS
+  if (NULL != server->metrics)
+  {
+    --(server->metrics->connections);
+  }
+#endif
+#if HTTP_EPOLL_CAPTURE
+  if (NULL != server->capture)
+  {
+    HttpCapture_Closed(server->capture, c->captured);
+  }
+#endif
+
+  /* Slot is reused after the batch, stale events may still point here */
+  c->next = server->releaseList;
+  server->releaseList = c;
+}
+
+static void EpollPort_Recycle(
+    tHttpEpollServer *const server)
+{
+  while (NULL != server->releaseList)
+  {
+    tHttpEpollConnection *c = server->releaseList;
+
+    server->releaseList = c->next;
+    c->next = server->freeList;
+    server->freeList = c;
+  }
+}
@@ -0,0 +1,349 @@
+/*
+ epoll-port.h
+
+ MIT License
+
+ Copyright (c) 2026 uChttpserver contributors
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+  Created on: Oct 18, 2026
+      Author: uChttpserver contributors
+ */
+
+#ifndef EPOLL_PORT_H_
+#define EPOLL_PORT_H_
+
+/*****************************************************************************/
+/* Includes                                                                  */
+/*****************************************************************************/
+
+#include "uchttpserver.h"
+#include "uchttptimer.h"
+#include "uchttpguard.h"
+#include "linux-port.h"
+#include "executor.h"
+#include "capture.h"
+
+#include <pthread.h>
+
+/*****************************************************************************/
+/* Options                                                                   */
+/*****************************************************************************/
+
+/* Pending output kept per connection when socket is not writable */
+#ifndef HTTP_EPOLL_TX_LENGTH
+#define HTTP_EPOLL_TX_LENGTH (16384)
+#endif
+
+/* Single read from socket, also input kept per connection between turns */
+#ifndef HTTP_EPOLL_RX_LENGTH
+#define HTTP_EPOLL_RX_LENGTH (4096)
+#endif
+
+/* Requests answered per connection in one turn of the ready list */
+#ifndef HTTP_EPOLL_REQUEST_BUDGET
+#define HTTP_EPOLL_REQUEST_BUDGET (4)
+#endif
+
+/* Input bytes parsed per connection in one turn of the ready list */
+#ifndef HTTP_EPOLL_BYTE_BUDGET
+#define HTTP_EPOLL_BYTE_BUDGET (HTTP_EPOLL_RX_LENGTH)
+#endif
+
+/* Ready lists, one per resource priority class - lower classes are served
+ * only after the higher ones */
+#ifndef HTTP_EPOLL_PRIORITIES
+#define HTTP_EPOLL_PRIORITIES (3)
+#endif
+
+/* Turns of lower priority classes in one loop iteration, new events of the
+ * first class are checked in between */
+#ifndef HTTP_EPOLL_LOW_TURNS
+#define HTTP_EPOLL_LOW_TURNS (8)
+#endif
+
+/* Events fetched by one epoll_wait */
+#ifndef HTTP_EPOLL_EVENTS
+#define HTTP_EPOLL_EVENTS (256)
+#endif
+
+/* Output beyond pending buffer kept on heap per connection, connection
+ * fails when a response outgrows it */
+#ifndef HTTP_EPOLL_SPILL_MAX
+#define HTTP_EPOLL_SPILL_MAX (1048576)
+#endif
+
+/* Time given to a stalled peer to take pending output (ms) */
+#ifndef HTTP_EPOLL_SEND_TIMEOUT
+#define HTTP_EPOLL_SEND_TIMEOUT (5000)
+#endif
+
+/* Timer wheel resolution (ms) */
+#ifndef HTTP_EPOLL_TICK
+#define HTTP_EPOLL_TICK (100)
+#endif
+
+/* Keep-alive connection without a started request (ms) */
+#ifndef HTTP_EPOLL_IDLE_TIMEOUT
+#define HTTP_EPOLL_IDLE_TIMEOUT (15000)
+#endif
+
+/* Request line and headers must complete within (ms), progress does not
+ * extend it */
+#ifndef HTTP_EPOLL_HEADER_TIMEOUT
+#define HTTP_EPOLL_HEADER_TIMEOUT (10000)
+#endif
+
+/* Longest pause between parts of the request body (ms) */
+#ifndef HTTP_EPOLL_BODY_TIMEOUT
+#define HTTP_EPOLL_BODY_TIMEOUT (5000)
+#endif
+
+/* Slow client policy - minimum input within a window while a request is in
+ * progress, slowest ones are also evicted first when the pool is exhausted,
+ * then the connection idle longest */
+#ifndef HTTP_EPOLL_PROGRESS_WINDOW
+#define HTTP_EPOLL_PROGRESS_WINDOW (5000)
+#endif
+
+#ifndef HTTP_EPOLL_PROGRESS_MIN_BYTES
+#define HTTP_EPOLL_PROGRESS_MIN_BYTES (128)
+#endif
+
+/* Record input of connections for capture-replay, see HttpEpoll_SetCapture */
+#ifndef HTTP_EPOLL_CAPTURE
+#define HTTP_EPOLL_CAPTURE (0)
+#endif
+
+/*****************************************************************************/
+/* Type definitions                                                          */
+/*****************************************************************************/
+
+struct HttpEpollServer;
+
+typedef struct HttpEpollConnection
+{
+  tuCHttpServerState state;
+  struct HttpEpollServer *server;
+  struct HttpEpollConnection *next;     /* Free, release or completed list */
+  struct HttpEpollConnection *readyNext;
+  tHttpTimer timer;              /* Deadline of the current phase */
+  tHttpPhase phase;
+  tHttpProgress progress;
+  unsigned long peer;            /* Client key for admission */
+  int fd;
+  unsigned char priority;        /* Ready list of the current resource */
+  unsigned char closing;         /* 1 - after pending output, 2 - now */
+  unsigned char ready;           /* Queued on ready list */
+  unsigned char readable;        /* Socket not read until it would block */
+#if HTTP_DEFERRED_RESOURCES
+  unsigned char deferred;        /* Owned by executor until completed */
+#endif
+#if HTTP_EPOLL_CAPTURE
+  unsigned long captured;        /* Connection id in the capture */
+#endif
+  unsigned int rxHead;
+  unsigned int rxTail;
+  unsigned int txHead;
+  unsigned int txTail;
+  char *spill;                   /* Output beyond txBuffer, input waits */
+  unsigned int spillHead;
+  unsigned int spillTail;
+  unsigned int spillLength;
+  char rxBuffer[HTTP_EPOLL_RX_LENGTH];
+  char txBuffer[HTTP_EPOLL_TX_LENGTH];
+} tHttpEpollConnection;
+
+typedef struct HttpEpollServer
+{
+  int epollFd;
+  int listenFd;
+  int wakeFd;
+  volatile int running;
+  tHttpEpollConnection *pool;
+  unsigned int poolLength;
+  unsigned int active;
+  tHttpEpollConnection *freeList;
+  tHttpEpollConnection *releaseList;
+  tHttpEpollConnection *readyHead[HTTP_EPOLL_PRIORITIES];  /* Round-robin */
+  tHttpEpollConnection *readyTail[HTTP_EPOLL_PRIORITIES];
+  tHttpTimerWheel wheel;
+  tHttpProgressPolicy policy;
+#if HTTP_ADMISSION_CONTROL
+  tHttpTokenRate admitRate;
+  tHttpTokenBucket admitBucket;
+  tHttpTokenRate clientRate;
+  tHttpTokenBucket *clients;
+  unsigned int clientsLength;
+#endif
+  const tResourceEntry (
+      *resources)[];
+  unsigned int resourcesLength;
+#if HTTP_PROFILING
+  tHttpProfile *profile;         /* Shared by connections of this loop */
+#endif
+#if HTTP_TRACING
+  tHttpTrace *trace;
+#endif
+#if HTTP_METRICS
+  tHttpMetrics *metrics;         /* Executor threads add atomically */
+#endif
+#if HTTP_LATENCY_HISTOGRAMS
+  tHttpLatencies *latencies;
+#endif
+#if HTTP_EPOLL_CAPTURE
+  tHttpCapture *capture;
+#endif
+#if HTTP_DEFERRED_RESOURCES
+  tHttpExecutor *executor;
+  pthread_mutex_t completedLock;
+  tHttpEpollConnection *completed;      /* Returned by executor */
+#endif
+} tHttpEpollServer;
+
+/*****************************************************************************/
+/* Linux port API                                                            */
+/*****************************************************************************/
+
+/**
+ * \brief Prepare event loop serving connections from the given pool
+ * \return 0 or -1 with errno set
+ */
+int HttpEpoll_Initialize(
+    tHttpEpollServer *const server,
+    int listenFd,
+    tHttpEpollConnection *pool,
+    unsigned int poolLength,
+    const tResourceEntry (*resources)[],
+    unsigned int reslen);
+
+#if HTTP_DEFERRED_RESOURCES
+/**
+ * \brief Run resources flagged HTTP_RESOURCE_OFFLOAD on executor threads
+ * Executor must be stopped before HttpEpoll_Close
+ */
+void HttpEpoll_SetExecutor(
+    tHttpEpollServer *const server,
+    tHttpExecutor *executor);
+#endif
+
+#if HTTP_PROFILING
+/**
+ * \brief Account connections accepted from now on in the given profile
+ * Offloaded resources update it from executor threads with atomics
+ */
+void HttpEpoll_SetProfile(
+    tHttpEpollServer *const server,
+    tHttpProfile *profile);
+#endif
+
+#if HTTP_TRACING
+/**
+ * \brief Record connections accepted from now on in the given ring, each
+ * identified by its pool slot
+ * Offloaded resources record from executor threads into the same ring
+ */
+void HttpEpoll_SetTrace(
+    tHttpEpollServer *const server,
+    tHttpTrace *trace);
+#endif
+
+#if HTTP_METRICS
+/**
+ * \brief Count connections accepted from now on in the given metrics
+ * Offloaded resources update them from executor threads with
+ * HTTP_ATOMIC_ADD, open connections are counted by this loop only
+ */
+void HttpEpoll_SetMetrics(
+    tHttpEpollServer *const server,
+    tHttpMetrics *metrics);
+#endif
+
+#if HTTP_LATENCY_HISTOGRAMS
+/**
+ * \brief Record latencies of connections accepted from now on
+ * Offloaded resources record from executor threads with HTTP_ATOMIC_ADD
+ * and HTTP_ATOMIC_CAS
+ */
+void HttpEpoll_SetLatencies(
+    tHttpEpollServer *const server,
+    tHttpLatencies *latencies);
+#endif
+
+#if HTTP_EPOLL_CAPTURE
+/**
+ * \brief Record connections accepted from now on, may be shared by loops
+ * Input is recorded as consumed by each Http_Input call, so a replay
+ * repeats the fragmentation seen by the parser
+ */
+void HttpEpoll_SetCapture(
+    tHttpEpollServer *const server,
+    tHttpCapture *capture);
+#endif
+
+/**
+ * \brief Replace slow client policy, times in HTTP_EPOLL_TICK units
+ */
+void HttpEpoll_SetProgressPolicy(
+    tHttpEpollServer *const server,
+    const tHttpProgressPolicy *policy);
+
+#if HTTP_ADMISSION_CONTROL
+/**
+ * \brief Limit requests of the whole server and of each client address
+ * Times in HTTP_EPOLL_TICK units, NULL or zero tokens disables a limit.
+ * Clients table is owned by the caller and initialized here, one slot per
+ * expected concurrent client address
+ */
+void HttpEpoll_SetAdmission(
+    tHttpEpollServer *const server,
+    const tHttpTokenRate *rate,
+    const tHttpTokenRate *clientRate,
+    tHttpTokenBucket *clients,
+    unsigned int clientsLength);
+#endif
+
+/**
+ * \brief Single event loop iteration, waits at most timeout ms
+ * \return number of processed events or -1 with errno set
+ */
+int HttpEpoll_Poll(
+    tHttpEpollServer *const server,
+    int timeout);
+
+/**
+ * \brief Run event loop until HttpEpoll_Stop
+ */
+void HttpEpoll_Run(
+    tHttpEpollServer *const server);
+
+/**
+ * \brief Request event loop exit, async-signal-safe and thread-safe
+ */
+void HttpEpoll_Stop(
+    tHttpEpollServer *const server);
+
+/**
+ * \brief Close all connections and release descriptors
+ */
+void HttpEpoll_Close(
+    tHttpEpollServer *const server);
+
+#endif /* EPOLL_PORT_H_ */
@@ -0,0 +1,309 @@
+/*
+ example-resources.c
+
+ MIT License
+
+ Copyright (c) 2026 uChttpserver contributors
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+  Created on: Oct 18, 2026
+      Author: uChttpserver contributors
+ */
+
+#include "example-resources.h"
+#if HTTP_TRACING
+#include "sharded-port.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/*****************************************************************************/
+/* Resources                                                                 */
+/*****************************************************************************/
+
+#if HTTP_RESOURCE_CONTINUATION
+static tHttpStatusCode ExportCallback(
+    void *const);
+#endif
+static tHttpStatusCode HelloCallback(
+    void *const);
+static tHttpStatusCode IndexCallback(
+    void *const);
+#if HTTP_LATENCY_HISTOGRAMS
+static tHttpStatusCode LatencyCallback(
+    void *const);
+#endif
+#if HTTP_PROFILING
+static tHttpStatusCode ProfileCallback(
+    void *const);
+#endif
+static tHttpStatusCode ReportCallback(
+    void *const);
+#if HTTP_TRACING
+static tHttpStatusCode TraceCallback(
+    void *const);
+#endif
+
+/* Sorted - looked up with binary search */
+const tResourceEntry exampleResources[] = {
+#if HTTP_RESOURCE_CONTINUATION
+  {STRING_WITH_LENGTH("/export"), &ExportCallback, 0U, HTTP_PRIORITY_BULK},
+#endif
+  {STRING_WITH_LENGTH("/hello"), &HelloCallback},
+  {STRING_WITH_LENGTH("/index.html"), &IndexCallback},
+#if HTTP_LATENCY_HISTOGRAMS
+  {STRING_WITH_LENGTH("/latency"), &LatencyCallback, 0U,
+      HTTP_PRIORITY_BACKGROUND},
+#endif
+#if HTTP_METRICS
+  {STRING_WITH_LENGTH("/metrics"), &Http_MetricsResource, 0U,
+      HTTP_PRIORITY_BACKGROUND},
+#endif
+#if HTTP_PROFILING
+  {STRING_WITH_LENGTH("/profile"), &ProfileCallback},
+#endif
+  {STRING_WITH_LENGTH("/report"), &ReportCallback, HTTP_RESOURCE_OFFLOAD},
+#if HTTP_TRACING
+  {STRING_WITH_LENGTH("/trace"), &TraceCallback, 0U, HTTP_PRIORITY_BACKGROUND}
+#endif
+};
+
+const unsigned int exampleResourcesLength =
+    sizeof(exampleResources) / sizeof(exampleResources[0]);
+
+#if HTTP_RESOURCE_CONTINUATION
+static tHttpStatusCode ExportCallback(
+    void *const conn)
+{
+  static const char digits[] = "0123456789abcdef";
+  char line[] = "export 00000000\n";
+  unsigned long row = Http_HelperGetCursor(conn);
+  unsigned long end = row + 512UL;
+  unsigned int i;
+
+  /* 32 MiB in 8 KiB slices, each fits pending output of the port */
+  if (0UL == row)
+  {
+    Http_HelperSetResponseStatus(conn, HTTP_STATUS_OK);
+    Http_HelperSetResponseHeader(conn, "Content-Type", "text/plain");
+    Http_HelperSendHeader(conn);
+    if (Http_HelperHeadOnly(conn))
+    {
+      /* Nothing of the 32 MiB would be sent */
+      Http_HelperFlush(conn);
+      return HTTP_STATUS_OK;
+    }
+  }
+  for (; row < end; row++)
+  {
+    for (i = 0U; i < 8U; i++)
+    {
+      line[7U + i] = digits[(row >> (28U - 4U * i)) & 0x0FUL];
+    }
+    Http_HelperSendMessageBody(conn, line);
+  }
+
+  if (row < 2097152UL)
+  {
+    /* Chunked body stays open until the last slice */
+    Http_HelperYield(conn, row);
+  }
+  else
+  {
+    Http_HelperFlush(conn);
+  }
+
+  return HTTP_STATUS_OK;
+}
+#endif
+
+static tHttpStatusCode HelloCallback(
+    void *const conn)
+{
+  Http_HelperSetResponseStatus(conn, HTTP_STATUS_OK);
+  Http_HelperSendContent(conn, "text/plain", "Hello world!\n", 13U);
+
+  return HTTP_STATUS_OK;
+}
+
+static tHttpStatusCode IndexCallback(
+    void *const conn)
+{
+  const char *name = "uCHttpServer";
+  const void *const parameters[] = { name };
+
+  Http_HelperSetResponseStatus(conn, HTTP_STATUS_OK);
+  Http_HelperSetResponseHeader(conn, "Content-Type", "text/html");
+  Http_HelperSendHeader(conn);
+  Http_HelperSendMessageBodyParametered(conn,
+      "<html><body><h1>Welcome to %s!</h1></body></html>", parameters);
+  Http_HelperFlush(conn);
+
+  return HTTP_STATUS_OK;
+}
+
+#if HTTP_LATENCY_HISTOGRAMS
+static tHttpStatusCode LatencyCallback(
+    void *const conn)
+{
+  static const char *const kinds[2] = {"request", "handler"};
+  tHttpLatencies *const latencies = Http_HelperGetLatencies(conn);
+  tHttpLatency *merged = malloc(sizeof(tHttpLatency));
+  char line[160];
+  unsigned int i;
+  unsigned int k;
+
+  /* All workers merged, HTTP_CLOCK ticks */
+  Http_HelperSetResponseStatus(conn, HTTP_STATUS_OK);
+  Http_HelperSetResponseHeader(conn, "Content-Type", "text/plain");
+  Http_HelperSendHeader(conn);
+  snprintf(line, sizeof(line), "%-16s %-8s %10s %12s %12s %12s %12s\n",
+      "resource", "kind", "count", "p50", "p99", "p999", "max");
+  Http_HelperSendMessageBody(conn, line);
+  for (i = 0U; NULL != latencies && NULL != merged &&
+      i < latencies->resourcesLength; i++)
+  {
+    Http_LatencyMerge(latencies, i, merged);
+    for (k = 0U; k < 2U; k++)
+    {
+      const tHttpHistogram *h = (0U == k) ? &(merged->request) :
+          &(merged->handler);
+
+      snprintf(line, sizeof(line),
+          "%-16.*s %-8s %10lu %12lu %12lu %12lu %12lu\n",
+          (int) exampleResources[i].name.length, exampleResources[i].name.str,
+          kinds[k], h->total, Http_HistogramPercentile(h, 5000U),
+          Http_HistogramPercentile(h, 9900U),
+          Http_HistogramPercentile(h, 9990U), h->max);
+      Http_HelperSendMessageBody(conn, line);
+    }
+  }
+  Http_HelperFlush(conn);
+  free(merged);
+
+  return HTTP_STATUS_OK;
+}
+#endif
+
+#if HTTP_PROFILING
+static tHttpStatusCode ProfileCallback(
+    void *const conn)
+{
+  tHttpProfile *const profile = Http_HelperGetProfile(conn);
+  char line[96];
+  unsigned int i;
+
+  /* Counters of the worker serving this connection, ?reset=1 zeroes them */
+  Http_HelperSetResponseStatus(conn, HTTP_STATUS_OK);
+  Http_HelperSetResponseHeader(conn, "Content-Type", "text/plain");
+  Http_HelperSendHeader(conn);
+  for (i = 0U; NULL != profile && i < HTTP_PROFILE_STATES; i++)
+  {
+    snprintf(line, sizeof(line), "%-28s %12lu %16lu\n",
+        Http_ProfileStateName(i), profile->states[i].calls,
+        profile->states[i].time);
+    Http_HelperSendMessageBody(conn, line);
+  }
+  for (i = 0U; NULL != profile && i < profile->resourcesLength; i++)
+  {
+    snprintf(line, sizeof(line), "%-28.*s %12lu %16lu\n",
+        (int) exampleResources[i].name.length, exampleResources[i].name.str,
+        profile->resources[i].calls, profile->resources[i].time);
+    Http_HelperSendMessageBody(conn, line);
+  }
+  Http_HelperFlush(conn);
+
+  if (NULL != profile && NULL != Http_HelperGetParameter(conn, "reset"))
+  {
+    Http_ProfileReset(profile);
+  }
+
+  return HTTP_STATUS_OK;
+}
+#endif
+
+static tHttpStatusCode ReportCallback(
+    void *const conn)
+{
+  static const char digits[] = "0123456789abcdef";
+  char line[] = "row 00000000\n";
+  unsigned long hash = 2166136261UL;
+  unsigned int row;
+  unsigned int i;
+
+  /* CPU-bound on purpose - hashed table of rows, streamed chunked */
+  Http_HelperSetResponseStatus(conn, HTTP_STATUS_OK);
+  Http_HelperSetResponseHeader(conn, "Content-Type", "text/plain");
+  Http_HelperSendHeader(conn);
+  for (row = 0U; row < 1024U; row++)
+  {
+    for (i = 0U; i < 4096U; i++)
+    {
+      hash = ((hash ^ (row + i)) * 16777619UL) & 0xFFFFFFFFUL;
+    }
+    for (i = 0U; i < 8U; i++)
+    {
+      line[4U + i] = digits[(hash >> (28U - 4U * i)) & 0x0FU];
+    }
+    Http_HelperSendMessageBody(conn, line);
+  }
+  Http_HelperFlush(conn);
+
+  return HTTP_STATUS_OK;
+}
+
+#if HTTP_TRACING
+static tHttpStatusCode TraceCallback(
+    void *const conn)
+{
+  /* Dump read by trace-decode - magic, version, sizeof(unsigned long),
+   * 1 on little-endian hosts, then events oldest first */
+  const unsigned short one = 1U;
+  const char header[8] = {
+    'u', 'C', 'H', 'T', 2, (char) sizeof(unsigned long),
+    *(const char *) &one, 0
+  };
+  tHttpTrace *const trace = Http_HelperGetTrace(conn);
+  tHttpTraceEvent *events = malloc(HTTP_SHARDED_TRACE_EVENTS *
+      sizeof(tHttpTraceEvent));
+  unsigned long count = 0UL;
+
+  if (NULL != trace && NULL != events)
+  {
+    count = Http_TraceCopy(trace, events, HTTP_SHARDED_TRACE_EVENTS);
+  }
+
+  Http_HelperSetResponseStatus(conn, HTTP_STATUS_OK);
+  Http_HelperSetResponseHeader(conn, "Content-Type",
+      "application/octet-stream");
+  Http_HelperSendHeader(conn);
+  Http_HelperSend(conn, header, sizeof(header));
+  if (0UL < count)
+  {
+    Http_HelperSend(conn, (const char *) events,
+        (unsigned int) (count * sizeof(tHttpTraceEvent)));
+  }
+  Http_HelperFlush(conn);
+  free(events);
+
+  return HTTP_STATUS_OK;
+}
+#endif
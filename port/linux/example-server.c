@@ -0,0 +1,116 @@
+/*
+ example-server.c
+
+ MIT License
+
+ Copyright (c) 2026 uChttpserver contributors
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+  Created on: Oct 18, 2026
+      Author: uChttpserver contributors
+ */
+
+#include "sharded-port.h"
+#include "example-resources.h"
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/*****************************************************************************/
+/* Server                                                                    */
+/*****************************************************************************/
+
+static tHttpSharded sharded;
+#if HTTP_DEFERRED_RESOURCES
+static tHttpExecutor executor;
+#endif
+#if HTTP_EPOLL_CAPTURE
+static tHttpCapture capture;
+#endif
+
+static void OnSignal(
+    int signal)
+{
+  HttpSharded_Stop(&sharded);
+}
+
+int main(
+    int argc,
+    char **argv)
+{
+  tHttpShardedConfig config;
+  struct sigaction action;
+
+  /* example-server [port] [connections per worker] [workers, 0 - per CPU]
+   *   [executor threads, 0 - per CPU] [capture file] */
+  config.port = (1 < argc) ? (unsigned short) atoi(argv[1]) : 8080U;
+  config.connections = (2 < argc) ? (unsigned int) atoi(argv[2]) : 1024U;
+  config.workers = (3 < argc) ? (unsigned int) atoi(argv[3]) : 1U;
+  config.pin = 1;
+  config.resources = &exampleResources;
+  config.resourcesLength = exampleResourcesLength;
+#if HTTP_DEFERRED_RESOURCES
+  if (0 > HttpExecutor_Start(&executor,
+      (4 < argc) ? (unsigned int) atoi(argv[4]) : 0U))
+  {
+    perror("executor");
+    return EXIT_FAILURE;
+  }
+  config.executor = &executor;
+#endif
+#if HTTP_EPOLL_CAPTURE
+  config.capture = NULL;
+  if (5 < argc)
+  {
+    if (0 > HttpCapture_Open(&capture, argv[5]))
+    {
+      perror("capture");
+      return EXIT_FAILURE;
+    }
+    config.capture = &capture;
+  }
+#endif
+
+  /* Workers inherit the mask, signals are handled by the main thread */
+  action.sa_handler = &OnSignal;
+  action.sa_flags = 0;
+  sigemptyset(&action.sa_mask);
+  sigaction(SIGINT, &action, NULL);
+  sigaction(SIGTERM, &action, NULL);
+
+  if (0 > HttpSharded_Start(&sharded, &config))
+  {
+    perror("start");
+    return EXIT_FAILURE;
+  }
+
+  printf("Listening on port %u, %u workers, %u connections each\n",
+      config.port, sharded.count, config.connections);
+  HttpSharded_Join(&sharded);
+#if HTTP_EPOLL_CAPTURE
+  if (NULL != config.capture)
+  {
+    HttpCapture_Close(&capture);
+  }
+#endif
+
+  return EXIT_SUCCESS;
+}
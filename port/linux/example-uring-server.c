@@ -0,0 +1,90 @@
+/*
+ example-uring-server.c
+
+ MIT License
+
+ Copyright (c) 2026 uChttpserver contributors
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+  Created on: Oct 18, 2026
+      Author: uChttpserver contributors
+ */
+
+#include "uring-port.h"
+#include "example-resources.h"
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/*****************************************************************************/
+/* Server                                                                    */
+/*****************************************************************************/
+
+static tHttpUringServer server;
+
+static void OnSignal(
+    int signal)
+{
+  HttpUring_Stop(&server);
+}
+
+int main(
+    int argc,
+    char **argv)
+{
+  unsigned short port = (1 < argc) ? (unsigned short) atoi(argv[1]) : 8080U;
+  unsigned int poolLength = (2 < argc) ? (unsigned int) atoi(argv[2]) : 1024U;
+  tHttpUringConnection *pool = calloc(poolLength, sizeof(*pool));
+  struct sigaction action;
+  int fd;
+
+  if (NULL == pool)
+  {
+    perror("calloc");
+    return EXIT_FAILURE;
+  }
+
+  fd = HttpLinux_Listen(port, 0);
+  if (0 > fd)
+  {
+    perror("listen");
+    return EXIT_FAILURE;
+  }
+  if (0 > HttpUring_Initialize(&server, fd, pool, poolLength,
+          &exampleResources, exampleResourcesLength))
+  {
+    perror("io_uring");
+    return EXIT_FAILURE;
+  }
+
+  action.sa_handler = &OnSignal;
+  action.sa_flags = 0;
+  sigemptyset(&action.sa_mask);
+  sigaction(SIGINT, &action, NULL);
+  sigaction(SIGTERM, &action, NULL);
+
+  printf("Listening on port %u, %u connections\n", port, poolLength);
+  HttpUring_Run(&server);
+  HttpUring_Close(&server);
+  free(pool);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,325 @@
+/*
+ executor.c
+
+ MIT License
+
+ Copyright (c) 2026 uChttpserver contributors
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+  Created on: Oct 18, 2026
+      Author: uChttpserver contributors
+ */
+
+/*****************************************************************************/
+/* Includes                                                                  */
+/*****************************************************************************/
+
+#define _GNU_SOURCE
+
+#include "executor.h"
+
+#include <errno.h>
+#include <sched.h>
+#include <stdlib.h>
+
+/*****************************************************************************/
+/* Local functions (declarations)                                            */
+/*****************************************************************************/
+
+static void *Executor_Worker(
+    void *arg);
+static int Executor_Push(
+    tHttpExecutorWorker *const worker,
+    tHttpTaskCallback run,
+    void *arg);
+static int Executor_Take(
+    tHttpExecutorWorker *const worker,
+    tHttpTask *task);
+static int Executor_Steal(
+    tHttpExecutorWorker *const worker,
+    tHttpTask *task);
+static int Executor_Queued(
+    tHttpExecutor *const executor);
+static void Executor_Wake(
+    tHttpExecutorWorker *const worker);
+
+/*****************************************************************************/
+/* Global functions                                                          */
+/*****************************************************************************/
+
+int HttpExecutor_Start(
+    tHttpExecutor *const executor,
+    unsigned int threads)
+{
+  unsigned int i;
+
+  if (0U == threads)
+  {
+    cpu_set_t available;
+
+    CPU_ZERO(&available);
+    if (0 != sched_getaffinity(0, sizeof(available), &available))
+    {
+      return -1;
+    }
+    threads = (unsigned int) CPU_COUNT(&available);
+  }
+
+  executor->workers = calloc(threads, sizeof(tHttpExecutorWorker));
+  if (NULL == executor->workers)
+  {
+    return -1;
+  }
+  executor->count = threads;
+  executor->next = 0U;
+  executor->running = 1;
+
+  for (i = 0U; i < threads; i++)
+  {
+    tHttpExecutorWorker *const worker = &(executor->workers[i]);
+
+    worker->executor = executor;
+    worker->index = i;
+    pthread_mutex_init(&(worker->lock), NULL);
+    pthread_cond_init(&(worker->wake), NULL);
+  }
+
+  for (i = 0U; i < threads; i++)
+  {
+    tHttpExecutorWorker *const worker = &(executor->workers[i]);
+    int error = pthread_create(&(worker->thread), NULL, &Executor_Worker,
+        worker);
+
+    if (0 != error)
+    {
+      HttpExecutor_Stop(executor);
+      errno = error;
+      return -1;
+    }
+    worker->started = 1;
+  }
+
+  return 0;
+}
+
+int HttpExecutor_Submit(
+    tHttpExecutor *const executor,
+    tHttpTaskCallback run,
+    void *arg)
+{
+  unsigned int start = __atomic_fetch_add(&(executor->next), 1U,
+      __ATOMIC_RELAXED);
+  unsigned int i;
+
+  for (i = 0U; i < executor->count; i++)
+  {
+    tHttpExecutorWorker *const worker =
+        &(executor->workers[(start + i) % executor->count]);
+
+    if (0 == Executor_Push(worker, run, arg))
+    {
+      Executor_Wake(worker);
+      return 0;
+    }
+  }
+
+  return -1;
+}
+
+void HttpExecutor_Stop(
+    tHttpExecutor *const executor)
+{
+  unsigned int i;
+
+  __atomic_store_n(&(executor->running), 0, __ATOMIC_SEQ_CST);
+  for (i = 0U; i < executor->count; i++)
+  {
+    tHttpExecutorWorker *const worker = &(executor->workers[i]);
+
+    pthread_mutex_lock(&(worker->lock));
+    pthread_cond_signal(&(worker->wake));
+    pthread_mutex_unlock(&(worker->lock));
+  }
+
+  for (i = 0U; i < executor->count; i++)
+  {
+    if (executor->workers[i].started)
+    {
+      pthread_join(executor->workers[i].thread, NULL);
+    }
+    pthread_cond_destroy(&(executor->workers[i].wake));
+    pthread_mutex_destroy(&(executor->workers[i].lock));
+  }
+  free(executor->workers);
+  executor->workers = NULL;
+  executor->count = 0U;
+}
+
+/*****************************************************************************/
+/* Local functions (definitions)                                             */
+/*****************************************************************************/
+
+static void *Executor_Worker(
+    void *arg)
+{
+  tHttpExecutorWorker *const worker = arg;
+  tHttpExecutor *const executor = worker->executor;
+
+  for (;;)
+  {
+    tHttpTask task;
+
+    if (0 == Executor_Take(worker, &task) ||
+        0 == Executor_Steal(worker, &task))
+    {
+      task.run(task.arg);
+      continue;
+    }
+
+    /* Submitters read the flag after queueing, queues are read after it
+     * is set - either this worker sees the task or it is woken up */
+    pthread_mutex_lock(&(worker->lock));
+    __atomic_store_n(&(worker->sleeping), 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&(executor->running), __ATOMIC_SEQ_CST) &&
+        0 == Executor_Queued(executor))
+    {
+      pthread_cond_wait(&(worker->wake), &(worker->lock));
+    }
+    __atomic_store_n(&(worker->sleeping), 0, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&(worker->lock));
+
+    if (0 == __atomic_load_n(&(executor->running), __ATOMIC_SEQ_CST) &&
+        0 == Executor_Queued(executor))
+    {
+      break;
+    }
+  }
+
+  return NULL;
+}
+
+static int Executor_Push(
+    tHttpExecutorWorker *const worker,
+    tHttpTaskCallback run,
+    void *arg)
+{
+  int result = -1;
+
+  pthread_mutex_lock(&(worker->lock));
+  if (HTTP_EXECUTOR_QUEUE_LENGTH > worker->tail - worker->head)
+  {
+    tHttpTask *const task =
+        &(worker->tasks[worker->tail % HTTP_EXECUTOR_QUEUE_LENGTH]);
+
+    task->run = run;
+    task->arg = arg;
+    __atomic_store_n(&(worker->tail), worker->tail + 1U, __ATOMIC_SEQ_CST);
+    result = 0;
+  }
+  pthread_mutex_unlock(&(worker->lock));
+
+  return result;
+}
+
+static int Executor_Take(
+    tHttpExecutorWorker *const worker,
+    tHttpTask *task)
+{
+  int result = -1;
+
+  /* Unlocked peek - an idle deque is not contended by its scanners */
+  if (__atomic_load_n(&(worker->tail), __ATOMIC_SEQ_CST) ==
+      __atomic_load_n(&(worker->head), __ATOMIC_SEQ_CST))
+  {
+    return -1;
+  }
+
+  pthread_mutex_lock(&(worker->lock));
+  if (worker->tail != worker->head)
+  {
+    *task = worker->tasks[worker->head % HTTP_EXECUTOR_QUEUE_LENGTH];
+    __atomic_store_n(&(worker->head), worker->head + 1U, __ATOMIC_SEQ_CST);
+    result = 0;
+  }
+  pthread_mutex_unlock(&(worker->lock));
+
+  return result;
+}
+
+static int Executor_Steal(
+    tHttpExecutorWorker *const worker,
+    tHttpTask *task)
+{
+  tHttpExecutor *const executor = worker->executor;
+  unsigned int i;
+
+  /* Only once the own deque is empty, oldest task of the next busy one */
+  for (i = 1U; i < executor->count; i++)
+  {
+    if (0 == Executor_Take(
+        &(executor->workers[(worker->index + i) % executor->count]), task))
+    {
+      return 0;
+    }
+  }
+
+  return -1;
+}
+
+static int Executor_Queued(
+    tHttpExecutor *const executor)
+{
+  unsigned int i;
+
+  for (i = 0U; i < executor->count; i++)
+  {
+    tHttpExecutorWorker *const worker = &(executor->workers[i]);
+
+    if (__atomic_load_n(&(worker->tail), __ATOMIC_SEQ_CST) !=
+        __atomic_load_n(&(worker->head), __ATOMIC_SEQ_CST))
+    {
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+static void Executor_Wake(
+    tHttpExecutorWorker *const worker)
+{
+  tHttpExecutor *const executor = worker->executor;
+  unsigned int i;
+
+  /* Owner when it sleeps, otherwise the next sleeping worker steals it */
+  for (i = 0U; i < executor->count; i++)
+  {
+    tHttpExecutorWorker *const sleeper =
+        &(executor->workers[(worker->index + i) % executor->count]);
+
+    if (__atomic_load_n(&(sleeper->sleeping), __ATOMIC_SEQ_CST))
+    {
+      pthread_mutex_lock(&(sleeper->lock));
+      pthread_cond_signal(&(sleeper->wake));
+      pthread_mutex_unlock(&(sleeper->lock));
+      return;
+    }
+  }
+}
@@ -0,0 +1,118 @@
+/*
+ executor.h
+
+ MIT License
+
+ Copyright (c) 2026 uChttpserver contributors
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+  Created on: Oct 18, 2026
+      Author: uChttpserver contributors
+ */
+
+#ifndef EXECUTOR_H_
+#define EXECUTOR_H_
+
+/*****************************************************************************/
+/* Includes                                                                  */
+/*****************************************************************************/
+
+#include <pthread.h>
+
+/*****************************************************************************/
+/* Options                                                                   */
+/*****************************************************************************/
+
+/* Tasks queued per worker (power of two), submission fails when all are full */
+#ifndef HTTP_EXECUTOR_QUEUE_LENGTH
+#define HTTP_EXECUTOR_QUEUE_LENGTH (256)
+#endif
+
+/*****************************************************************************/
+/* Type definitions                                                          */
+/*****************************************************************************/
+
+typedef void (
+    *tHttpTaskCallback) (
+    void *arg);
+
+typedef struct HttpTask
+{
+  tHttpTaskCallback run;
+  void *arg;
+} tHttpTask;
+
+struct HttpExecutor;
+
+typedef struct HttpExecutorWorker
+{
+  struct HttpExecutor *executor;
+  pthread_mutex_t lock;          /* Guards the deque and its wakeup */
+  pthread_cond_t wake;
+  unsigned int head;             /* Owner and thieves take from here */
+  unsigned int tail;             /* Submissions append here */
+  int sleeping;                  /* Waits on wake, checked by submitters */
+  tHttpTask tasks[HTTP_EXECUTOR_QUEUE_LENGTH];
+  pthread_t thread;
+  unsigned int index;
+  int started;
+} tHttpExecutorWorker;
+
+typedef struct HttpExecutor
+{
+  tHttpExecutorWorker *workers;
+  unsigned int count;
+  unsigned int next;             /* Round-robin submission */
+  int running;
+} tHttpExecutor;
+
+/*****************************************************************************/
+/* Executor API                                                              */
+/* - work-stealing pool for resource callbacks too heavy for event loops,    */
+/*   each worker has its own deque and wakeup, no lock is shared by all.     */
+/*   Tasks come from event loops, never from workers, so owners run them     */
+/*   oldest first like thieves do - newest first would starve the earliest   */
+/*   requests while submissions keep arriving                                */
+/*****************************************************************************/
+
+/**
+ * \brief Start worker threads, 0 - one per CPU available to process
+ * \return 0 or -1 with errno set
+ */
+int HttpExecutor_Start(
+    tHttpExecutor *const executor,
+    unsigned int threads);
+
+/**
+ * \brief Queue task, thread-safe
+ * \return 0 or -1 when all queues are full - caller should run it itself
+ */
+int HttpExecutor_Submit(
+    tHttpExecutor *const executor,
+    tHttpTaskCallback run,
+    void *arg);
+
+/**
+ * \brief Run queued tasks to completion and stop workers
+ */
+void HttpExecutor_Stop(
+    tHttpExecutor *const executor);
+
+#endif /* EXECUTOR_H_ */
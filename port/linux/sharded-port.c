@@ -0,0 +1,318 @@
+/*
+ sharded-port.c
+
+ MIT License
+
+ Copyright (c) 2026 uChttpserver contributors
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+  Created on: Oct 18, 2026
+      Author: uChttpserver contributors
+ */
+
+/*****************************************************************************/
+/* Includes                                                                  */
+/*****************************************************************************/
+
+#define _GNU_SOURCE
+
+#include "sharded-port.h"
+
+#include <errno.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/*****************************************************************************/
+/* Local functions (declarations)                                            */
+/*****************************************************************************/
+
+static void *ShardedPort_Worker(
+    void *arg);
+static void ShardedPort_Release(
+    tHttpSharded *const sharded);
+#if HTTP_METRICS
+static tHttpMetrics *ShardedPort_AllocateMetrics(
+    unsigned int resourcesLength);
+#endif
+
+/*****************************************************************************/
+/* Global functions                                                          */
+/*****************************************************************************/
+
+int HttpSharded_Start(
+    tHttpSharded *const sharded,
+    const tHttpShardedConfig *config)
+{
+  cpu_set_t available;
+  unsigned int count = config->workers;
+  unsigned int i;
+  int cpu = -1;
+
+  CPU_ZERO(&available);
+  if (0 != sched_getaffinity(0, sizeof(available), &available))
+  {
+    return -1;
+  }
+  if (0U == count)
+  {
+    count = (unsigned int) CPU_COUNT(&available);
+  }
+
+  sharded->count = 0U;
+#if HTTP_DEFERRED_RESOURCES
+  sharded->executor = config->executor;
+#endif
+  sharded->shards = calloc(count, sizeof(tHttpShard));
+  if (NULL == sharded->shards)
+  {
+    return -1;
+  }
+
+  for (i = 0U; i < count; i++)
+  {
+    tHttpShard *const shard = &(sharded->shards[i]);
+    int fd;
+
+    shard->cpu = -1;
+    if (config->pin)
+    {
+      /* Next CPU from the affinity mask, wrapping when oversubscribed */
+      do
+      {
+        cpu = (cpu + 1) % CPU_SETSIZE;
+      }
+      while (!CPU_ISSET(cpu, &available));
+      shard->cpu = cpu;
+    }
+
+    shard->pool = calloc(config->connections, sizeof(tHttpEpollConnection));
+#if HTTP_PROFILING
+    shard->profile.resources = calloc(config->resourcesLength,
+        sizeof(tHttpProfileCounter));
+    shard->profile.resourcesLength =
+        (NULL != shard->profile.resources) ? config->resourcesLength : 0U;
+#endif
+#if HTTP_TRACING
+    Http_TraceInitialize(&(shard->trace),
+        calloc(HTTP_SHARDED_TRACE_EVENTS, sizeof(tHttpTraceEvent)),
+        HTTP_SHARDED_TRACE_EVENTS);
+#endif
+#if HTTP_METRICS
+    shard->metrics = ShardedPort_AllocateMetrics(config->resourcesLength);
+#endif
+#if HTTP_LATENCY_HISTOGRAMS
+    Http_LatencyInitialize(&(shard->latencies),
+        calloc(config->resourcesLength, sizeof(tHttpLatency)),
+        config->resourcesLength);
+#endif
+    fd = HttpLinux_Listen(config->port, 1);
+    if (NULL == shard->pool || 0 > fd ||
+#if HTTP_TRACING
+        NULL == shard->trace.events ||
+#endif
+#if HTTP_METRICS
+        NULL == shard->metrics ||
+#endif
+#if HTTP_LATENCY_HISTOGRAMS
+        (NULL == shard->latencies.resources &&
+            0U < config->resourcesLength) ||
+#endif
+        0 > HttpEpoll_Initialize(&(shard->server), fd, shard->pool,
+            config->connections, config->resources,
+            config->resourcesLength))
+    {
+      int error = errno;
+
+      if (0 <= fd)
+      {
+        close(fd);
+      }
+      free(shard->pool);
+#if HTTP_PROFILING
+      free(shard->profile.resources);
+#endif
+#if HTTP_TRACING
+      free(shard->trace.events);
+#endif
+#if HTTP_METRICS
+      free(shard->metrics);
+#endif
+#if HTTP_LATENCY_HISTOGRAMS
+      free(shard->latencies.resources);
+#endif
+      ShardedPort_Release(sharded);
+      errno = error;
+      return -1;
+    }
+#if HTTP_DEFERRED_RESOURCES
+    HttpEpoll_SetExecutor(&(shard->server), config->executor);
+#endif
+#if HTTP_PROFILING
+    HttpEpoll_SetProfile(&(shard->server), &(shard->profile));
+#endif
+#if HTTP_TRACING
+    HttpEpoll_SetTrace(&(shard->server), &(shard->trace));
+#endif
+#if HTTP_METRICS
+    if (0U < i)
+    {
+      /* Any worker renders the sum of all */
+      Http_MetricsLink(sharded->shards[0].metrics, shard->metrics);
+    }
+    HttpEpoll_SetMetrics(&(shard->server), shard->metrics);
+#endif
+#if HTTP_LATENCY_HISTOGRAMS
+    if (0U < i)
+    {
+      Http_LatencyLink(&(sharded->shards[0].latencies), &(shard->latencies));
+    }
+    HttpEpoll_SetLatencies(&(shard->server), &(shard->latencies));
+#endif
+#if HTTP_EPOLL_CAPTURE
+    HttpEpoll_SetCapture(&(shard->server), config->capture);
+#endif
+    ++(sharded->count);
+  }
+
+  for (i = 0U; i < sharded->count; i++)
+  {
+    tHttpShard *const shard = &(sharded->shards[i]);
+    int error = pthread_create(&(shard->thread), NULL, &ShardedPort_Worker,
+        shard);
+
+    if (0 != error)
+    {
+      HttpSharded_Stop(sharded);
+      HttpSharded_Join(sharded);
+      errno = error;
+      return -1;
+    }
+    shard->started = 1;
+  }
+
+  return 0;
+}
+
+void HttpSharded_Stop(
+    tHttpSharded *const sharded)
+{
+  unsigned int i;
+
+  for (i = 0U; i < sharded->count; i++)
+  {
+    HttpEpoll_Stop(&(sharded->shards[i].server));
+  }
+}
+
+void HttpSharded_Join(
+    tHttpSharded *const sharded)
+{
+  unsigned int i;
+
+  for (i = 0U; i < sharded->count; i++)
+  {
+    if (sharded->shards[i].started)
+    {
+      pthread_join(sharded->shards[i].thread, NULL);
+    }
+  }
+#if HTTP_DEFERRED_RESOURCES
+  if (NULL != sharded->executor)
+  {
+    /* Completions still signal event descriptors, close them afterwards */
+    HttpExecutor_Stop(sharded->executor);
+    sharded->executor = NULL;
+  }
+#endif
+  ShardedPort_Release(sharded);
+}
+
+/*****************************************************************************/
+/* Local functions (definitions)                                             */
+/*****************************************************************************/
+
+static void *ShardedPort_Worker(
+    void *arg)
+{
+  tHttpShard *const shard = arg;
+
+  if (0 <= shard->cpu)
+  {
+    cpu_set_t set;
+
+    CPU_ZERO(&set);
+    CPU_SET(shard->cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+  }
+
+  HttpEpoll_Run(&(shard->server));
+
+  return NULL;
+}
+
+static void ShardedPort_Release(
+    tHttpSharded *const sharded)
+{
+  unsigned int i;
+
+  for (i = 0U; i < sharded->count; i++)
+  {
+    HttpEpoll_Close(&(sharded->shards[i].server));
+    free(sharded->shards[i].pool);
+#if HTTP_PROFILING
+    free(sharded->shards[i].profile.resources);
+#endif
+#if HTTP_TRACING
+    free(sharded->shards[i].trace.events);
+#endif
+#if HTTP_METRICS
+    free(sharded->shards[i].metrics);
+#endif
+#if HTTP_LATENCY_HISTOGRAMS
+    free(sharded->shards[i].latencies.resources);
+#endif
+  }
+  free(sharded->shards);
+  sharded->shards = NULL;
+  sharded->count = 0U;
+}
+
+#if HTTP_METRICS
+static tHttpMetrics *ShardedPort_AllocateMetrics(
+    unsigned int resourcesLength)
+{
+  size_t size = sizeof(tHttpMetrics) + resourcesLength * sizeof(unsigned long);
+  void *block;
+
+  /* Whole lines, so no other allocation shares them with the worker */
+  size = (size + HTTP_SHARDED_CACHE_LINE - 1U) &
+      ~((size_t) HTTP_SHARDED_CACHE_LINE - 1U);
+  if (0 != posix_memalign(&block, HTTP_SHARDED_CACHE_LINE, size))
+  {
+    return NULL;
+  }
+  /* Resource counters follow the metrics in the same block */
+  Http_MetricsInitialize(block, (unsigned long *) ((tHttpMetrics *) block + 1),
+      resourcesLength);
+
+  return block;
+}
+#endif
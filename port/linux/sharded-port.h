@@ -0,0 +1,133 @@
+/*
+ sharded-port.h
+
+ MIT License
+
+ Copyright (c) 2026 uChttpserver contributors
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+  Created on: Oct 18, 2026
+      Author: uChttpserver contributors
+ */
+
+#ifndef SHARDED_PORT_H_
+#define SHARDED_PORT_H_
+
+/*****************************************************************************/
+/* Includes                                                                  */
+/*****************************************************************************/
+
+#include "epoll-port.h"
+
+#include <pthread.h>
+
+/*****************************************************************************/
+/* Options                                                                   */
+/*****************************************************************************/
+
+/* Trace ring of each worker, power of two */
+#ifndef HTTP_SHARDED_TRACE_EVENTS
+#define HTTP_SHARDED_TRACE_EVENTS (65536UL)
+#endif
+
+/* Metrics of each worker start and end on a line of their own */
+#ifndef HTTP_SHARDED_CACHE_LINE
+#define HTTP_SHARDED_CACHE_LINE (64U)
+#endif
+
+/*****************************************************************************/
+/* Type definitions                                                          */
+/*****************************************************************************/
+
+typedef struct HttpShardedConfig
+{
+  unsigned short port;
+  unsigned int workers;          /* 0 - one per CPU available to process */
+  unsigned int connections;      /* Pool length of each worker */
+  int pin;                       /* Bind each worker to its own CPU */
+  const tResourceEntry (
+      *resources)[];             /* Shared by all workers, read-only */
+  unsigned int resourcesLength;
+#if HTTP_DEFERRED_RESOURCES
+  tHttpExecutor *executor;       /* Started by caller, stopped on join */
+#endif
+#if HTTP_EPOLL_CAPTURE
+  tHttpCapture *capture;         /* Opened by caller, NULL - disabled */
+#endif
+} tHttpShardedConfig;
+
+typedef struct HttpShard
+{
+  tHttpEpollServer server;
+  tHttpEpollConnection *pool;
+#if HTTP_PROFILING
+  tHttpProfile profile;          /* Read with Http_HelperGetProfile */
+#endif
+#if HTTP_TRACING
+  tHttpTrace trace;              /* Read with Http_HelperGetTrace */
+#endif
+#if HTTP_METRICS
+  tHttpMetrics *metrics;         /* Linked with other workers */
+#endif
+#if HTTP_LATENCY_HISTOGRAMS
+  tHttpLatencies latencies;      /* Linked with other workers */
+#endif
+  pthread_t thread;
+  int cpu;                       /* -1 when not pinned */
+  int started;
+} tHttpShard;
+
+typedef struct HttpSharded
+{
+  tHttpShard *shards;
+  unsigned int count;
+#if HTTP_DEFERRED_RESOURCES
+  tHttpExecutor *executor;
+#endif
+} tHttpSharded;
+
+/*****************************************************************************/
+/* Sharded runner API                                                        */
+/* - every worker owns SO_REUSEPORT listener, epoll loop and connection pool,*/
+/*   kernel balances connections, workers never share mutable state         */
+/*****************************************************************************/
+
+/**
+ * \brief Start worker threads
+ * \return 0 or -1 with errno set, nothing is left running on failure
+ */
+int HttpSharded_Start(
+    tHttpSharded *const sharded,
+    const tHttpShardedConfig *config);
+
+/**
+ * \brief Request all workers to exit, async-signal-safe
+ */
+void HttpSharded_Stop(
+    tHttpSharded *const sharded);
+
+/**
+ * \brief Wait for workers and release their resources
+ * Executor is stopped once event loops exit, finishing deferred requests
+ */
+void HttpSharded_Join(
+    tHttpSharded *const sharded);
+
+#endif /* SHARDED_PORT_H_ */
@@ -0,0 +1,293 @@
+/*
+ trace-decode.c
+
+ MIT License
+
+ Copyright (c) 2026 uChttpserver contributors
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+  Created on: Oct 18, 2026
+      Author: uChttpserver contributors
+ */
+
+/*****************************************************************************/
+/* Includes                                                                  */
+/*****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*****************************************************************************/
+/* Defines                                                                   */
+/*****************************************************************************/
+
+/* Event types, same order as tHttpTraceType                                 */
+#define TRACE_CONNECTION (0)
+#define TRACE_REQUEST_LINE (1)
+#define TRACE_HEADERS (2)
+#define TRACE_BODY (3)
+#define TRACE_HANDLER_START (4)
+#define TRACE_HANDLER_END (5)
+#define TRACE_SEND (6)
+#define TRACE_FLUSH (7)
+#define TRACE_ERROR (8)
+
+/*****************************************************************************/
+/* Type definitions                                                          */
+/*****************************************************************************/
+
+typedef struct TraceEvent
+{
+  unsigned long long time;
+  unsigned long long arg;
+  unsigned int connection;
+  unsigned int type;
+  unsigned int detail;
+} tTraceEvent;
+
+/*****************************************************************************/
+/* Local functions (declarations)                                            */
+/*****************************************************************************/
+
+static unsigned long long Decode_Word(
+    const unsigned char *data,
+    unsigned int length,
+    int littleEndian);
+static void Decode_Print(
+    const tTraceEvent *event,
+    unsigned long long origin,
+    double ticksPerUs,
+    unsigned char *open);
+static void Decode_Slice(
+    const tTraceEvent *event,
+    double ts,
+    const char *name,
+    char phase);
+
+/*****************************************************************************/
+/* Local variables and constants                                             */
+/*****************************************************************************/
+
+static const char *const methods[] = {
+  "CONNECT", "DELETE", "GET", "HEAD", "OPTIONS", "POST", "PUT", "TRACE"
+};
+
+/*****************************************************************************/
+/* Decoder                                                                   */
+/* - renders a dump of the trace ring (see /trace of the example server) as */
+/*   Chrome trace event JSON, loadable by chrome://tracing and Perfetto      */
+/*****************************************************************************/
+
+int main(
+    int argc,
+    char **argv)
+{
+  unsigned char header[8];
+  unsigned char record[64];
+  unsigned char *open;
+  unsigned int word;
+  unsigned int length;
+  unsigned long long origin = 0ULL;
+  double ticksPerUs;
+  int littleEndian;
+  int first = 1;
+  FILE *in;
+
+  /* trace-decode dump [clock ticks per microsecond] > trace.json */
+  if (2 > argc)
+  {
+    fprintf(stderr, "usage: %s dump [ticks per us]\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+  in = ('-' == argv[1][0] && '\0' == argv[1][1]) ? stdin :
+      fopen(argv[1], "rb");
+  ticksPerUs = (2 < argc) ? atof(argv[2]) : 1.0;
+  if (NULL == in || 0.0 >= ticksPerUs)
+  {
+    perror(argv[1]);
+    return EXIT_FAILURE;
+  }
+
+  if (sizeof(header) != fread(header, 1U, sizeof(header), in) ||
+      0 != memcmp(header, "uCHT", 4U) ||
+      (1U != header[4] && 2U != header[4]) ||
+      (4U != header[5] && 8U != header[5]))
+  {
+    fprintf(stderr, "%s: not a trace dump\n", argv[1]);
+    return EXIT_FAILURE;
+  }
+  word = header[5];
+  littleEndian = header[6];
+  /* time, arg, then short id, type and detail padded to word alignment,
+   * version 2 adds the sequence word */
+  length = (2U * word + 4U + word - 1U) / word * word +
+      ((2U == header[4]) ? word : 0U);
+
+  /* Requests in progress per connection, slices must nest */
+  open = calloc(65536U, 1U);
+  if (NULL == open)
+  {
+    return EXIT_FAILURE;
+  }
+
+  printf("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+  while (length == fread(record, 1U, length, in))
+  {
+    tTraceEvent event;
+
+    event.time = Decode_Word(record, word, littleEndian);
+    event.arg = Decode_Word(record + word, word, littleEndian);
+    event.connection = (unsigned int) Decode_Word(record + 2U * word, 2U,
+        littleEndian);
+    event.type = record[2U * word + 2U];
+    event.detail = record[2U * word + 3U];
+    if (first)
+    {
+      origin = event.time;
+      first = 0;
+    }
+    else
+    {
+      printf(",\n");
+    }
+    Decode_Print(&event, origin, ticksPerUs, open);
+  }
+  printf("\n]}\n");
+
+  free(open);
+  if (stdin != in)
+  {
+    fclose(in);
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/*****************************************************************************/
+/* Local functions (definitions)                                             */
+/*****************************************************************************/
+
+static unsigned long long Decode_Word(
+    const unsigned char *data,
+    unsigned int length,
+    int littleEndian)
+{
+  unsigned long long value = 0ULL;
+  unsigned int i;
+
+  for (i = 0U; i < length; i++)
+  {
+    value = (value << 8U) | data[littleEndian ? length - 1U - i : i];
+  }
+
+  return value;
+}
+
+static void Decode_Print(
+    const tTraceEvent *event,
+    unsigned long long origin,
+    double ticksPerUs,
+    unsigned char *open)
+{
+  /* Clock wraps like any free running counter */
+  double ts = (double) (event->time - origin) / ticksPerUs;
+
+  switch (event->type)
+  {
+    case TRACE_CONNECTION:
+      open[event->connection] = 0U;
+      Decode_Slice(event, ts, "connection", 'i');
+      printf("}");
+      break;
+    case TRACE_REQUEST_LINE:
+      if (open[event->connection])
+      {
+        /* Previous request ended without a trace of it, e.g. discarded */
+        Decode_Slice(event, ts, "request", 'E');
+        printf("},\n");
+      }
+      open[event->connection] = 1U;
+      Decode_Slice(event, ts, "request", 'B');
+      printf(",\"args\":{\"method\":\"%s\",\"resource\":%llu}}",
+          (event->detail < sizeof(methods) / sizeof(methods[0])) ?
+          methods[event->detail] : "?", event->arg);
+      break;
+    case TRACE_HEADERS:
+      Decode_Slice(event, ts, "headers", 'i');
+      printf("}");
+      break;
+    case TRACE_BODY:
+      Decode_Slice(event, ts, "body", 'i');
+      printf(",\"args\":{\"bytes\":%llu}}", event->arg);
+      break;
+    case TRACE_HANDLER_START:
+      Decode_Slice(event, ts, "handler", 'B');
+      printf(",\"args\":{\"resource\":%llu}}", event->arg);
+      break;
+    case TRACE_HANDLER_END:
+      Decode_Slice(event, ts, "handler", 'E');
+      printf(",\"args\":{\"yielded\":%llu}}", event->arg);
+      if (0ULL == event->arg && open[event->connection])
+      {
+        open[event->connection] = 0U;
+        printf(",\n");
+        Decode_Slice(event, ts, "request", 'E');
+        printf("}");
+      }
+      break;
+    case TRACE_SEND:
+      Decode_Slice(event, ts, "send", 'i');
+      printf(",\"args\":{\"bytes\":%llu}}", event->arg);
+      break;
+    case TRACE_FLUSH:
+      Decode_Slice(event, ts, "flush", 'i');
+      printf("}");
+      break;
+    case TRACE_ERROR:
+      Decode_Slice(event, ts, "error", 'i');
+      printf(",\"args\":{\"status\":%llu}}", event->arg);
+      if (open[event->connection])
+      {
+        open[event->connection] = 0U;
+        printf(",\n");
+        Decode_Slice(event, ts, "request", 'E');
+        printf("}");
+      }
+      break;
+    default:
+      Decode_Slice(event, ts, "unknown", 'i');
+      printf(",\"args\":{\"type\":%u,\"arg\":%llu}}", event->type,
+          event->arg);
+      break;
+  }
+}
+
+static void Decode_Slice(
+    const tTraceEvent *event,
+    double ts,
+    const char *name,
+    char phase)
+{
+  /* Object left open for arguments */
+  printf("{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":0,\"tid\":%u%s",
+      name, phase, ts, event->connection, ('i' == phase) ? ",\"s\":\"t\"" :
+      "");
+}
@@ -0,0 +1,1173 @@
+/*
+ uring-port.c
+
+ MIT License
+
+ Copyright (c) 2026 uChttpserver contributors
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+  Created on: Oct 18, 2026
+      Author: uChttpserver contributors
+ */
+
+/*****************************************************************************/
+/* Includes                                                                  */
+/*****************************************************************************/
+
+#define _GNU_SOURCE
+
+#include "uring-port.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <linux/time_types.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+
+/*****************************************************************************/
+/* Defines                                                                   */
+/*****************************************************************************/
+
+/* Completion owner is encoded in low bits of user_data */
+#define TAG_MASK (7UL)
+#define TAG_ACCEPT (0UL)
+#define TAG_RECV (1UL)
+#define TAG_SEND (2UL)
+
+#define RX_GROUP (0U)
+
+/*****************************************************************************/
+/* Local functions (declarations)                                            */
+/*****************************************************************************/
+
+static int Ring_Setup(
+    tHttpUringRing *const ring,
+    unsigned int flags);
+static struct io_uring_sqe *Ring_GetSqe(
+    tHttpUringRing *const ring);
+static unsigned int Ring_Space(
+    tHttpUringRing *const ring);
+static int Ring_Enter(
+    tHttpUringRing *const ring,
+    unsigned int wait,
+    int timeout);
+static int Ring_Reap(
+    tHttpUringRing *const ring,
+    struct io_uring_cqe *cqe);
+
+static char *UringPort_Acquire(
+    void *const conn,
+    unsigned int *length);
+static void UringPort_Commit(
+    void *const conn,
+    const char *data,
+    unsigned int length);
+static unsigned int UringPort_Send(
+    void *const conn,
+    const char *data,
+    unsigned int length);
+static void UringPort_Error(
+    void *const conn,
+    const tErrorInfo *errorInfo);
+
+static void UringPort_ArmAccept(
+    tHttpUringServer *const server);
+static void UringPort_ArmRecv(
+    tHttpUringConnection *const c);
+static void UringPort_SubmitChain(
+    tHttpUringConnection *const c);
+static void UringPort_RecycleRx(
+    tHttpUringServer *const server,
+    unsigned short bid);
+static void UringPort_ReleaseTx(
+    tHttpUringServer *const server,
+    tHttpUringTx *tx);
+static int UringPort_Append(
+    tHttpUringQueue *const queue,
+    const char *data,
+    unsigned int length);
+static void UringPort_Empty(
+    tHttpUringQueue *const queue);
+static void UringPort_Wait(
+    tHttpUringConnection *const c);
+static void UringPort_Unwait(
+    tHttpUringConnection *const c);
+static void UringPort_Refill(
+    tHttpUringServer *const server);
+static void UringPort_Input(
+    tHttpUringConnection *const c,
+    const char *data,
+    unsigned int length);
+
+static void UringPort_Dispatch(
+    tHttpUringServer *const server,
+    const struct io_uring_cqe *cqe);
+static void UringPort_OnAccept(
+    tHttpUringServer *const server,
+    const struct io_uring_cqe *cqe);
+static void UringPort_OnRecv(
+    tHttpUringConnection *const c,
+    const struct io_uring_cqe *cqe);
+static void UringPort_OnSend(
+    tHttpUringTx *const tx,
+    const struct io_uring_cqe *cqe);
+static void UringPort_Finalize(
+    tHttpUringConnection *const c);
+
+/*****************************************************************************/
+/* Global functions                                                          */
+/*****************************************************************************/
+
+int HttpUring_Initialize(
+    tHttpUringServer *const server,
+    int listenFd,
+    tHttpUringConnection *pool,
+    unsigned int poolLength,
+    const tResourceEntry (*resources)[],
+    unsigned int reslen)
+{
+  struct io_uring_buf_reg reg;
+  struct iovec iov;
+  struct
+  {
+    struct io_uring_probe probe;
+    struct io_uring_probe_op ops[256];
+  } probe;
+  const tHttpUringQueue empty = { NULL, 0U, 0U, 0U };
+  unsigned int i;
+
+  memset(server, 0, sizeof(*server));
+  server->ring.fd = -1;
+  server->listenFd = listenFd;
+  server->pool = pool;
+  server->poolLength = poolLength;
+  server->resources = resources;
+  server->resourcesLength = reslen;
+  server->running = 1;
+
+  for (i = poolLength; i > 0U; i--)
+  {
+    pool[i - 1U].fd = -1;
+    pool[i - 1U].server = server;
+    pool[i - 1U].recvArmed = 0U;
+    pool[i - 1U].waiting = 0U;
+    /* Queues are freed on release and close, pool may be uninitialized */
+    pool[i - 1U].spill = empty;
+    pool[i - 1U].held = empty;
+    pool[i - 1U].next = server->freeList;
+    server->freeList = &(pool[i - 1U]);
+  }
+  for (i = HTTP_URING_TX_BUFFERS; i > 0U; i--)
+  {
+    server->tx[i - 1U].next = server->txFree;
+    server->txFree = &(server->tx[i - 1U]);
+  }
+
+  if (0 > Ring_Setup(&(server->ring),
+          HTTP_URING_SQPOLL ? IORING_SETUP_SQPOLL : 0U))
+  {
+    return -1;
+  }
+
+  /* Registered zero-copy send when kernel supports it */
+  server->sendOpcode = IORING_OP_SEND;
+  memset(&probe, 0, sizeof(probe));
+  if (0 <= syscall(__NR_io_uring_register, server->ring.fd,
+          IORING_REGISTER_PROBE, &probe, 256) &&
+      IORING_OP_SEND_ZC <= probe.probe.last_op &&
+      (probe.ops[IORING_OP_SEND_ZC].flags & IO_URING_OP_SUPPORTED))
+  {
+    server->sendOpcode = IORING_OP_SEND_ZC;
+  }
+
+  server->rxArea = mmap(NULL,
+      (size_t) HTTP_URING_RX_BUFFERS * HTTP_URING_RX_LENGTH,
+      PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  server->rxRing = mmap(NULL,
+      HTTP_URING_RX_BUFFERS * sizeof(struct io_uring_buf),
+      PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  server->txArea = mmap(NULL,
+      (size_t) HTTP_URING_TX_BUFFERS * HTTP_URING_TX_LENGTH,
+      PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (MAP_FAILED == server->rxArea || MAP_FAILED == server->rxRing ||
+      MAP_FAILED == server->txArea)
+  {
+    HttpUring_Close(server);
+    return -1;
+  }
+
+  /* Receive buffers are picked by kernel from the provided ring */
+  memset(&reg, 0, sizeof(reg));
+  reg.ring_addr = (unsigned long) server->rxRing;
+  reg.ring_entries = HTTP_URING_RX_BUFFERS;
+  reg.bgid = RX_GROUP;
+  if (0 > syscall(__NR_io_uring_register, server->ring.fd,
+          IORING_REGISTER_PBUF_RING, &reg, 1))
+  {
+    HttpUring_Close(server);
+    return -1;
+  }
+  for (i = 0U; i < HTTP_URING_RX_BUFFERS; i++)
+  {
+    UringPort_RecycleRx(server, (unsigned short) i);
+  }
+
+  /* Whole transmit area is a single registered buffer (index 0) */
+  iov.iov_base = server->txArea;
+  iov.iov_len = (size_t) HTTP_URING_TX_BUFFERS * HTTP_URING_TX_LENGTH;
+  if (0 > syscall(__NR_io_uring_register, server->ring.fd,
+          IORING_REGISTER_BUFFERS, &iov, 1))
+  {
+    /* e.g. RLIMIT_MEMLOCK on older kernels - plain sends still work */
+    server->sendOpcode = IORING_OP_SEND;
+  }
+
+  UringPort_ArmAccept(server);
+
+  return 0;
+}
+
+int HttpUring_Poll(
+    tHttpUringServer *const server)
+{
+  struct io_uring_cqe cqe;
+  int count = 0;
+
+  if (0 > Ring_Enter(&(server->ring), 1U, -1) &&
+      EINTR != errno && EBUSY != errno)
+  {
+    return -1;
+  }
+
+  while (0 != Ring_Reap(&(server->ring), &cqe))
+  {
+    UringPort_Dispatch(server, &cqe);
+    ++count;
+  }
+
+  return count;
+}
+
+void HttpUring_Run(
+    tHttpUringServer *const server)
+{
+  while (server->running)
+  {
+    if (0 > HttpUring_Poll(server))
+    {
+      break;
+    }
+  }
+}
+
+void HttpUring_Stop(
+    tHttpUringServer *const server)
+{
+  server->running = 0;
+}
+
+void HttpUring_Close(
+    tHttpUringServer *const server)
+{
+  tHttpUringRing *const ring = &(server->ring);
+  unsigned int i;
+
+  for (i = 0U; i < server->poolLength; i++)
+  {
+    if (0 <= server->pool[i].fd)
+    {
+      close(server->pool[i].fd);
+      server->pool[i].fd = -1;
+      UringPort_Empty(&(server->pool[i].spill));
+      UringPort_Empty(&(server->pool[i].held));
+    }
+  }
+  server->waitHead = NULL;
+  server->waitTail = NULL;
+  if (0 <= ring->fd)
+  {
+    close(ring->fd);
+    ring->fd = -1;
+  }
+  if (NULL != ring->sqes && MAP_FAILED != ring->sqes)
+  {
+    munmap(ring->sqes, ring->sqesSize);
+  }
+  if (NULL != ring->cqRing && MAP_FAILED != ring->cqRing &&
+      ring->cqRing != ring->sqRing)
+  {
+    munmap(ring->cqRing, ring->cqRingSize);
+  }
+  if (NULL != ring->sqRing && MAP_FAILED != ring->sqRing)
+  {
+    munmap(ring->sqRing, ring->sqRingSize);
+  }
+  if (NULL != server->rxArea && MAP_FAILED != server->rxArea)
+  {
+    munmap(server->rxArea,
+        (size_t) HTTP_URING_RX_BUFFERS * HTTP_URING_RX_LENGTH);
+  }
+  if (NULL != server->rxRing && MAP_FAILED != (void *) server->rxRing)
+  {
+    munmap(server->rxRing,
+        HTTP_URING_RX_BUFFERS * sizeof(struct io_uring_buf));
+  }
+  if (NULL != server->txArea && MAP_FAILED != server->txArea)
+  {
+    munmap(server->txArea,
+        (size_t) HTTP_URING_TX_BUFFERS * HTTP_URING_TX_LENGTH);
+  }
+  ring->sqes = NULL;
+  ring->sqRing = NULL;
+  ring->cqRing = NULL;
+  server->rxArea = NULL;
+  server->rxRing = NULL;
+  server->txArea = NULL;
+}
+
+/*****************************************************************************/
+/* Ring                                                                      */
+/*****************************************************************************/
+
+static int Ring_Setup(
+    tHttpUringRing *const ring,
+    unsigned int flags)
+{
+  struct io_uring_params params;
+  char *sq;
+  char *cq;
+  unsigned int i;
+
+  memset(&params, 0, sizeof(params));
+  params.flags = flags | IORING_SETUP_CQSIZE;
+  params.cq_entries = HTTP_URING_ENTRIES * 4U;
+  params.sq_thread_idle = 1000U;
+
+  ring->fd = (int) syscall(__NR_io_uring_setup, HTTP_URING_ENTRIES, &params);
+  if (0 > ring->fd)
+  {
+    return -1;
+  }
+
+  ring->sqRingSize = params.sq_off.array +
+      params.sq_entries * sizeof(unsigned int);
+  ring->cqRingSize = params.cq_off.cqes +
+      params.cq_entries * sizeof(struct io_uring_cqe);
+  if (params.features & IORING_FEAT_SINGLE_MMAP)
+  {
+    if (ring->cqRingSize > ring->sqRingSize)
+    {
+      ring->sqRingSize = ring->cqRingSize;
+    }
+    ring->cqRingSize = ring->sqRingSize;
+  }
+
+  ring->sqRing = mmap(NULL, ring->sqRingSize, PROT_READ | PROT_WRITE,
+      MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+  if (MAP_FAILED == ring->sqRing)
+  {
+    return -1;
+  }
+  if (params.features & IORING_FEAT_SINGLE_MMAP)
+  {
+    ring->cqRing = ring->sqRing;
+  }
+  else
+  {
+    ring->cqRing = mmap(NULL, ring->cqRingSize, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_CQ_RING);
+    if (MAP_FAILED == ring->cqRing)
+    {
+      return -1;
+    }
+  }
+  ring->sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+  ring->sqes = mmap(NULL, ring->sqesSize, PROT_READ | PROT_WRITE,
+      MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+  if (MAP_FAILED == ring->sqes)
+  {
+    return -1;
+  }
+
+  sq = ring->sqRing;
+  cq = ring->cqRing;
+  ring->sqHead = (unsigned int *) (sq + params.sq_off.head);
+  ring->sqTail = (unsigned int *) (sq + params.sq_off.tail);
+  ring->sqFlags = (unsigned int *) (sq + params.sq_off.flags);
+  ring->sqMask = *(unsigned int *) (sq + params.sq_off.ring_mask);
+  ring->sqEntries = params.sq_entries;
+  ring->sqLocalTail = *(ring->sqTail);
+  ring->sqSubmitted = ring->sqLocalTail;
+  ring->cqHead = (unsigned int *) (cq + params.cq_off.head);
+  ring->cqTail = (unsigned int *) (cq + params.cq_off.tail);
+  ring->cqMask = *(unsigned int *) (cq + params.cq_off.ring_mask);
+  ring->cqes = (struct io_uring_cqe *) (cq + params.cq_off.cqes);
+
+  /* Entries are always used in order, index array is an identity */
+  for (i = 0U; i < params.sq_entries; i++)
+  {
+    ((unsigned int *) (sq + params.sq_off.array))[i] = i;
+  }
+
+  return 0;
+}
+
+static unsigned int Ring_Space(
+    tHttpUringRing *const ring)
+{
+  return ring->sqEntries - (ring->sqLocalTail -
+      __atomic_load_n(ring->sqHead, __ATOMIC_ACQUIRE));
+}
+
+static struct io_uring_sqe *Ring_GetSqe(
+    tHttpUringRing *const ring)
+{
+  struct io_uring_sqe *sqe;
+
+  while (0U == Ring_Space(ring))
+  {
+    Ring_Enter(ring, 0U, 0);
+  }
+
+  sqe = &(ring->sqes[ring->sqLocalTail & ring->sqMask]);
+  memset(sqe, 0, sizeof(*sqe));
+  ++(ring->sqLocalTail);
+
+  return sqe;
+}
+
+static int Ring_Enter(
+    tHttpUringRing *const ring,
+    unsigned int wait,
+    int timeout)
+{
+  struct io_uring_getevents_arg arg;
+  struct __kernel_timespec ts;
+  unsigned int submit = ring->sqLocalTail - ring->sqSubmitted;
+  unsigned int flags = 0U;
+  void *argp = NULL;
+  size_t argsz = 0U;
+
+  __atomic_store_n(ring->sqTail, ring->sqLocalTail, __ATOMIC_RELEASE);
+  ring->sqSubmitted = ring->sqLocalTail;
+
+#if HTTP_URING_SQPOLL
+  /* Kernel thread consumes entries, enter only to wake it up or wait */
+  if (__atomic_load_n(ring->sqFlags, __ATOMIC_ACQUIRE) &
+      IORING_SQ_NEED_WAKEUP)
+  {
+    flags |= IORING_ENTER_SQ_WAKEUP;
+  }
+  if (0U != submit && 0U == Ring_Space(ring))
+  {
+    flags |= IORING_ENTER_SQ_WAIT;
+  }
+#else
+  if (0U == submit && 0U == wait)
+  {
+    return 0;
+  }
+#endif
+
+  if (wait)
+  {
+    flags |= IORING_ENTER_GETEVENTS;
+    if (0 <= timeout)
+    {
+      ts.tv_sec = timeout / 1000;
+      ts.tv_nsec = (timeout % 1000) * 1000000L;
+      memset(&arg, 0, sizeof(arg));
+      arg.ts = (unsigned long) &ts;
+      argp = &arg;
+      argsz = sizeof(arg);
+      flags |= IORING_ENTER_EXT_ARG;
+    }
+  }
+  if (0U == flags)
+  {
+    return 0;
+  }
+
+  return (int) syscall(__NR_io_uring_enter, ring->fd, submit, wait ? 1U : 0U,
+      flags, argp, argsz);
+}
+
+static int Ring_Reap(
+    tHttpUringRing *const ring,
+    struct io_uring_cqe *cqe)
+{
+  unsigned int head = *(ring->cqHead);
+
+  if (head == __atomic_load_n(ring->cqTail, __ATOMIC_ACQUIRE))
+  {
+    return 0;
+  }
+
+  /* Entry is copied out, handlers may reap further while it is processed */
+  *cqe = ring->cqes[head & ring->cqMask];
+  __atomic_store_n(ring->cqHead, head + 1U, __ATOMIC_RELEASE);
+
+  return 1;
+}
+
+/*****************************************************************************/
+/* Port callbacks                                                            */
+/*****************************************************************************/
+
+static char *UringPort_Acquire(
+    void *const conn,
+    unsigned int *length)
+{
+  tHttpUringConnection *const c = Http_HelperGetContext(conn);
+  tHttpUringServer *const server = c->server;
+  tHttpUringTx *tx = server->txFree;
+
+  /* Out of buffers or behind spilled output - engine copies through send */
+  if (2U <= c->closing || c->waiting || NULL == tx)
+  {
+    return NULL;
+  }
+
+  server->txFree = tx->next;
+  tx->next = NULL;
+  tx->conn = c;
+  *length = HTTP_URING_TX_LENGTH;
+
+  return server->txArea + (size_t) (tx - server->tx) * HTTP_URING_TX_LENGTH;
+}
+
+static void UringPort_Commit(
+    void *const conn,
+    const char *data,
+    unsigned int length)
+{
+  tHttpUringConnection *const c = Http_HelperGetContext(conn);
+  tHttpUringServer *const server = c->server;
+  tHttpUringTx *tx;
+  size_t offset;
+
+  offset = (size_t) (data - server->txArea);
+  tx = &(server->tx[offset / HTTP_URING_TX_LENGTH]);
+  if (0U == length || 2U <= c->closing)
+  {
+    UringPort_ReleaseTx(server, tx);
+    return;
+  }
+
+  tx->offset = (unsigned int) (offset % HTTP_URING_TX_LENGTH);
+  tx->length = length;
+  tx->next = NULL;
+  if (NULL == c->queueTail)
+  {
+    c->queueHead = tx;
+  }
+  else
+  {
+    c->queueTail->next = tx;
+  }
+  c->queueTail = tx;
+
+  /* Next chain is started by completion of the current one */
+  if (0U == c->inFlight)
+  {
+    UringPort_SubmitChain(c);
+  }
+}
+
+static unsigned int UringPort_Send(
+    void *const conn,
+    const char *data,
+    unsigned int length)
+{
+  tHttpUringConnection *const c = Http_HelperGetContext(conn);
+  unsigned int left = length;
+
+  /* Plain send contract on top of the transmit buffers */
+  while (left)
+  {
+    unsigned int room;
+    char *region = UringPort_Acquire(conn, &room);
+
+    if (NULL == region)
+    {
+      break;
+    }
+    if (room > left)
+    {
+      room = left;
+    }
+    memcpy(region, data, room);
+    UringPort_Commit(conn, region, room);
+    data += room;
+    left -= room;
+  }
+
+  if (0U < left && 2U > c->closing)
+  {
+    /* Never waits for completions - rest goes out as buffers return */
+    if (0 > UringPort_Append(&(c->spill), data, left))
+    {
+      c->closing = 2U;
+    }
+    else if (0U == c->waiting)
+    {
+      UringPort_Wait(c);
+    }
+  }
+
+  return length;
+}
+
+static void UringPort_Error(
+    void *const conn,
+    const tErrorInfo *errorInfo)
+{
+  tHttpUringConnection *const c = Http_HelperGetContext(conn);
+
+  Http_HelperSetResponseStatus(conn, errorInfo->status);
+  Http_HelperSetResponseHeader(conn, "Content-Length", "0");
+  Http_HelperSetResponseHeader(conn, "Connection", "close");
+  Http_HelperSend(conn, "\r\n", 2);
+  Http_HelperFlush(conn);
+
+  /* Rest of the stream cannot be trusted */
+  if (0U == c->closing)
+  {
+    c->closing = 1U;
+  }
+}
+
+/*****************************************************************************/
+/* Local functions (definitions)                                             */
+/*****************************************************************************/
+
+static void UringPort_ArmAccept(
+    tHttpUringServer *const server)
+{
+  struct io_uring_sqe *sqe = Ring_GetSqe(&(server->ring));
+
+  sqe->opcode = IORING_OP_ACCEPT;
+  sqe->fd = server->listenFd;
+  sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+  sqe->accept_flags = SOCK_CLOEXEC;
+  sqe->user_data = TAG_ACCEPT;
+}
+
+static void UringPort_ArmRecv(
+    tHttpUringConnection *const c)
+{
+  struct io_uring_sqe *sqe = Ring_GetSqe(&(c->server->ring));
+
+  sqe->opcode = IORING_OP_RECV;
+  sqe->fd = c->fd;
+  sqe->ioprio = IORING_RECV_MULTISHOT;
+  sqe->flags = IOSQE_BUFFER_SELECT;
+  sqe->buf_group = RX_GROUP;
+  sqe->user_data = (unsigned long) c | TAG_RECV;
+  c->recvArmed = 1U;
+}
+
+static void UringPort_SubmitChain(
+    tHttpUringConnection *const c)
+{
+  tHttpUringServer *const server = c->server;
+  tHttpUringRing *const ring = &(server->ring);
+  struct io_uring_sqe *previous = NULL;
+  unsigned int links = HTTP_URING_LINK_MAX;
+
+  /* Chain must not be split by an implicit submission */
+  if (Ring_Space(ring) < links)
+  {
+    Ring_Enter(ring, 0U, 0);
+    if (Ring_Space(ring) < links)
+    {
+      links = Ring_Space(ring);
+    }
+  }
+
+  while (NULL != c->queueHead && 0U < links)
+  {
+    tHttpUringTx *tx = c->queueHead;
+    struct io_uring_sqe *sqe = Ring_GetSqe(ring);
+
+    c->queueHead = tx->next;
+    if (NULL == c->queueHead)
+    {
+      c->queueTail = NULL;
+    }
+
+    /* Waitall makes kernel retry short sends, links keep the order */
+    sqe->opcode = server->sendOpcode;
+    sqe->fd = c->fd;
+    sqe->addr = (unsigned long) (server->txArea +
+        (size_t) (tx - server->tx) * HTTP_URING_TX_LENGTH + tx->offset);
+    sqe->len = tx->length;
+    sqe->msg_flags = MSG_WAITALL | MSG_NOSIGNAL;
+    if (IORING_OP_SEND_ZC == server->sendOpcode)
+    {
+      sqe->ioprio = IORING_RECVSEND_FIXED_BUF;
+      sqe->buf_index = 0U;
+    }
+    sqe->user_data = (unsigned long) tx | TAG_SEND;
+    if (NULL != previous)
+    {
+      previous->flags |= IOSQE_IO_LINK;
+    }
+    previous = sqe;
+    ++(c->inFlight);
+    --links;
+  }
+}
+
+static void UringPort_RecycleRx(
+    tHttpUringServer *const server,
+    unsigned short bid)
+{
+  struct io_uring_buf *buf = &(server->rxRing->bufs[server->rxTail &
+          (HTTP_URING_RX_BUFFERS - 1U)]);
+
+  buf->addr = (unsigned long) (server->rxArea +
+      (size_t) bid * HTTP_URING_RX_LENGTH);
+  buf->len = HTTP_URING_RX_LENGTH;
+  buf->bid = bid;
+  ++(server->rxTail);
+  __atomic_store_n(&(server->rxRing->tail), server->rxTail,
+      __ATOMIC_RELEASE);
+}
+
+static void UringPort_ReleaseTx(
+    tHttpUringServer *const server,
+    tHttpUringTx *tx)
+{
+  tx->next = server->txFree;
+  server->txFree = tx;
+}
+
+static int UringPort_Append(
+    tHttpUringQueue *const queue,
+    const char *data,
+    unsigned int length)
+{
+  if (queue->head == queue->tail)
+  {
+    queue->head = 0U;
+    queue->tail = 0U;
+  }
+  else if (queue->length - queue->tail < length && 0U < queue->head)
+  {
+    memmove(queue->data, queue->data + queue->head,
+        queue->tail - queue->head);
+    queue->tail -= queue->head;
+    queue->head = 0U;
+  }
+
+  if (HTTP_URING_SPILL_MAX - queue->tail < length)
+  {
+    return -1;
+  }
+  if (queue->length - queue->tail < length)
+  {
+    unsigned int size = (0U < queue->length) ? queue->length :
+        HTTP_URING_TX_LENGTH;
+    char *grown;
+
+    while (size - queue->tail < length)
+    {
+      size *= 2U;
+    }
+    if (HTTP_URING_SPILL_MAX < size)
+    {
+      size = HTTP_URING_SPILL_MAX;
+    }
+    grown = realloc(queue->data, size);
+    if (NULL == grown)
+    {
+      return -1;
+    }
+    queue->data = grown;
+    queue->length = size;
+  }
+
+  memcpy(queue->data + queue->tail, data, length);
+  queue->tail += length;
+  return 0;
+}
+
+static void UringPort_Empty(
+    tHttpUringQueue *const queue)
+{
+  free(queue->data);
+  queue->data = NULL;
+  queue->head = 0U;
+  queue->tail = 0U;
+  queue->length = 0U;
+}
+
+static void UringPort_Wait(
+    tHttpUringConnection *const c)
+{
+  tHttpUringServer *const server = c->server;
+
+  c->waiting = 1U;
+  c->waitNext = NULL;
+  if (NULL == server->waitTail)
+  {
+    server->waitHead = c;
+  }
+  else
+  {
+    server->waitTail->waitNext = c;
+  }
+  server->waitTail = c;
+}
+
+static void UringPort_Unwait(
+    tHttpUringConnection *const c)
+{
+  tHttpUringServer *const server = c->server;
+  tHttpUringConnection *previous = NULL;
+  tHttpUringConnection *i = server->waitHead;
+
+  /* Failed connections only - the list is otherwise served in order */
+  while (NULL != i && c != i)
+  {
+    previous = i;
+    i = i->waitNext;
+  }
+  if (NULL != i)
+  {
+    if (NULL == previous)
+    {
+      server->waitHead = c->waitNext;
+    }
+    else
+    {
+      previous->waitNext = c->waitNext;
+    }
+    if (server->waitTail == c)
+    {
+      server->waitTail = previous;
+    }
+  }
+  c->waiting = 0U;
+  UringPort_Empty(&(c->spill));
+}
+
+static void UringPort_Refill(
+    tHttpUringServer *const server)
+{
+  while (NULL != server->waitHead && NULL != server->txFree)
+  {
+    tHttpUringConnection *const c = server->waitHead;
+    tHttpUringQueue held;
+
+    /* Spilled output is older than anything the connection renders next */
+    while (c->spill.head != c->spill.tail && NULL != server->txFree)
+    {
+      tHttpUringTx *tx = server->txFree;
+      char *region = server->txArea +
+          (size_t) (tx - server->tx) * HTTP_URING_TX_LENGTH;
+      unsigned int length = c->spill.tail - c->spill.head;
+
+      if (HTTP_URING_TX_LENGTH < length)
+      {
+        length = HTTP_URING_TX_LENGTH;
+      }
+      server->txFree = tx->next;
+      tx->next = NULL;
+      tx->conn = c;
+      memcpy(region, c->spill.data + c->spill.head, length);
+      c->spill.head += length;
+      UringPort_Commit(c, region, length);
+    }
+    if (c->spill.head != c->spill.tail)
+    {
+      break;
+    }
+
+    server->waitHead = c->waitNext;
+    if (NULL == server->waitHead)
+    {
+      server->waitTail = NULL;
+    }
+    c->waiting = 0U;
+    UringPort_Empty(&(c->spill));
+
+    /* Input received while output waited is parsed now, what is left is
+     * held again if the connection spills once more */
+    held = c->held;
+    c->held.data = NULL;
+    c->held.head = 0U;
+    c->held.tail = 0U;
+    c->held.length = 0U;
+    if (NULL != held.data)
+    {
+      UringPort_Input(c, held.data + held.head, held.tail - held.head);
+      free(held.data);
+    }
+    else
+    {
+      UringPort_Input(c, NULL, 0U);
+    }
+    UringPort_Finalize(c);
+  }
+}
+
+static void UringPort_Input(
+    tHttpUringConnection *const c,
+    const char *data,
+    unsigned int length)
+{
+  while (0U == c->closing)
+  {
+    unsigned int requests = 1U;
+    unsigned int consumed;
+
+#if HTTP_RESOURCE_CONTINUATION
+    /* No scheduler here - yielded responses continue until they spill */
+    if (Http_HasContinuation(&(c->state)))
+    {
+      if (c->waiting)
+      {
+        break;
+      }
+      Http_Continue(&(c->state));
+      continue;
+    }
+#endif
+    if (0U == length || c->waiting)
+    {
+      break;
+    }
+
+    /* One request at a time, parsing stops once its output spilled */
+    consumed = Http_InputBudget(&(c->state), data, length, &requests);
+    data += consumed;
+    length -= consumed;
+    if (1U == Http_ShouldClose(&(c->state)))
+    {
+      /* Response said close, pending output is still delivered */
+      c->closing = 1U;
+    }
+  }
+
+  if (0U < length && 0U == c->closing &&
+      0 > UringPort_Append(&(c->held), data, length))
+  {
+    c->closing = 2U;
+  }
+}
+
+static void UringPort_Dispatch(
+    tHttpUringServer *const server,
+    const struct io_uring_cqe *cqe)
+{
+  void *owner = (void *) (unsigned long) (cqe->user_data & ~TAG_MASK);
+
+  switch (cqe->user_data & TAG_MASK)
+  {
+  case TAG_ACCEPT:
+    UringPort_OnAccept(server, cqe);
+    break;
+  case TAG_RECV:
+    UringPort_OnRecv(owner, cqe);
+    UringPort_Finalize(owner);
+    break;
+  case TAG_SEND:
+  {
+    tHttpUringConnection *c = ((tHttpUringTx *) owner)->conn;
+
+    UringPort_OnSend(owner, cqe);
+    UringPort_Finalize(c);
+    UringPort_Refill(server);
+    break;
+  }
+  default:
+    break;
+  }
+}
+
+static void UringPort_OnAccept(
+    tHttpUringServer *const server,
+    const struct io_uring_cqe *cqe)
+{
+  if (0 <= cqe->res)
+  {
+    tHttpUringConnection *c = server->freeList;
+    int enable = 1;
+
+    if (NULL == c)
+    {
+      /* Pool exhausted - shed the connection */
+      close(cqe->res);
+    }
+    else
+    {
+      server->freeList = c->next;
+      c->next = NULL;
+      c->fd = cqe->res;
+      c->closing = 0U;
+      c->shut = 0U;
+      c->inFlight = 0U;
+      c->queueHead = NULL;
+      c->queueTail = NULL;
+      c->waitNext = NULL;
+      c->waiting = 0U;
+      setsockopt(c->fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+      Http_InitializeConnection(&(c->state), &UringPort_Send,
+          &UringPort_Error, server->resources, server->resourcesLength, c);
+      Http_InitializeTransmitBuffer(&(c->state), &UringPort_Acquire,
+          &UringPort_Commit);
+      UringPort_ArmRecv(c);
+      ++(server->active);
+    }
+  }
+
+  if (0 == (cqe->flags & IORING_CQE_F_MORE) && server->running)
+  {
+    UringPort_ArmAccept(server);
+  }
+}
+
+static void UringPort_OnRecv(
+    tHttpUringConnection *const c,
+    const struct io_uring_cqe *cqe)
+{
+  if (0 == (cqe->flags & IORING_CQE_F_MORE))
+  {
+    c->recvArmed = 0U;
+  }
+
+  if (0 < cqe->res)
+  {
+    unsigned short bid =
+        (unsigned short) (cqe->flags >> IORING_CQE_BUFFER_SHIFT);
+
+    const char *data =
+        c->server->rxArea + (size_t) bid * HTTP_URING_RX_LENGTH;
+
+    if (0U != c->closing)
+    {
+      /* Input after the closing response is discarded */
+    }
+    else if (c->waiting || c->held.head != c->held.tail)
+    {
+      /* Output waits for tx buffers - input queues behind it */
+      if (0 > UringPort_Append(&(c->held), data, (unsigned int) cqe->res))
+      {
+        c->closing = 2U;
+      }
+    }
+    else
+    {
+      UringPort_Input(c, data, (unsigned int) cqe->res);
+    }
+    UringPort_RecycleRx(c->server, bid);
+  }
+  else if (0 == cqe->res)
+  {
+    /* Peer finished sending, pending output is still delivered */
+    if (0U == c->closing)
+    {
+      c->closing = 1U;
+    }
+  }
+  else if (-ENOBUFS != cqe->res)
+  {
+    c->closing = 2U;
+  }
+
+  if (0U == c->recvArmed && 0U == c->closing)
+  {
+    UringPort_ArmRecv(c);
+  }
+}
+
+static void UringPort_OnSend(
+    tHttpUringTx *const tx,
+    const struct io_uring_cqe *cqe)
+{
+  tHttpUringConnection *const c = tx->conn;
+
+  if (0 == (cqe->flags & IORING_CQE_F_NOTIF) && 0 > cqe->res)
+  {
+    c->closing = 2U;
+  }
+  if (cqe->flags & IORING_CQE_F_MORE)
+  {
+    /* Zero-copy notification follows, buffer is still owned by kernel */
+    return;
+  }
+
+  UringPort_ReleaseTx(c->server, tx);
+  --(c->inFlight);
+  if (0U == c->inFlight && NULL != c->queueHead && 2U > c->closing)
+  {
+    UringPort_SubmitChain(c);
+  }
+}
+
+static void UringPort_Finalize(
+    tHttpUringConnection *const c)
+{
+  tHttpUringServer *const server = c->server;
+
+  if (0 > c->fd || 0U == c->closing)
+  {
+    return;
+  }
+
+  /* Shutdown terminates multishot receive and outstanding sends */
+  if (0U == c->shut && (2U <= c->closing || (0U == c->inFlight &&
+          NULL == c->queueHead && 0U == c->waiting)))
+  {
+    shutdown(c->fd, SHUT_RDWR);
+    c->shut = 1U;
+  }
+
+  if (c->shut && 0U == c->recvArmed && 0U == c->inFlight)
+  {
+    while (NULL != c->queueHead)
+    {
+      tHttpUringTx *tx = c->queueHead;
+
+      c->queueHead = tx->next;
+      UringPort_ReleaseTx(server, tx);
+    }
+    c->queueTail = NULL;
+    if (c->waiting)
+    {
+      UringPort_Unwait(c);
+    }
+    UringPort_Empty(&(c->held));
+    close(c->fd);
+    c->fd = -1;
+    c->next = server->freeList;
+    server->freeList = c;
+    --(server->active);
+  }
+}
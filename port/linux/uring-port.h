@@ -0,0 +1,218 @@
+/*
+ uring-port.h
+
+ MIT License
+
+ Copyright (c) 2026 uChttpserver contributors
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+  Created on: Oct 18, 2026
+      Author: uChttpserver contributors
+ */
+
+#ifndef URING_PORT_H_
+#define URING_PORT_H_
+
+/*****************************************************************************/
+/* Includes                                                                  */
+/*****************************************************************************/
+
+#include "uchttpserver.h"
+#include "linux-port.h"
+
+#include <linux/io_uring.h>
+
+#if !HTTP_ZERO_COPY_RESPONSE
+#error "io_uring port renders responses into registered buffers"
+#endif
+
+/*****************************************************************************/
+/* Options                                                                   */
+/*****************************************************************************/
+
+/* Submission queue length, completion queue is four times longer */
+#ifndef HTTP_URING_ENTRIES
+#define HTTP_URING_ENTRIES (1024)
+#endif
+
+/* Provided receive buffers, power of two */
+#ifndef HTTP_URING_RX_BUFFERS
+#define HTTP_URING_RX_BUFFERS (1024)
+#endif
+
+#ifndef HTTP_URING_RX_LENGTH
+#define HTTP_URING_RX_LENGTH (4096)
+#endif
+
+/* Registered transmit buffers shared by all connections */
+#ifndef HTTP_URING_TX_BUFFERS
+#define HTTP_URING_TX_BUFFERS (1024)
+#endif
+
+#ifndef HTTP_URING_TX_LENGTH
+#define HTTP_URING_TX_LENGTH (16384)
+#endif
+
+/* Longest chain of linked sends submitted at once */
+#ifndef HTTP_URING_LINK_MAX
+#define HTTP_URING_LINK_MAX (16)
+#endif
+
+/* Kernel side submission polling, no syscalls while busy */
+#ifndef HTTP_URING_SQPOLL
+#define HTTP_URING_SQPOLL (0)
+#endif
+
+/* Output kept on heap per connection while transmit buffers run out, and
+ * input received meanwhile - connection fails above it */
+#ifndef HTTP_URING_SPILL_MAX
+#define HTTP_URING_SPILL_MAX (1048576)
+#endif
+
+/*****************************************************************************/
+/* Type definitions                                                          */
+/*****************************************************************************/
+
+struct HttpUringServer;
+struct HttpUringConnection;
+
+typedef struct HttpUringTx
+{
+  struct HttpUringTx *next;
+  struct HttpUringConnection *conn;
+  unsigned int offset;
+  unsigned int length;
+} tHttpUringTx;
+
+typedef struct HttpUringQueue
+{
+  char *data;                    /* Heap, released once empty */
+  unsigned int head;
+  unsigned int tail;
+  unsigned int length;
+} tHttpUringQueue;
+
+typedef struct HttpUringConnection
+{
+  tuCHttpServerState state;
+  struct HttpUringServer *server;
+  struct HttpUringConnection *next;     /* Free list */
+  int fd;
+  unsigned char closing;         /* 1 - after pending output, 2 - now */
+  unsigned char shut;
+  unsigned char recvArmed;
+  unsigned int inFlight;         /* Sends not completed by kernel */
+  tHttpUringTx *queueHead;       /* Committed, waiting for the chain */
+  tHttpUringTx *queueTail;
+  struct HttpUringConnection *waitNext;
+  unsigned char waiting;         /* Output spilled, waits for tx buffers */
+  tHttpUringQueue spill;         /* Output not rendered into tx buffers */
+  tHttpUringQueue held;          /* Input not parsed while output waits */
+} tHttpUringConnection;
+
+typedef struct HttpUringRing
+{
+  int fd;
+  unsigned int *sqHead;
+  unsigned int *sqTail;
+  unsigned int *sqFlags;
+  unsigned int sqMask;
+  unsigned int sqEntries;
+  unsigned int sqLocalTail;
+  unsigned int sqSubmitted;
+  struct io_uring_sqe *sqes;
+  unsigned int *cqHead;
+  unsigned int *cqTail;
+  unsigned int cqMask;
+  struct io_uring_cqe *cqes;
+  void *sqRing;
+  unsigned long sqRingSize;
+  void *cqRing;
+  unsigned long cqRingSize;
+  unsigned long sqesSize;
+} tHttpUringRing;
+
+typedef struct HttpUringServer
+{
+  tHttpUringRing ring;
+  int listenFd;
+  volatile int running;
+  unsigned char sendOpcode;
+  tHttpUringConnection *pool;
+  unsigned int poolLength;
+  unsigned int active;
+  tHttpUringConnection *freeList;
+  const tResourceEntry (
+      *resources)[];
+  unsigned int resourcesLength;
+  struct io_uring_buf_ring *rxRing;
+  char *rxArea;
+  unsigned short rxTail;
+  char *txArea;
+  tHttpUringTx tx[HTTP_URING_TX_BUFFERS];
+  tHttpUringTx *txFree;
+  tHttpUringConnection *waitHead;       /* Served as tx buffers return */
+  tHttpUringConnection *waitTail;
+} tHttpUringServer;
+
+/*****************************************************************************/
+/* Linux port API                                                            */
+/*****************************************************************************/
+
+/**
+ * \brief Prepare io_uring serving connections from the given pool
+ * Listening socket is created with HttpLinux_Listen or equivalent
+ * \return 0 or -1 with errno set
+ */
+int HttpUring_Initialize(
+    tHttpUringServer *const server,
+    int listenFd,
+    tHttpUringConnection *pool,
+    unsigned int poolLength,
+    const tResourceEntry (*resources)[],
+    unsigned int reslen);
+
+/**
+ * \brief Submit prepared requests and process completions, waits for at
+ * least one completion
+ * \return number of processed completions or -1 with errno set
+ */
+int HttpUring_Poll(
+    tHttpUringServer *const server);
+
+/**
+ * \brief Run completion loop until HttpUring_Stop
+ */
+void HttpUring_Run(
+    tHttpUringServer *const server);
+
+/**
+ * \brief Request loop exit, async-signal-safe
+ */
+void HttpUring_Stop(
+    tHttpUringServer *const server);
+
+/**
+ * \brief Close all connections and release ring and buffers
+ */
+void HttpUring_Close(
+    tHttpUringServer *const server);
+
+#endif /* URING_PORT_H_ */
@@ -0,0 +1,168 @@
+/*
+ uchttpguard.c
+
+ MIT License
+
+ Copyright (c) 2026 uChttpserver contributors
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+  Created on: Oct 18, 2026
+      Author: uChttpserver contributors
+ */
+
+/*****************************************************************************/
+/* Includes                                                                  */
+/*****************************************************************************/
+
+#include "uchttpguard.h"
+
+/*****************************************************************************/
+/* Global functions                                                          */
+/*****************************************************************************/
+
+void HttpProgress_Initialize(
+    tHttpProgress *const progress,
+    unsigned long now)
+{
+  progress->requestStart = now;
+  progress->requestBytes = 0UL;
+  progress->windowStart = now;
+  progress->windowBytes = 0UL;
+  progress->phase = HTTP_PHASE_IDLE;
+}
+
+tHttpProgressVerdict HttpProgress_Update(
+    tHttpProgress *const progress,
+    const tHttpProgressPolicy *policy,
+    tuCHttpServerState *const sm,
+    unsigned int bytes,
+    unsigned long now)
+{
+  tHttpPhase phase = Http_HelperGetPhase(sm);
+
+  if (HTTP_PHASE_IDLE == progress->phase)
+  {
+    /* Request starts with its first input, waiting for it is not slow */
+    progress->requestStart = now;
+    progress->requestBytes = 0UL;
+    progress->windowStart = now;
+    progress->windowBytes = 0UL;
+  }
+  progress->requestBytes += bytes;
+  progress->windowBytes += bytes;
+
+  if (HTTP_PHASE_IDLE == phase || HTTP_PHASE_RESPONSE == phase)
+  {
+    /* Client part is over */
+    progress->phase = HTTP_PHASE_IDLE;
+    return HTTP_PROGRESS_OK;
+  }
+  progress->phase = phase;
+
+  if (0UL != policy->headTime && HTTP_PHASE_BODY != phase &&
+      policy->headTime < now - progress->requestStart)
+  {
+    return HTTP_PROGRESS_HEAD_TOO_LONG;
+  }
+
+  if (0UL != policy->minBytes && policy->window <= now - progress->windowStart)
+  {
+    if (progress->windowBytes < policy->minBytes)
+    {
+      return HTTP_PROGRESS_TOO_SLOW;
+    }
+    progress->windowStart = now;
+    progress->windowBytes = 0UL;
+  }
+
+  return HTTP_PROGRESS_OK;
+}
+
+void HttpTokenBucket_Initialize(
+    tHttpTokenBucket *const bucket,
+    const tHttpTokenRate *rate,
+    unsigned long now)
+{
+  bucket->credit = rate->burst * rate->ticks;
+  bucket->last = now;
+}
+
+unsigned char HttpTokenBucket_Take(
+    tHttpTokenBucket *const bucket,
+    const tHttpTokenRate *rate,
+    unsigned long now)
+{
+  unsigned long capacity = rate->burst * rate->ticks;
+  unsigned long elapsed = now - bucket->last;
+
+  if (0UL == rate->tokens)
+  {
+    return 1U;
+  }
+
+  /* Refill without overflowing on long pauses */
+  if (elapsed >= (capacity - bucket->credit) / rate->tokens + 1UL)
+  {
+    bucket->credit = capacity;
+  }
+  else
+  {
+    bucket->credit += elapsed * rate->tokens;
+  }
+  bucket->last = now;
+
+  if (bucket->credit < rate->ticks)
+  {
+    return 0U;
+  }
+  bucket->credit -= rate->ticks;
+  return 1U;
+}
+
+unsigned char HttpTokenBucket_TakeKeyed(
+    tHttpTokenBucket *const buckets,
+    unsigned int length,
+    const tHttpTokenRate *rate,
+    unsigned long key,
+    unsigned long now)
+{
+  /* Fibonacci hashing spreads adjacent addresses, colliding ones share
+   * the credit - starting them over would let a client cycling through
+   * keys of one slot past the limit */
+  return HttpTokenBucket_Take(
+      &(buckets[((key * 2654435761UL) & 0xFFFFFFFFUL) % length]), rate,
+      now);
+}
+
+unsigned long HttpProgress_Score(
+    const tHttpProgress *progress,
+    const tHttpProgressPolicy *policy,
+    unsigned long now)
+{
+  unsigned long elapsed = now - progress->requestStart;
+
+  if (HTTP_PHASE_IDLE == progress->phase || policy->window > elapsed)
+  {
+    return 0UL;
+  }
+
+  /* Eligible ones never score 0 */
+  return elapsed * 256UL / (progress->requestBytes + 1UL) + 1UL;
+}
@@ -37,6 +37,25 @@
 /* Defines                                                                   */
 /*****************************************************************************/
 
+/* Room reserved around chunk data, so framing is written in place           */
+#define CHUNK_PREFIX_LENGTH (10U)       /* 8 hex digits and CRLF */
+#define CHUNK_SUFFIX_LENGTH (7U)        /* CRLF and last-chunk with CRLF */
+
+/* Hot headers by how their value is decoded                                 */
+#define HEADERS_TOKENIZED (HTTP_HEADER_CONTENT_TYPE | \
+    HTTP_HEADER_TRANSFER_ENCODING | HTTP_HEADER_CONNECTION | \
+    HTTP_HEADER_EXPECT | HTTP_HEADER_ACCEPT_ENCODING)
+#define HEADERS_KEPT (HTTP_HEADER_CONTENT_TYPE | HTTP_HEADER_HOST | \
+    HTTP_HEADER_IF_NONE_MATCH | HTTP_HEADER_RANGE)
+
+/* Header engine element values besides the ones of headerTokens             */
+#define HEADER_VALUE_EMPTY (0x00U)
+#define HEADER_VALUE_UNKNOWN (0xFFU)
+
+#if HTTP_ZERO_COPY_RESPONSE && (1 < HTTP_RESPONSE_BUFFERS)
+#error "Transmit regions of the port and response ring are exclusive"
+#endif
+
 /*****************************************************************************/
 /* Type definitions                                                          */
 /*****************************************************************************/
@@ -63,6 +82,48 @@ typedef enum ParameterEngineResult
   PARAMETER_ENGINE_BUFFER_FULL
 } tParameterEngineResult;
 
+typedef struct HeaderToken
+{
+  unsigned short header;        /* HTTP_HEADER_* */
+  unsigned char value;
+  const char *token;
+} tHeaderToken;
+
+/* Index of Http_ProfileStateName too, states compiled out keep their IDs */
+typedef enum ParserStateId
+{
+  STATE_INIT_SEARCH_METHOD,
+  STATE_PARSE_METHOD,
+  STATE_POST_METHOD,
+  STATE_DETECT_URI,
+  STATE_PARSE_ABS_PATH_RESOURCE,
+  STATE_INITIALIZE_PARAMETER_ENGINE,
+  STATE_PARSE_RESOURCE_ENDING,
+  STATE_PARSE_URL_ENCODED_FORM_NAME,
+  STATE_PARSE_URL_ENCODED_FORM_VALUE,
+  STATE_PARSE_HTTP_VERSION,
+  STATE_CHECK_HEADER_END,
+  STATE_PARSE_PARAMETER_NAME,
+  STATE_PARSE_PARAMETER_VALUE,
+  STATE_ANALYZE_ENTITY,
+  STATE_PARSE_URL_ENCODED_ENTITY_NAME,
+  STATE_PARSE_URL_ENCODED_ENTITY_VALUE,
+  STATE_CALL_RESOURCE,
+  STATE_CALL_ERROR_CALLBACK,
+  STATE_DEFERRED_RESOURCE,
+  STATE_CONTINUE_RESOURCE,
+  STATE_REJECT_REQUEST,
+  STATE_DISCARD_REQUEST,
+  STATE_PARSE_HEADER_VALUE,
+  STATE_SKIP_ENTITY,
+  STATE_CONNECTION_CLOSED
+} tParserStateId;
+
+/* Run on state entry even with no input left */
+#define STATES_WITHOUT_INPUT ((1UL << STATE_ANALYZE_ENTITY) | \
+    (1UL << STATE_CALL_RESOURCE) | (1UL << STATE_CALL_ERROR_CALLBACK) | \
+    (1UL << STATE_REJECT_REQUEST))
+
 /*****************************************************************************/
 /* Connection states (declarations)                                          */
 /*****************************************************************************/
@@ -122,6 +183,10 @@ static unsigned int ParseParameterValueState(
     void *const sm,
     const char *data,
     unsigned int length);
+static unsigned int ParseHeaderValueState(
+    void *const sm,
+    const char *data,
+    unsigned int length);
 static unsigned int AnalyzeEntityState(
     void *const conn,
     const char *data,
@@ -134,15 +199,53 @@ static unsigned int ParseUrlEncodedEntityValue(
     void *const conn,
     const char *data,
     unsigned int length);
+static unsigned int SkipEntityState(
+    void *const conn,
+    const char *data,
+    unsigned int length);
 static unsigned int CallResourceState(
     void *const sm,
     const char *data,
     unsigned int length);
 
+#if HTTP_DEFERRED_RESOURCES
+static unsigned int DeferredResourceState(
+    void *const sm,
+    const char *data,
+    unsigned int length);
+#endif
+
+#if HTTP_RESOURCE_CONTINUATION
+static unsigned int ContinueResourceState(
+    void *const sm,
+    const char *data,
+    unsigned int length);
+#endif
+
 static unsigned int CallErrorCallbackState(
     void *const sm,
     const char *data,
     unsigned int length);
+static unsigned int ConnectionClosedState(
+    void *const sm,
+    const char *data,
+    unsigned int length);
+
+#if HTTP_ADMISSION_CONTROL
+static unsigned int RejectRequestState(
+    void *const sm,
+    const char *data,
+    unsigned int length);
+static unsigned int DiscardRequestState(
+    void *const sm,
+    const char *data,
+    unsigned int length);
+#endif
+
+static unsigned int Utils_Dispatch(
+    tuCHttpServerState *const sm,
+    const char *data,
+    unsigned int length);
 
 /*****************************************************************************/
 /* Local functions (declarations)                                            */
@@ -190,12 +293,25 @@ static unsigned int ResponseEntity_SendBuffered(
     unsigned int length);
 static void ResponseEntity_FlushBuffered(
     void *const ptr);
+static unsigned int ResponseEntity_SendHead(
+    void *const ptr,
+    const void *data,
+    unsigned int length);
 static unsigned int ResponseEntity_SendChunked(
     void *const ptr,
     const void *data,
     unsigned int length);
 static void ResponseEntity_FlushChunked(
     void *const ptr);
+static void ResponseEngine_Acquire(
+    tResponseEntity * const re);
+static void ResponseEngine_Commit(
+    tResponseEntity * const re,
+    unsigned int start);
+static void ResponseEngine_Release(
+    tResponseEntity * const re);
+static unsigned int ResponseEngine_FrameChunk(
+    tResponseEntity * const re);
 
 static void ParameterEngine_Init(
     tParameterEntity *const pe,
@@ -210,6 +326,23 @@ static tParameterEngineResult ParameterEngine_AddParameterValue(
 static tParameterEngineResult ParameterEngine_AddParameterCharacter(
     tParameterEntity *const pe,
     char ch);
+static const char *ParameterEngine_AddString(
+    tParameterEntity *const pe);
+static void ParameterEngine_Rewind(
+    tParameterEntity *const pe,
+    unsigned int bufferIdx);
+
+static void HeaderEngine_Init(
+    tHeaderEntity *const he);
+static unsigned char HeaderEngine_AddCharacter(
+    tHeaderEntity *const he,
+    char ch);
+static void HeaderEngine_Finish(
+    tHeaderEntity *const he);
+static void HeaderEngine_NextElement(
+    tHeaderEntity *const he);
+static void HeaderEngine_EndToken(
+    tHeaderEntity *const he);
 
 static const tStringWithLength *Utils_GetMethodByIdx(
     const void *arr,
@@ -222,6 +355,74 @@ static void Utils_MarkError(
     void *const conn,
     tErrorInfo info);
 
+static void Utils_RunResource(
+    tuCHttpServerState *const sm);
+static void Utils_ExpectContinue(
+    tuCHttpServerState *const sm);
+
+static void Utils_ResetHeaders(
+    tHttpHeaders *const headers);
+static unsigned short Utils_HotHeader(
+    const char *name);
+static const char *Utils_KeptHeader(
+    tuCHttpServerState *const sm,
+    unsigned short header);
+static void Utils_HeaderBegin(
+    tuCHttpServerState *const sm);
+static unsigned char Utils_HeaderCharacter(
+    tuCHttpServerState *const sm,
+    char ch);
+static void Utils_HeaderElement(
+    tuCHttpServerState *const sm);
+static void Utils_HeaderEnd(
+    tuCHttpServerState *const sm);
+
+#if HTTP_TRACING
+static void Utils_Trace(
+    tuCHttpServerState *const sm,
+    tHttpTraceType type,
+    unsigned char detail,
+    unsigned long arg);
+#endif
+
+#if HTTP_PROFILING
+static void Utils_ProfileAccount(
+    tHttpProfileCounter *counter,
+    unsigned long start);
+#endif
+
+#if HTTP_LATENCY_HISTOGRAMS || HTTP_BUFFER_STATISTICS
+static void Utils_AtomicMax(
+    unsigned long *counter,
+    unsigned long value);
+#endif
+
+#if HTTP_BUFFER_STATISTICS
+static void Utils_BufferAccount(
+    tuCHttpServerState *const sm,
+    const tHttpBufferStatistics *sample);
+#endif
+
+#if HTTP_METRICS
+static unsigned long Utils_MetricsSum(
+    const tHttpMetrics *metrics,
+    const unsigned long *counter);
+#if HTTP_BUFFER_STATISTICS
+static unsigned long Utils_MetricsMax(
+    const tHttpMetrics *metrics,
+    const unsigned long *counter);
+#endif
+static unsigned long Utils_MetricsSumResource(
+    const tHttpMetrics *metrics,
+    unsigned int idx);
+static void Utils_MetricsSample(
+    void *const conn,
+    const char *name,
+    const char *label,
+    unsigned int labelLength,
+    unsigned long value);
+#endif
+
 static unsigned char Utils_OnInitialization(
     void *const conn);
 
@@ -232,12 +433,18 @@ static unsigned int Utils_SearchNullTerminatedPattern(
     const char *pattern,
     const char *input);
 
+#if HTTP_TRACING
 static int Utils_AtoiNullTerminated(
     const char *str);
+#endif
 static unsigned int Utils_Uitoh(
     unsigned int num,
     char * buffer,
     unsigned int bufferLength);
+static unsigned int Utils_Uitoa(
+    unsigned long num,
+    char *buffer,
+    unsigned int bufferLength);
 
 static void Utils_PrintParameter(
     void *const conn,
@@ -259,20 +466,44 @@ static void Http_SendNullTerminatedPortWrapper(
 
 /*****************************************************************************/
 /* Local variables and constants                                             */
+/* - constants only, all mutable data belongs to tuCHttpServerState, so      */
+/*   connections served by different threads never share writable memory    */
+/*   (checked by the Linux port build)                                       */
 /*****************************************************************************/
 
-const tStringWithLength HTTP_VERSION = STRING_WITH_LENGTH("HTTP/1.1\r\n");
+static const tStringWithLength HTTP_VERSION =
+STRING_WITH_LENGTH("HTTP/1.1\r\n");
 
 /* fixme is '\r\n needed */
 
-const tStringWithLength SP = STRING_WITH_LENGTH(" ");
-const tStringWithLength CRLFwL = STRING_WITH_LENGTH("\r\n");    /* fixme name */
-const tStringWithLength QUESTION_MARK = STRING_WITH_LENGTH("?");
+static const tStringWithLength SP = STRING_WITH_LENGTH(" ");
+static const tStringWithLength CRLFwL = STRING_WITH_LENGTH("\r\n");     /* fixme name */
+
+#if HTTP_ADMISSION_CONTROL
+/* Rejection must cost less than serving, so it is never rendered */
+static const tStringWithLength SERVICE_UNAVAILABLE =
+STRING_WITH_LENGTH("HTTP/1.1 503 Service Unavailable\r\n"
+    "Retry-After: " HTTP_RETRY_AFTER "\r\n"
+    "Content-Length: 0\r\nConnection: close\r\n\r\n");
+#endif
+
+/* Interim response, body of the request follows */
+static const tStringWithLength CONTINUE =
+STRING_WITH_LENGTH("HTTP/1.1 100 Continue\r\n\r\n");
 
-const char CRLF[] = "\r\n";
-const char const ESCAPE_CHARACTER = '%';
+/* Empty line ending the header of a response */
+static const char HEADER_END[] = "\r\n\r\n";
 
-const tStringWithLength methods[8] = {
+/* Indexed by the close flag of the connection */
+static const tStringWithLength CONNECTION[2] = {
+  STRING_WITH_LENGTH("Connection: keep-alive\r\n"),
+  STRING_WITH_LENGTH("Connection: close\r\n")
+};
+
+static const char CRLF[] = "\r\n";
+static const char ESCAPE_CHARACTER = '%';
+
+static const tStringWithLength methods[8] = {
   STRING_WITH_LENGTH("CONNECT"),
   STRING_WITH_LENGTH("DELETE"),
   STRING_WITH_LENGTH("GET"),
@@ -283,20 +514,99 @@ const tStringWithLength methods[8] = {
   STRING_WITH_LENGTH("TRACE")
 };
 
-const char *statuscodes[][2] = {
+static const char *const statuscodes[][2] = {
   {"200", "OK"},
   {"100", "Continue"},
   {"400", "Bad Request"},
   {"403", "Forbidden"},
   {"404", "Not Found"},
+  {"408", "Request Timeout"},
   {"411", "Length Required"},
+  {"413", "Payload Too Large"},
   {"414", "Request-URI Too Long"},
+  {"417", "Expectation Failed"},
   {"431", "Request Header Fields Too Large"},
   {"500", "Server fault"},
   {"501", "Not Implemented"},
+  {"503", "Service Unavailable"},
   {"505", "Version not supported"}
 };
 
+/* Bit (1 << index) of HTTP_HEADER_*                                         */
+static const char *const hotHeaders[] = {
+  "Content-Length",
+  "Content-Type",
+  "Transfer-Encoding",
+  "Connection",
+  "Expect",
+  "Host",
+  "Accept-Encoding",
+  "If-None-Match",
+  "Range"
+};
+
+/* List element tokens told apart, compared without case                    */
+static const tHeaderToken headerTokens[] = {
+  {HTTP_HEADER_CONNECTION, HTTP_CONNECTION_CLOSE, "close"},
+  {HTTP_HEADER_CONNECTION, HTTP_CONNECTION_KEEP_ALIVE, "keep-alive"},
+  {HTTP_HEADER_CONNECTION, HTTP_CONNECTION_UPGRADE, "upgrade"},
+  {HTTP_HEADER_ACCEPT_ENCODING, HTTP_ENCODING_GZIP, "gzip"},
+  {HTTP_HEADER_ACCEPT_ENCODING, HTTP_ENCODING_DEFLATE, "deflate"},
+  {HTTP_HEADER_ACCEPT_ENCODING, HTTP_ENCODING_BR, "br"},
+  {HTTP_HEADER_EXPECT, HTTP_EXPECT_CONTINUE, "100-continue"},
+  {HTTP_HEADER_TRANSFER_ENCODING, 1U, "chunked"},
+  {HTTP_HEADER_CONTENT_TYPE, HTTP_MEDIA_FORM_URLENCODED,
+      "application/x-www-form-urlencoded"},
+  {HTTP_HEADER_CONTENT_TYPE, HTTP_MEDIA_MULTIPART_FORM_DATA,
+      "multipart/form-data"},
+  {HTTP_HEADER_CONTENT_TYPE, HTTP_MEDIA_JSON, "application/json"},
+  {HTTP_HEADER_CONTENT_TYPE, HTTP_MEDIA_OCTET_STREAM,
+      "application/octet-stream"},
+  {HTTP_HEADER_CONTENT_TYPE, HTTP_MEDIA_TEXT_PLAIN, "text/plain"}
+};
+
+#if HTTP_METRICS
+static const tStringWithLength sendBucketBounds[HTTP_METRICS_SEND_BUCKETS] = {
+  STRING_WITH_LENGTH("1"),
+  STRING_WITH_LENGTH("2"),
+  STRING_WITH_LENGTH("4"),
+  STRING_WITH_LENGTH("8"),
+  STRING_WITH_LENGTH("16"),
+  STRING_WITH_LENGTH("+Inf")
+};
+#endif
+
+#if HTTP_PROFILING
+/* Same order in every build, so counters keep their meaning */
+static const char *const stateNames[HTTP_PROFILE_STATES] = {
+  "InitSearchMethodState",
+  "ParseMethodState",
+  "PostMethodState",
+  "DetectUriState",
+  "ParseAbsPathResourceState",
+  "InitializeParameterEngine",
+  "ParseResourceEnding",
+  "ParseUrlEncodedFormName",
+  "ParseUrlEncodedFormValue",
+  "ParseHttpVersion",
+  "CheckHeaderEndState",
+  "ParseParameterNameState",
+  "ParseParameterValueState",
+  "AnalyzeEntityState",
+  "ParseUrlEncodedEntityName",
+  "ParseUrlEncodedEntityValue",
+  "CallResourceState",
+  "CallErrorCallbackState",
+  "DeferredResourceState",
+  "ContinueResourceState",
+  "RejectRequestState",
+  "DiscardRequestState",
+  "ParseHeaderValueState",
+  "SkipEntityState",
+  "ConnectionClosedState"
+};
+#endif
+
 /*****************************************************************************/
 /* Global connection functions                                               */
 /*****************************************************************************/
@@ -309,1157 +619,3025 @@ void Http_InitializeConnection(
     unsigned int reslen,
     void *context)
 {
-  sm->state = &InitSearchMethodState;
+  sm->state = STATE_INIT_SEARCH_METHOD;
+  sm->close = 0U;
+#if HTTP_KEEP_ALIVE_MAX_REQUESTS
+  sm->requests = 0U;
+#endif
+  Utils_ResetHeaders(&(sm->headers));
   sm->send = send;
   sm->onError = onError;
   sm->resources = resources;
   sm->resourcesLength = reslen;
   sm->context = context;
   sm->initialization = 1U;
+#if HTTP_DEFERRED_RESOURCES
+  sm->defer = NULL;
+#endif
+#if HTTP_ADMISSION_CONTROL
+  sm->admit = NULL;
+#endif
+#if HTTP_PROFILING
+  sm->profile = NULL;
+#endif
+#if HTTP_TRACING
+  sm->trace = NULL;
+  sm->traceId = 0U;
+#endif
+#if HTTP_METRICS
+  sm->metrics = NULL;
+#endif
+#if HTTP_LATENCY_HISTOGRAMS
+  sm->latencies = NULL;
+  sm->requestStart = 0UL;
+#endif
+#if HTTP_BUFFER_STATISTICS
+  sm->buffers.searchPeak = 0UL;
+  sm->buffers.parametersPeak = 0UL;
+  sm->buffers.slotsPeak = 0UL;
+  sm->buffers.responsePeak = 0UL;
+  sm->buffers.truncations = 0UL;
+#endif
+#if HTTP_RESOURCE_CONTINUATION
+  sm->cursor = 0UL;
+  sm->yielded = 0U;
+#endif
+#if HTTP_ZERO_COPY_RESPONSE
+  /* Until the port attaches regions everything goes to the send callback */
+  sm->acquire = NULL;
+  sm->commit = NULL;
+#endif
+#if 1 < HTTP_RESPONSE_BUFFERS
+  sm->ring.head = 0U;
+  sm->ring.committed = 0U;
+  sm->ring.released = 0U;
+#endif
 }
 
-void Http_Input(
+#if HTTP_ZERO_COPY_RESPONSE
+void Http_InitializeTransmitBuffer(
     tuCHttpServerState *const sm,
-    const char *data,
-    unsigned int length)
+    tAcquireCallback acquire,
+    tCommitCallback commit)
 {
-  unsigned int parsed;
+  sm->acquire = acquire;
+  sm->commit = commit;
+}
+#endif
 
-  while (length || (&CallResourceState == sm->state) ||
-      (&AnalyzeEntityState == sm->state))
-  {
-    tParserState previous = sm->state;
+#if 1 < HTTP_RESPONSE_BUFFERS
+void Http_OutputComplete(
+    tuCHttpServerState *const sm)
+{
+  ++(sm->ring.released);
+}
+#endif
 
-    parsed = sm->state(sm, data, length);
-    length -= parsed;
-    data += parsed;
-    if (previous != sm->state)
-    {
-      sm->initialization = 1U;
-    }
-    else
-    {
-      sm->initialization = 0U;
-    }
-  }
+#if HTTP_DEFERRED_RESOURCES
+void Http_SetDeferCallback(
+    tuCHttpServerState *const sm,
+    tDeferCallback defer)
+{
+  sm->defer = defer;
 }
 
-/*****************************************************************************/
-/* Global helper functions                                                   */
-/*****************************************************************************/
+void Http_RunDeferred(
+    tuCHttpServerState *const sm)
+{
+  Utils_RunResource(sm);
+  sm->initialization = 1U;
+}
+#endif
 
-tHttpMethod Http_HelperGetMethod(
+#if HTTP_RESOURCE_CONTINUATION
+unsigned char Http_HasContinuation(
     tuCHttpServerState *const sm)
 {
-  return (tHttpMethod) sm->method;
+  return (STATE_CONTINUE_RESOURCE == sm->state) ? 1U : 0U;
 }
 
-void *Http_HelperGetContext(
+unsigned char Http_Continue(
     tuCHttpServerState *const sm)
 {
-  return sm->context;
+  Utils_RunResource(sm);
+  sm->initialization = 1U;
+  return Http_HasContinuation(sm);
 }
+#endif
 
-const char *Http_HelperGetParameter(
+#if HTTP_PROFILING
+void Http_SetProfile(
     tuCHttpServerState *const sm,
-    const char *param)
+    tHttpProfile *profile)
+{
+  sm->profile = profile;
+}
+
+void Http_ProfileReset(
+    tHttpProfile *profile)
 {
   unsigned int i;
-  const char *result = NULL;
 
-  for (i = 0; i < HTTP_PARAMETERS_MAX; i++)
+  for (i = 0U; i < HTTP_PROFILE_STATES; i++)
   {
-    if (NULL == sm->parameters[i][0])
-    {
-      break;
-    }
-    else if (0 == Utils_SearchNullTerminatedPattern(param,
-            sm->parameters[i][0]))
-    {
-      result = sm->parameters[i][1];
-      break;
-    }
+    profile->states[i].time = 0UL;
+    profile->states[i].calls = 0UL;
+  }
+  for (i = 0U; NULL != profile->resources && i < profile->resourcesLength;
+      i++)
+  {
+    profile->resources[i].time = 0UL;
+    profile->resources[i].calls = 0UL;
   }
-
-  return result;
 }
 
-void Http_HelperSetResponseStatus(
-    tuCHttpServerState *const sm,
-    tHttpStatusCode code)
+const char *Http_ProfileStateName(
+    unsigned int idx)
 {
-  Http_SendNullTerminatedPortWrapper(sm, "HTTP/1.1 ");
-  Http_SendNullTerminatedPortWrapper(sm, statuscodes[code][0]);
-  Http_SendPortWrapper(sm, SP.str, SP.length);
-  Http_SendNullTerminatedPortWrapper(sm, statuscodes[code][1]);
-  Http_SendNullTerminatedPortWrapper(sm, CRLF);
+  return (HTTP_PROFILE_STATES > idx) ? stateNames[idx] : NULL;
 }
+#endif
 
-void Http_HelperSetResponseHeader(
-    tuCHttpServerState *const sm,
-    const char *name,
-    const char *value)
+#if HTTP_TRACING
+void Http_TraceInitialize(
+    tHttpTrace *trace,
+    tHttpTraceEvent *events,
+    unsigned long length)
 {
-  Http_SendNullTerminatedPortWrapper(sm, name);
-  Http_SendNullTerminatedPortWrapper(sm, ": ");
-  Http_SendNullTerminatedPortWrapper(sm, value);
-  Http_SendNullTerminatedPortWrapper(sm, CRLF);
-}
+  unsigned long i;
 
-void Http_HelperSendHeader(
-    tuCHttpServerState *const sm)
-{
-  ResponseEngine_SendHeader(&(sm->shared.content.responseEntity));
+  trace->events = events;
+  trace->mask = length - 1UL;
+  trace->head = 0UL;
+  for (i = 0UL; i < length; i++)
+  {
+    /* No position matches, nothing is copied before it is recorded */
+    events[i].sequence = 0UL;
+  }
 }
 
-void Http_HelperSendMessageBody(
+void Http_SetTrace(
     tuCHttpServerState *const sm,
-    const char *body)
+    tHttpTrace *trace,
+    unsigned short id)
 {
-  Http_SendNullTerminatedPortWrapper(sm, body);
+  sm->trace = trace;
+  sm->traceId = id;
+  Utils_Trace(sm, HTTP_TRACE_CONNECTION, 0U, 0UL);
 }
 
-void Http_HelperSendMessageBodyParametered(
-    tuCHttpServerState *const sm,
-    const char *body,
-    const void *const *param)
+unsigned long Http_TraceCopy(
+    const tHttpTrace *trace,
+    tHttpTraceEvent *events,
+    unsigned long length)
 {
-  while ('\0' != (*body))
+  unsigned long head = HTTP_ATOMIC_LOAD(trace->head);
+  unsigned long first;
+  unsigned long last;
+  unsigned long copied = 0UL;
+  unsigned long kept = 0UL;
+  unsigned long i;
+
+  if (length > trace->mask + 1UL)
   {
-    if (ESCAPE_CHARACTER == (*body))
+    length = trace->mask + 1UL;
+  }
+  first = (head > length) ? head - length : 0UL;
+  for (i = first; i < head; i++)
+  {
+    const tHttpTraceEvent *event = &(trace->events[i & trace->mask]);
+
+    /* Reserved slot still holds an older event until its writer is done */
+    if (i + 1UL == HTTP_ATOMIC_LOAD(event->sequence))
     {
-      Utils_PrintParameter(sm, body, *param);
-      body += 2;
-      ++param;
+      events[copied++] = *event;
     }
-    else
+  }
+
+  /* Writers that went round the ring meanwhile tore the oldest ones */
+  last = HTTP_ATOMIC_LOAD(trace->head);
+  for (i = 0UL; i < copied; i++)
+  {
+    if (events[i].sequence + trace->mask >= last)
     {
-      Http_SendPortWrapper(sm, body, 1);
-      ++body;
+      events[kept++] = events[i];
     }
   }
+
+  return kept;
 }
+#endif
 
-void Http_HelperSend(
-    tuCHttpServerState *const sm,
-    const char *data,
-    unsigned int length)
+#if HTTP_METRICS
+void Http_MetricsInitialize(
+    tHttpMetrics *metrics,
+    unsigned long *resources,
+    unsigned int resourcesLength)
 {
-  Http_SendPortWrapper(sm, data, length);
+  unsigned int i;
+
+  for (i = 0U; i < HTTP_METRICS_METHODS; i++)
+  {
+    metrics->methods[i] = 0UL;
+  }
+  for (i = 0U; i < HTTP_METRICS_STATUSES; i++)
+  {
+    metrics->statuses[i] = 0UL;
+    metrics->errors[i] = 0UL;
+  }
+  for (i = 0U; i < HTTP_METRICS_SEND_BUCKETS; i++)
+  {
+    metrics->sendBuckets[i] = 0UL;
+  }
+  for (i = 0U; NULL != resources && i < resourcesLength; i++)
+  {
+    resources[i] = 0UL;
+  }
+  metrics->sends = 0UL;
+  metrics->bytesIn = 0UL;
+  metrics->bytesOut = 0UL;
+  metrics->connections = 0UL;
+#if HTTP_BUFFER_STATISTICS
+  metrics->buffers.searchPeak = 0UL;
+  metrics->buffers.parametersPeak = 0UL;
+  metrics->buffers.slotsPeak = 0UL;
+  metrics->buffers.responsePeak = 0UL;
+  metrics->buffers.truncations = 0UL;
+#endif
+  metrics->resources = resources;
+  metrics->resourcesLength = (NULL != resources) ? resourcesLength : 0U;
+  metrics->next = metrics;
 }
 
-void Http_HelperSendParametered(
+void Http_MetricsLink(
+    tHttpMetrics *metrics,
+    tHttpMetrics *other)
+{
+  other->next = metrics->next;
+  metrics->next = other;
+}
+
+void Http_SetMetrics(
     tuCHttpServerState *const sm,
-    const char *data,
-    unsigned int length,
-    const void *const *param)
+    tHttpMetrics *metrics)
 {
-  while (length--)
+  sm->metrics = metrics;
+}
+
+tHttpStatusCode Http_MetricsResource(
+    void *const conn)
+{
+  tuCHttpServerState *const sm = conn;
+  const tHttpMetrics *const metrics = sm->metrics;
+  unsigned long count = 0UL;
+  unsigned int i;
+
+  Http_HelperSetResponseStatus(conn, HTTP_STATUS_OK);
+  Http_HelperSetResponseHeader(conn, "Content-Type",
+      "text/plain; version=0.0.4");
+  Http_HelperSendHeader(conn);
+
+  if (NULL != metrics)
   {
-    if (ESCAPE_CHARACTER == (*data))
+    Http_SendNullTerminatedPortWrapper(conn,
+        "# TYPE uchttp_requests_total counter\n");
+    for (i = 0U; i < HTTP_METRICS_METHODS; i++)
     {
-      Utils_PrintParameter(sm, data, *param);
-      data += 2;
-      --length;                 /* extra character */
-      ++param;
+      Utils_MetricsSample(conn, "uchttp_requests_total{method=\"",
+          methods[i].str, methods[i].length,
+          Utils_MetricsSum(metrics, &(metrics->methods[i])));
     }
-    else
+    Http_SendNullTerminatedPortWrapper(conn,
+        "# TYPE uchttp_responses_total counter\n");
+    for (i = 0U; i < HTTP_METRICS_STATUSES; i++)
     {
-      Http_SendPortWrapper(sm, data, 1);
-      ++data;
+      Utils_MetricsSample(conn, "uchttp_responses_total{code=\"",
+          statuscodes[i][0], 3U,
+          Utils_MetricsSum(metrics, &(metrics->statuses[i])));
     }
+    Http_SendNullTerminatedPortWrapper(conn,
+        "# TYPE uchttp_parse_errors_total counter\n");
+    for (i = 0U; i < HTTP_METRICS_STATUSES; i++)
+    {
+      /* Parsing never fails with 1xx or 2xx */
+      if ('4' <= statuscodes[i][0][0])
+      {
+        Utils_MetricsSample(conn, "uchttp_parse_errors_total{code=\"",
+            statuscodes[i][0], 3U,
+            Utils_MetricsSum(metrics, &(metrics->errors[i])));
+      }
+    }
+    /* Resource names are request targets, never quotes or backslashes */
+    Http_SendNullTerminatedPortWrapper(conn,
+        "# TYPE uchttp_resource_requests_total counter\n");
+    for (i = 0U; i < sm->resourcesLength; i++)
+    {
+      Utils_MetricsSample(conn, "uchttp_resource_requests_total{resource=\"",
+          (*sm->resources)[i].name.str, (*sm->resources)[i].name.length,
+          Utils_MetricsSumResource(metrics, i));
+    }
+    Http_SendNullTerminatedPortWrapper(conn,
+        "# TYPE uchttp_sends_per_response histogram\n");
+    for (i = 0U; i < HTTP_METRICS_SEND_BUCKETS; i++)
+    {
+      count += Utils_MetricsSum(metrics, &(metrics->sendBuckets[i]));
+      Utils_MetricsSample(conn, "uchttp_sends_per_response_bucket{le=\"",
+          sendBucketBounds[i].str, sendBucketBounds[i].length, count);
+    }
+    Utils_MetricsSample(conn, "uchttp_sends_per_response_sum", NULL, 0U,
+        Utils_MetricsSum(metrics, &(metrics->sends)));
+    Utils_MetricsSample(conn, "uchttp_sends_per_response_count", NULL, 0U,
+        count);
+    Http_SendNullTerminatedPortWrapper(conn,
+        "# TYPE uchttp_received_bytes_total counter\n");
+    Utils_MetricsSample(conn, "uchttp_received_bytes_total", NULL, 0U,
+        Utils_MetricsSum(metrics, &(metrics->bytesIn)));
+    Http_SendNullTerminatedPortWrapper(conn,
+        "# TYPE uchttp_sent_bytes_total counter\n");
+    Utils_MetricsSample(conn, "uchttp_sent_bytes_total", NULL, 0U,
+        Utils_MetricsSum(metrics, &(metrics->bytesOut)));
+    Http_SendNullTerminatedPortWrapper(conn,
+        "# TYPE uchttp_connections gauge\n");
+    Utils_MetricsSample(conn, "uchttp_connections", NULL, 0U,
+        Utils_MetricsSum(metrics, &(metrics->connections)));
+#if HTTP_BUFFER_STATISTICS
+    Http_SendNullTerminatedPortWrapper(conn,
+        "# TYPE uchttp_buffer_peak_bytes gauge\n");
+    Utils_MetricsSample(conn, "uchttp_buffer_peak_bytes{buffer=\"",
+        "search", 6U,
+        Utils_MetricsMax(metrics, &(metrics->buffers.searchPeak)));
+    Utils_MetricsSample(conn, "uchttp_buffer_peak_bytes{buffer=\"",
+        "parameters", 10U,
+        Utils_MetricsMax(metrics, &(metrics->buffers.parametersPeak)));
+    Utils_MetricsSample(conn, "uchttp_buffer_peak_bytes{buffer=\"",
+        "response", 8U,
+        Utils_MetricsMax(metrics, &(metrics->buffers.responsePeak)));
+    Http_SendNullTerminatedPortWrapper(conn,
+        "# TYPE uchttp_parameter_slots_peak gauge\n");
+    Utils_MetricsSample(conn, "uchttp_parameter_slots_peak", NULL, 0U,
+        Utils_MetricsMax(metrics, &(metrics->buffers.slotsPeak)));
+    Http_SendNullTerminatedPortWrapper(conn,
+        "# TYPE uchttp_buffer_truncations_total counter\n");
+    Utils_MetricsSample(conn, "uchttp_buffer_truncations_total", NULL, 0U,
+        Utils_MetricsSum(metrics, &(metrics->buffers.truncations)));
+#endif
   }
 
+  Http_HelperFlush(conn);
+  return HTTP_STATUS_OK;
 }
+#endif
 
-void Http_HelperFlush(
-    tuCHttpServerState *const sm)
+#if HTTP_BUFFER_STATISTICS
+void Http_BufferStatisticsMerge(
+    tHttpBufferStatistics *destination,
+    const tHttpBufferStatistics *source)
 {
-  sm->shared.content.responseEntity.flush(&(sm->shared.content.
-          responseEntity));
-}
-
-/*****************************************************************************/
-/* Connection states (definitions)                                           */
-/*****************************************************************************/
-
-static unsigned int InitSearchMethodState(
-    void *const conn,
-    const char *data,
-    unsigned int length)
-{
-  tuCHttpServerState *const sm = conn;
-
-  /* Initialize method search */
-  SearchEngine_Init(&(sm->shared.search.searchEntity), methods,
-      sizeof(methods) / sizeof(methods[0]), &Utils_GetMethodByIdx,
-      sm->parametersBuffer,
-      (unsigned char) (HTTP_PARAMETERS_BUFFER_LENGTH >
-          255U ? 255U : HTTP_PARAMETERS_BUFFER_LENGTH));
-
-  sm->state = &ParseMethodState;
-
-  return 0;
+  /* Metrics of a loop are merged into by the resources it defers too */
+  Utils_AtomicMax(&(destination->searchPeak), source->searchPeak);
+  Utils_AtomicMax(&(destination->parametersPeak), source->parametersPeak);
+  Utils_AtomicMax(&(destination->slotsPeak), source->slotsPeak);
+  Utils_AtomicMax(&(destination->responsePeak), source->responsePeak);
+  if (0UL < source->truncations)
+  {
+    HTTP_ATOMIC_ADD(destination->truncations, source->truncations);
+  }
 }
+#endif
 
-/* Parse request states definitions */
-static unsigned int ParseMethodState(
-    void *const conn,
-    const char *data,
-    unsigned int length)
+#if HTTP_LATENCY_HISTOGRAMS
+void Http_LatencyInitialize(
+    tHttpLatencies *latencies,
+    tHttpLatency *resources,
+    unsigned int resourcesLength)
 {
-  tuCHttpServerState *const sm = conn;
-  unsigned int parsed;
-  unsigned int methodTemp;
-  tSearchEngineResult result;
+  unsigned int i;
 
-  methodTemp = sm->method;
-  if (SEARCH_ENGINE_ONGOING == (result =
-          SearchEngine_Search(&(sm->shared.search.searchEntity), *data,
-              &methodTemp)))
-  {
-    parsed = 1U;
-  }
-  else if (SEARCH_ENGINE_FOUND == result)
-  {
-    parsed = 1U;
-    sm->state = &PostMethodState;
-  }
-  else
+  for (i = 0U; NULL != resources && i < resourcesLength; i++)
   {
-    tErrorInfo info;
-
-    info.status = HTTP_STATUS_NOT_IMPLEMENTED;
-    Utils_MarkError(conn, info);
-    parsed = 0U;
+    Http_HistogramReset(&(resources[i].request));
+    Http_HistogramReset(&(resources[i].handler));
   }
-
-  /* Number of methods is less than 255 */
-  sm->method = (unsigned char) methodTemp;
-
-  return parsed;
+  latencies->resources = resources;
+  latencies->resourcesLength = (NULL != resources) ? resourcesLength : 0U;
+  latencies->next = latencies;
 }
 
-static unsigned int PostMethodState(
-    void *const conn,
-    const char *data,
-    unsigned int length)
+void Http_LatencyLink(
+    tHttpLatencies *latencies,
+    tHttpLatencies *other)
 {
-  tuCHttpServerState *const sm = conn;
-  unsigned int parsed;
-
-  if (' ' == *data)
-  {
-    parsed = 1U;
-    sm->state = &DetectUriState;
-  }
-  else
-  {
-    /* Space expected */
-    tErrorInfo info;
+  other->next = latencies->next;
+  latencies->next = other;
+}
 
-    info.status = HTTP_BAD_REQUEST;
-    Utils_MarkError(conn, info);
-    parsed = 0U;
-  }
-  return parsed;
+void Http_SetLatencies(
+    tuCHttpServerState *const sm,
+    tHttpLatencies *latencies)
+{
+  sm->latencies = latencies;
 }
 
-static unsigned int DetectUriState(
-    void *const conn,
-    const char *data,
-    unsigned int length)
+void Http_LatencyMerge(
+    const tHttpLatencies *latencies,
+    unsigned int resourceIdx,
+    tHttpLatency *merged)
 {
-  tuCHttpServerState *const sm = conn;
+  const tHttpLatencies *l = latencies;
 
-  if (length)
+  Http_HistogramReset(&(merged->request));
+  Http_HistogramReset(&(merged->handler));
+  do
   {
-    if ('/' == *data)
-    {
-      /* Most common - abs_path */
-      sm->state = &ParseAbsPathResourceState;
-    }
-    else if ('*' == *data)
-    {
-      /* Server request */
-      tErrorInfo info;
-
-      info.status = HTTP_STATUS_NOT_IMPLEMENTED;
-      Utils_MarkError(conn, info);
-    }
-    else
+    if (resourceIdx < l->resourcesLength)
     {
-      /* Host ?proxy? */
-      tErrorInfo info;
-
-      info.status = HTTP_STATUS_NOT_IMPLEMENTED;
-      Utils_MarkError(conn, info);
+      Http_HistogramMerge(&(merged->request),
+          &(l->resources[resourceIdx].request));
+      Http_HistogramMerge(&(merged->handler),
+          &(l->resources[resourceIdx].handler));
     }
+    l = l->next;
   }
-
-  return 0U;
+  while (NULL != l && latencies != l);
 }
 
-static unsigned int ParseAbsPathResourceState(
-    void *const conn,
-    const char *data,
-    unsigned int length)
+void Http_HistogramReset(
+    tHttpHistogram *histogram)
 {
-  tuCHttpServerState *const sm = conn;
-  unsigned int parsed;
-  tSearchEngineResult result;
+  unsigned int i;
 
-  if (1U == Utils_OnInitialization(conn))
+  for (i = 0U; i < HTTP_LATENCY_BUCKETS; i++)
   {
-    SearchEngine_Init(&(sm->shared.search.searchEntity), sm->resources,
-        sm->resourcesLength, &Utils_GetResourceByIdx, sm->parametersBuffer,
-        (unsigned char) (HTTP_PARAMETERS_BUFFER_LENGTH >
-            255U ? 255U : HTTP_PARAMETERS_BUFFER_LENGTH));
+    histogram->counts[i] = 0UL;
   }
+  histogram->total = 0UL;
+  histogram->max = 0UL;
+}
 
-  if (SEARCH_ENGINE_ONGOING == (result =
-          SearchEngine_Search(&(sm->shared.search.searchEntity), *data,
-              &(sm->resourceIdx))))
+void Http_HistogramRecord(
+    tHttpHistogram *histogram,
+    unsigned long value)
+{
+  unsigned long shifted = value >> HTTP_LATENCY_SUB_BITS;
+  unsigned long idx;
+  unsigned int magnitude = 0U;
+
+  while (0UL != shifted)
   {
-    parsed = 1U;
+    ++magnitude;
+    shifted >>= 1;
   }
-  else if (SEARCH_ENGINE_FOUND == result)
+  if (0U == magnitude)
   {
-    sm->state = &InitializeParameterEngine;
-    parsed = 1U;
+    idx = value;
   }
-  else if (SEARCH_ENGINE_NOT_FOUND == result)
+  else
   {
-    tErrorInfo info;
-
-    info.status = HTTP_STATUS_NOT_FOUND;
-    Utils_MarkError(conn, info);
-    parsed = 0U;
+    /* Leading one is implied by the magnitude */
+    idx = ((unsigned long) magnitude << HTTP_LATENCY_SUB_BITS) +
+        ((value >> (magnitude - 1U)) &
+        ((1UL << HTTP_LATENCY_SUB_BITS) - 1UL));
   }
-  else if (SEARCH_ENGINE_BUFFER_EXCEEDED == result)
+  if (HTTP_LATENCY_BUCKETS <= idx)
   {
-    tErrorInfo info;
-
-    info.status = HTTP_STATUS_REQUEST_URI_TOO_LONG;
-    Utils_MarkError(conn, info);
-    parsed = 0U;
+    idx = HTTP_LATENCY_BUCKETS - 1U;
   }
 
-  return parsed;
+  HTTP_ATOMIC_ADD(histogram->counts[idx], 1UL);
+  HTTP_ATOMIC_ADD(histogram->total, 1UL);
+  Utils_AtomicMax(&(histogram->max), value);
 }
 
-static unsigned int InitializeParameterEngine(
-    void *const conn,
-    const char *data,
-    unsigned int length)
+void Http_HistogramMerge(
+    tHttpHistogram *destination,
+    const tHttpHistogram *source)
 {
-  tuCHttpServerState *const sm = conn;
+  unsigned int i;
 
-  /* Prepare parameters engine - before url-encoded-form */
-  ParameterEngine_Init(&(sm->shared.parse.parameterEntity),
-      &(sm->parametersBuffer), &(sm->parameters),
-      HTTP_PARAMETERS_BUFFER_LENGTH, HTTP_PARAMETERS_MAX);
-  sm->state = &ParseResourceEnding;
-  return 0U;
+  for (i = 0U; i < HTTP_LATENCY_BUCKETS; i++)
+  {
+    destination->counts[i] += source->counts[i];
+  }
+  destination->total += source->total;
+  if (source->max > destination->max)
+  {
+    destination->max = source->max;
+  }
 }
 
-static unsigned int ParseResourceEnding(
-    void *const conn,
-    const char *data,
-    unsigned int length)
+unsigned long Http_HistogramPercentile(
+    const tHttpHistogram *histogram,
+    unsigned int basisPoints)
 {
-  tuCHttpServerState *const sm = conn;
-  unsigned int parsed;
+  /* Rank of the sample, rounded up, split to not overflow 32 bits */
+  unsigned long rank = (histogram->total / 10000UL) * basisPoints +
+      ((histogram->total % 10000UL) * basisPoints + 9999UL) / 10000UL;
+  unsigned long seen = 0UL;
+  unsigned long highest = 0UL;
+  unsigned int i;
 
-  if (' ' == *data)
+  if (0UL == histogram->total)
   {
-    sm->state = &ParseHttpVersion;
-    parsed = 1U;
+    return 0UL;
   }
-  else if ('?' == *data)
+  if (0UL == rank)
   {
-    sm->state = &ParseUrlEncodedFormName;
-    parsed = 1U;
+    rank = 1UL;
   }
-  else
+  for (i = 0U; i < HTTP_LATENCY_BUCKETS; i++)
   {
-    tErrorInfo info;
-
-    info.status = HTTP_BAD_REQUEST;
-    Utils_MarkError(conn, info);
-    parsed = 0U;
+    seen += histogram->counts[i];
+    if (seen >= rank)
+    {
+      break;
+    }
   }
 
-  return parsed;
-}
-
-static unsigned int ParseUrlEncodedFormName(
-    void *const conn,
-    const char *data,
-    unsigned int length)
-{
-  tuCHttpServerState *const sm = conn;
-  unsigned int parsed;
-
-  if ('=' == *data)
+  if ((1U << HTTP_LATENCY_SUB_BITS) > i)
   {
-    ParameterEngine_AddParameterCharacter(&(sm->shared.parse.parameterEntity),
-        '\0');
-    ParameterEngine_AddParameterValue(&(sm->shared.parse.parameterEntity));
-    sm->state = &ParseUrlEncodedFormValue;
-    parsed = 1U;
+    highest = i;
   }
-  else if (' ' == *data)
+  else if (HTTP_LATENCY_BUCKETS - 1U == i)
   {
-    ParameterEngine_AddParameterCharacter(&(sm->shared.parse.parameterEntity),
-        '\0');
-    sm->state = &ParseResourceEnding;
-    parsed = 0U;
+    /* Last bucket is open ended */
+    highest = histogram->max;
   }
   else
   {
-    ParameterEngine_AddParameterCharacter(conn, *data);
-    parsed = 1U;
+    unsigned int magnitude = i >> HTTP_LATENCY_SUB_BITS;
+    unsigned long sub = i & ((1U << HTTP_LATENCY_SUB_BITS) - 1U);
+
+    highest = ((((1UL << HTTP_LATENCY_SUB_BITS) + sub + 1UL) <<
+            (magnitude - 1U)) - 1UL);
   }
 
-  return parsed;
+  return (highest < histogram->max) ? highest : histogram->max;
 }
+#endif
 
-static unsigned int ParseUrlEncodedFormValue(
-    void *const conn,
+#if HTTP_ADMISSION_CONTROL
+void Http_SetAdmitCallback(
+    tuCHttpServerState *const sm,
+    tAdmitCallback admit)
+{
+  sm->admit = admit;
+}
+#endif
+
+unsigned int Http_Input(
+    tuCHttpServerState *const sm,
     const char *data,
     unsigned int length)
 {
-  tuCHttpServerState *const sm = conn;
+  return Http_InputBudget(sm, data, length, NULL);
+}
+
+unsigned int Http_InputBudget(
+    tuCHttpServerState *const sm,
+    const char *data,
+    unsigned int length,
+    unsigned int *requests)
+{
   unsigned int parsed;
+  unsigned int consumed = 0U;
+#if HTTP_TRACING
+  unsigned long body = 0UL;
+#endif
 
-  if ('&' == *data)
+  if (NULL != requests && 0U == *requests)
   {
-    ParameterEngine_AddParameterCharacter(&(sm->shared.parse.parameterEntity),
-        '\0');
-    ParameterEngine_AddParameterName(&(sm->shared.parse.parameterEntity));
-    sm->state = &ParseUrlEncodedFormName;
-    parsed = 1U;
+    return 0U;
   }
-  else if (' ' == *data)
+
+  while (length || (STATES_WITHOUT_INPUT & (1UL << sm->state)))
   {
-    ParameterEngine_AddParameterCharacter(&(sm->shared.parse.parameterEntity),
-        '\0');
-    sm->state = &ParseResourceEnding;
-    parsed = 0U;
+    const unsigned char previous = sm->state;
+#if HTTP_PROFILING
+    unsigned long start = (NULL != sm->profile) ? HTTP_CLOCK() : 0UL;
+#endif
+
+    parsed = Utils_Dispatch(sm, data, length);
+#if HTTP_PROFILING
+    if (NULL != sm->profile)
+    {
+      /* Time of the state the call started in */
+      Utils_ProfileAccount(&(sm->profile->states[previous]), start);
+    }
+#endif
+    length -= parsed;
+    data += parsed;
+    consumed += parsed;
+#if HTTP_TRACING
+    if (STATE_PARSE_URL_ENCODED_ENTITY_NAME == previous ||
+        STATE_PARSE_URL_ENCODED_ENTITY_VALUE == previous ||
+        STATE_SKIP_ENTITY == previous)
+    {
+      body += parsed;
+    }
+#endif
+    sm->initialization = (previous != sm->state) ? 1U : 0U;
+#if HTTP_DEFERRED_RESOURCES
+    if (STATE_DEFERRED_RESOURCE == sm->state)
+    {
+      break;
+    }
+#endif
+#if HTTP_RESOURCE_CONTINUATION
+    if (STATE_CONTINUE_RESOURCE == sm->state)
+    {
+      break;
+    }
+#endif
+    if (NULL != requests && previous != sm->state &&
+        ((STATE_CALL_RESOURCE == previous) ||
+            (STATE_CALL_ERROR_CALLBACK == previous)))
+    {
+      /* Response sent - next request waits for another turn */
+      if (0U == --(*requests))
+      {
+        break;
+      }
+    }
   }
-  else
+
+#if HTTP_METRICS
+  if (NULL != sm->metrics)
   {
-    ParameterEngine_AddParameterCharacter(&(sm->shared.parse.parameterEntity),
-        *data);
-    parsed = 1U;
+    HTTP_ATOMIC_ADD(sm->metrics->bytesIn, consumed);
   }
-
-  return parsed;
+#endif
+#if HTTP_TRACING
+  if (0UL < body)
+  {
+    /* One event per input chunk shows how the body was fragmented */
+    Utils_Trace(sm, HTTP_TRACE_BODY, 0U, body);
+  }
+#endif
+  return consumed;
 }
 
-static unsigned int ParseHttpVersion(
-    void *const conn,
-    const char *data,
-    unsigned int length)
+unsigned char Http_ShouldClose(
+    tuCHttpServerState *const sm)
 {
-  tuCHttpServerState *const sm = conn;
-  unsigned int parsed;
-  tCompareEngineResult result;
-
-  if (1U == Utils_OnInitialization(conn))
+#if HTTP_ADMISSION_CONTROL
+  if (STATE_DISCARD_REQUEST == sm->state)
   {
-    CompareEngine_Init(&(sm->shared.parse.compareEntity));
+    return 1U;
   }
+#endif
+  return (STATE_CONNECTION_CLOSED == sm->state) ? 1U : 0U;
+}
 
-  result =
+/*****************************************************************************/
+/* Global helper functions                                                   */
+/*****************************************************************************/
+
+tHttpMethod Http_HelperGetMethod(
+    tuCHttpServerState *const sm)
+{
+  return (tHttpMethod) sm->method;
+}
+
+unsigned char Http_HelperHeadOnly(
+    tuCHttpServerState *const sm)
+{
+  return sm->shared.content.responseEntity.head;
+}
+
+void *Http_HelperGetContext(
+    tuCHttpServerState *const sm)
+{
+  return sm->context;
+}
+
+#if HTTP_PROFILING
+tHttpProfile *Http_HelperGetProfile(
+    tuCHttpServerState *const sm)
+{
+  return sm->profile;
+}
+#endif
+
+#if HTTP_TRACING
+tHttpTrace *Http_HelperGetTrace(
+    tuCHttpServerState *const sm)
+{
+  return sm->trace;
+}
+#endif
+
+#if HTTP_METRICS
+tHttpMetrics *Http_HelperGetMetrics(
+    tuCHttpServerState *const sm)
+{
+  return sm->metrics;
+}
+#endif
+
+#if HTTP_LATENCY_HISTOGRAMS
+tHttpLatencies *Http_HelperGetLatencies(
+    tuCHttpServerState *const sm)
+{
+  return sm->latencies;
+}
+#endif
+
+#if HTTP_BUFFER_STATISTICS
+const tHttpBufferStatistics *Http_HelperGetBufferStatistics(
+    tuCHttpServerState *const sm)
+{
+  return &(sm->buffers);
+}
+#endif
+
+const tResourceEntry *Http_HelperGetResource(
+    tuCHttpServerState *const sm)
+{
+  const unsigned char state = sm->state;
+
+  /* Index is valid once the search engine found the path */
+  if (STATE_INIT_SEARCH_METHOD == state || STATE_PARSE_METHOD == state ||
+      STATE_POST_METHOD == state || STATE_DETECT_URI == state ||
+      STATE_PARSE_ABS_PATH_RESOURCE == state ||
+      STATE_CALL_ERROR_CALLBACK == state || STATE_CONNECTION_CLOSED == state)
+  {
+    return NULL;
+  }
+
+  return &((*sm->resources)[sm->resourceIdx]);
+}
+
+tHttpPhase Http_HelperGetPhase(
+    tuCHttpServerState *const sm)
+{
+  const unsigned char state = sm->state;
+
+  if (STATE_INIT_SEARCH_METHOD == state ||
+      (STATE_PARSE_METHOD == state && sm->initialization))
+  {
+    return HTTP_PHASE_IDLE;
+  }
+  if (STATE_CHECK_HEADER_END == state || STATE_PARSE_PARAMETER_NAME == state ||
+      STATE_PARSE_PARAMETER_VALUE == state ||
+      STATE_PARSE_HEADER_VALUE == state || STATE_ANALYZE_ENTITY == state)
+  {
+    return HTTP_PHASE_HEADERS;
+  }
+  if (STATE_PARSE_URL_ENCODED_ENTITY_NAME == state ||
+      STATE_PARSE_URL_ENCODED_ENTITY_VALUE == state ||
+      STATE_SKIP_ENTITY == state)
+  {
+    return HTTP_PHASE_BODY;
+  }
+  if (STATE_CALL_RESOURCE == state || STATE_CALL_ERROR_CALLBACK == state ||
+      STATE_CONNECTION_CLOSED == state)
+  {
+    return HTTP_PHASE_RESPONSE;
+  }
+#if HTTP_DEFERRED_RESOURCES
+  if (STATE_DEFERRED_RESOURCE == state)
+  {
+    return HTTP_PHASE_RESPONSE;
+  }
+#endif
+#if HTTP_RESOURCE_CONTINUATION
+  if (STATE_CONTINUE_RESOURCE == state)
+  {
+    return HTTP_PHASE_RESPONSE;
+  }
+#endif
+#if HTTP_ADMISSION_CONTROL
+  if (STATE_REJECT_REQUEST == state || STATE_DISCARD_REQUEST == state)
+  {
+    return HTTP_PHASE_RESPONSE;
+  }
+#endif
+
+  return HTTP_PHASE_REQUEST_LINE;
+}
+
+#if HTTP_RESOURCE_CONTINUATION
+void Http_HelperYield(
+    tuCHttpServerState *const sm,
+    unsigned long cursor)
+{
+  sm->cursor = cursor;
+  sm->yielded = 1U;
+}
+
+unsigned long Http_HelperGetCursor(
+    tuCHttpServerState *const sm)
+{
+  return sm->cursor;
+}
+#endif
+
+const char *Http_HelperGetParameter(
+    tuCHttpServerState *const sm,
+    const char *param)
+{
+  unsigned int i;
+  const char *result = NULL;
+
+  for (i = 0; i < HTTP_PARAMETERS_MAX; i++)
+  {
+    if (NULL == sm->parameters[i][0])
+    {
+      break;
+    }
+    else if (0 == Utils_SearchNullTerminatedPattern(param,
+            sm->parameters[i][0]))
+    {
+      result = sm->parameters[i][1];
+      break;
+    }
+  }
+  if (NULL == result)
+  {
+    /* Hot headers whose value is kept as received */
+    result = Utils_KeptHeader(sm, Utils_HotHeader(param));
+  }
+
+  return result;
+}
+
+const tHttpHeaders *Http_HelperGetHeaders(
+    tuCHttpServerState *const sm)
+{
+  return &(sm->headers);
+}
+
+void Http_HelperSetResponseStatus(
+    tuCHttpServerState *const sm,
+    tHttpStatusCode code)
+{
+#if HTTP_METRICS
+  if (NULL != sm->metrics)
+  {
+    HTTP_ATOMIC_ADD(sm->metrics->statuses[code], 1UL);
+  }
+#endif
+  Http_SendNullTerminatedPortWrapper(sm, "HTTP/1.1 ");
+  Http_SendNullTerminatedPortWrapper(sm, statuscodes[code][0]);
+  Http_SendPortWrapper(sm, SP.str, SP.length);
+  Http_SendNullTerminatedPortWrapper(sm, statuscodes[code][1]);
+  Http_SendNullTerminatedPortWrapper(sm, CRLF);
+}
+
+void Http_HelperSetResponseHeader(
+    tuCHttpServerState *const sm,
+    const char *name,
+    const char *value)
+{
+  /* Length given by the callback frames the body, no chunks then */
+  if (0U == Utils_SearchNullTerminatedPattern("Content-Length", name))
+  {
+    sm->shared.content.responseEntity.type = TRANSFER_TYPE_LENGTH_BASED;
+  }
+  Http_SendNullTerminatedPortWrapper(sm, name);
+  Http_SendNullTerminatedPortWrapper(sm, ": ");
+  Http_SendNullTerminatedPortWrapper(sm, value);
+  Http_SendNullTerminatedPortWrapper(sm, CRLF);
+}
+
+void Http_HelperSendHeader(
+    tuCHttpServerState *const sm)
+{
+  ResponseEngine_SendHeader(&(sm->shared.content.responseEntity));
+}
+
+void Http_HelperSendContent(
+    tuCHttpServerState *const sm,
+    const char *contentType,
+    const char *data,
+    unsigned int length)
+{
+  char digits[12];
+
+  if (NULL != contentType)
+  {
+    Http_HelperSetResponseHeader(sm, "Content-Type", contentType);
+  }
+  Utils_Uitoa(length, digits, sizeof(digits));
+  Http_HelperSetResponseHeader(sm, "Content-Length", digits);
+  ResponseEngine_SendHeader(&(sm->shared.content.responseEntity));
+  if (0U == sm->shared.content.responseEntity.head)
+  {
+    Http_SendPortWrapper(sm, data, length);
+  }
+  Http_HelperFlush(sm);
+}
+
+void Http_HelperSendMessageBody(
+    tuCHttpServerState *const sm,
+    const char *body)
+{
+  Http_SendNullTerminatedPortWrapper(sm, body);
+}
+
+void Http_HelperSendMessageBodyParametered(
+    tuCHttpServerState *const sm,
+    const char *body,
+    const void *const *param)
+{
+  while ('\0' != (*body))
+  {
+    if (ESCAPE_CHARACTER == (*body))
+    {
+      Utils_PrintParameter(sm, body, *param);
+      body += 2;
+      ++param;
+    }
+    else
+    {
+      Http_SendPortWrapper(sm, body, 1);
+      ++body;
+    }
+  }
+}
+
+void Http_HelperSend(
+    tuCHttpServerState *const sm,
+    const char *data,
+    unsigned int length)
+{
+  Http_SendPortWrapper(sm, data, length);
+}
+
+void Http_HelperSendParametered(
+    tuCHttpServerState *const sm,
+    const char *data,
+    unsigned int length,
+    const void *const *param)
+{
+  while (length--)
+  {
+    if (ESCAPE_CHARACTER == (*data))
+    {
+      Utils_PrintParameter(sm, data, *param);
+      data += 2;
+      --length;                 /* extra character */
+      ++param;
+    }
+    else
+    {
+      Http_SendPortWrapper(sm, data, 1);
+      ++data;
+    }
+  }
+
+}
+
+void Http_HelperFlush(
+    tuCHttpServerState *const sm)
+{
+#if HTTP_TRACING
+  Utils_Trace(sm, HTTP_TRACE_FLUSH, 0U, 0UL);
+#endif
+  sm->shared.content.responseEntity.flush(&(sm->shared.content.
+          responseEntity));
+}
+
+/*****************************************************************************/
+/* Connection states (definitions)                                           */
+/*****************************************************************************/
+
+static unsigned int InitSearchMethodState(
+    void *const conn,
+    const char *data,
+    unsigned int length)
+{
+  tuCHttpServerState *const sm = conn;
+
+#if HTTP_LATENCY_HISTOGRAMS
+  /* Entered only with input, so the first request byte is here */
+  sm->requestStart = (NULL != sm->latencies) ? HTTP_CLOCK() : 0UL;
+#endif
+  Utils_ResetHeaders(&(sm->headers));
+  /* Initialize method search */
+  SearchEngine_Init(&(sm->shared.search.searchEntity), methods,
+      sizeof(methods) / sizeof(methods[0]), &Utils_GetMethodByIdx,
+      sm->parametersBuffer,
+      (unsigned char) (HTTP_PARAMETERS_BUFFER_LENGTH >
+          255U ? 255U : HTTP_PARAMETERS_BUFFER_LENGTH));
+
+  sm->state = STATE_PARSE_METHOD;
+
+  return 0;
+}
+
+/* Parse request states definitions */
+static unsigned int ParseMethodState(
+    void *const conn,
+    const char *data,
+    unsigned int length)
+{
+  tuCHttpServerState *const sm = conn;
+  unsigned int parsed = 0U;
+  unsigned int methodTemp;
+  tSearchEngineResult result = SEARCH_ENGINE_ONGOING;
+
+  methodTemp = sm->method;
+  /* All bytes of the method in a single call */
+  while (parsed < length && SEARCH_ENGINE_ONGOING == result)
+  {
+    result = SearchEngine_Search(&(sm->shared.search.searchEntity),
+        data[parsed], &methodTemp);
+    if (SEARCH_ENGINE_ONGOING == result)
+    {
+      ++parsed;
+    }
+    else if (SEARCH_ENGINE_FOUND == result)
+    {
+      ++parsed;
+      sm->state = STATE_POST_METHOD;
+    }
+    else
+    {
+      tErrorInfo info;
+
+      /* Not a method, its error response is not mistaken for HEAD */
+      methodTemp = HTTP_GET;
+      info.status = HTTP_STATUS_NOT_IMPLEMENTED;
+      Utils_MarkError(conn, info);
+    }
+  }
+
+  /* Number of methods is less than 255 */
+  sm->method = (unsigned char) methodTemp;
+
+  return parsed;
+}
+
+static unsigned int PostMethodState(
+    void *const conn,
+    const char *data,
+    unsigned int length)
+{
+  tuCHttpServerState *const sm = conn;
+  unsigned int parsed;
+
+  if (' ' == *data)
+  {
+#if HTTP_METRICS
+    /* Every request with a known method, found resource or not */
+    if (NULL != sm->metrics)
+    {
+      HTTP_ATOMIC_ADD(sm->metrics->methods[sm->method], 1UL);
+    }
+#endif
+    parsed = 1U;
+    sm->state = STATE_DETECT_URI;
+  }
+  else
+  {
+    /* Space expected, so no method either */
+    tErrorInfo info;
+
+    sm->method = HTTP_GET;
+    info.status = HTTP_BAD_REQUEST;
+    Utils_MarkError(conn, info);
+    parsed = 0U;
+  }
+  return parsed;
+}
+
+static unsigned int DetectUriState(
+    void *const conn,
+    const char *data,
+    unsigned int length)
+{
+  tuCHttpServerState *const sm = conn;
+
+  if (length)
+  {
+    if ('/' == *data)
+    {
+      /* Most common - abs_path */
+      sm->state = STATE_PARSE_ABS_PATH_RESOURCE;
+    }
+    else if ('*' == *data)
+    {
+      /* Server request */
+      tErrorInfo info;
+
+      info.status = HTTP_STATUS_NOT_IMPLEMENTED;
+      Utils_MarkError(conn, info);
+    }
+    else
+    {
+      /* Host ?proxy? */
+      tErrorInfo info;
+
+      info.status = HTTP_STATUS_NOT_IMPLEMENTED;
+      Utils_MarkError(conn, info);
+    }
+  }
+
+  return 0U;
+}
+
+static unsigned int ParseAbsPathResourceState(
+    void *const conn,
+    const char *data,
+    unsigned int length)
+{
+  tuCHttpServerState *const sm = conn;
+  unsigned int parsed;
+  tSearchEngineResult result;
+
+  if (1U == Utils_OnInitialization(conn))
+  {
+    SearchEngine_Init(&(sm->shared.search.searchEntity), sm->resources,
+        sm->resourcesLength, &Utils_GetResourceByIdx, sm->parametersBuffer,
+        (unsigned char) (HTTP_PARAMETERS_BUFFER_LENGTH >
+            255U ? 255U : HTTP_PARAMETERS_BUFFER_LENGTH));
+  }
+
+  /* All bytes of the path in a single call */
+  parsed = 0U;
+  do
+  {
+    result = SearchEngine_Search(&(sm->shared.search.searchEntity),
+        data[parsed], &(sm->resourceIdx));
+  } while (SEARCH_ENGINE_ONGOING == result && ++parsed < length);
+#if HTTP_BUFFER_STATISTICS
+  if (SEARCH_ENGINE_ONGOING != result)
+  {
+    tHttpBufferStatistics sample = { 0UL, 0UL, 0UL, 0UL, 0UL };
+
+    /* Search is over, its buffer is taken by parameters next */
+    sample.searchPeak = sm->shared.search.searchEntity.bufferIdx;
+    sample.truncations = (SEARCH_ENGINE_BUFFER_EXCEEDED == result) ? 1UL : 0UL;
+    Utils_BufferAccount(sm, &sample);
+  }
+#endif
+
+  if (SEARCH_ENGINE_FOUND == result)
+  {
+    sm->state = STATE_INITIALIZE_PARAMETER_ENGINE;
+    ++parsed;
+  }
+  else if (SEARCH_ENGINE_NOT_FOUND == result)
+  {
+    tErrorInfo info;
+
+    info.status = HTTP_STATUS_NOT_FOUND;
+    Utils_MarkError(conn, info);
+  }
+  else if (SEARCH_ENGINE_BUFFER_EXCEEDED == result)
+  {
+    tErrorInfo info;
+
+    info.status = HTTP_STATUS_REQUEST_URI_TOO_LONG;
+    Utils_MarkError(conn, info);
+  }
+
+  return parsed;
+}
+
+static unsigned int InitializeParameterEngine(
+    void *const conn,
+    const char *data,
+    unsigned int length)
+{
+  tuCHttpServerState *const sm = conn;
+
+  /* Prepare parameters engine - before url-encoded-form */
+  ParameterEngine_Init(&(sm->shared.parse.parameterEntity),
+      &(sm->parametersBuffer), &(sm->parameters),
+      HTTP_PARAMETERS_BUFFER_LENGTH, HTTP_PARAMETERS_MAX);
+  sm->state = STATE_PARSE_RESOURCE_ENDING;
+  return 0U;
+}
+
+static unsigned int ParseResourceEnding(
+    void *const conn,
+    const char *data,
+    unsigned int length)
+{
+  tuCHttpServerState *const sm = conn;
+  unsigned int parsed;
+
+  if (' ' == *data)
+  {
+    sm->state = STATE_PARSE_HTTP_VERSION;
+    parsed = 1U;
+  }
+  else if ('?' == *data)
+  {
+    ParameterEngine_AddParameterName(&(sm->shared.parse.parameterEntity));
+    sm->state = STATE_PARSE_URL_ENCODED_FORM_NAME;
+    parsed = 1U;
+  }
+  else
+  {
+    tErrorInfo info;
+
+    info.status = HTTP_BAD_REQUEST;
+    Utils_MarkError(conn, info);
+    parsed = 0U;
+  }
+
+  return parsed;
+}
+
+static unsigned int ParseUrlEncodedFormName(
+    void *const conn,
+    const char *data,
+    unsigned int length)
+{
+  tuCHttpServerState *const sm = conn;
+  unsigned int parsed = 0U;
+
+  /* All bytes of the name in a single call */
+  while (parsed < length && STATE_PARSE_URL_ENCODED_FORM_NAME == sm->state)
+  {
+    if ('=' == data[parsed])
+    {
+      ParameterEngine_AddParameterCharacter(&(sm->shared.
+              parse.parameterEntity), '\0');
+      ParameterEngine_AddParameterValue(&(sm->shared.parse.parameterEntity));
+      sm->state = STATE_PARSE_URL_ENCODED_FORM_VALUE;
+      ++parsed;
+    }
+    else if (' ' == data[parsed])
+    {
+      ParameterEngine_AddParameterCharacter(&(sm->shared.
+              parse.parameterEntity), '\0');
+      sm->state = STATE_PARSE_RESOURCE_ENDING;
+    }
+    else
+    {
+      ParameterEngine_AddParameterCharacter(&(sm->shared.
+              parse.parameterEntity), data[parsed]);
+      ++parsed;
+    }
+  }
+
+  return parsed;
+}
+
+static unsigned int ParseUrlEncodedFormValue(
+    void *const conn,
+    const char *data,
+    unsigned int length)
+{
+  tuCHttpServerState *const sm = conn;
+  unsigned int parsed = 0U;
+
+  /* All bytes of the value in a single call */
+  while (parsed < length && STATE_PARSE_URL_ENCODED_FORM_VALUE == sm->state)
+  {
+    if ('&' == data[parsed])
+    {
+      ParameterEngine_AddParameterCharacter(&(sm->shared.
+              parse.parameterEntity), '\0');
+      ParameterEngine_AddParameterName(&(sm->shared.parse.parameterEntity));
+      sm->state = STATE_PARSE_URL_ENCODED_FORM_NAME;
+      ++parsed;
+    }
+    else if (' ' == data[parsed])
+    {
+      ParameterEngine_AddParameterCharacter(&(sm->shared.
+              parse.parameterEntity), '\0');
+      sm->state = STATE_PARSE_RESOURCE_ENDING;
+    }
+    else
+    {
+      ParameterEngine_AddParameterCharacter(&(sm->shared.
+              parse.parameterEntity), data[parsed]);
+      ++parsed;
+    }
+  }
+
+  return parsed;
+}
+
+static unsigned int ParseHttpVersion(
+    void *const conn,
+    const char *data,
+    unsigned int length)
+{
+  tuCHttpServerState *const sm = conn;
+  unsigned int parsed;
+  tCompareEngineResult result;
+
+  if (1U == Utils_OnInitialization(conn))
+  {
+    CompareEngine_Init(&(sm->shared.parse.compareEntity));
+  }
+
+  /* All bytes of the version and line end in a single call */
+  parsed = 0U;
+  while (COMPARE_ENGINE_ONGOING == (result =
+          CompareEngine_Compare(&(sm->shared.parse.compareEntity),
+              data[parsed], &HTTP_VERSION)) && parsed + 1U < length)
+  {
+    CompareEngine_Increment(&(sm->shared.parse.compareEntity));
+    ++parsed;
+  }
+
+  if (COMPARE_ENGINE_MATCH == result)
+  {
+#if HTTP_TRACING
+    Utils_Trace(sm, HTTP_TRACE_REQUEST_LINE, sm->method, sm->resourceIdx);
+#endif
+#if HTTP_ADMISSION_CONTROL
+    /* Method and resource are known, nothing else was spent yet */
+    if (NULL != sm->admit &&
+        0U == sm->admit(conn, &((*sm->resources)[sm->resourceIdx])))
+    {
+      sm->state = STATE_REJECT_REQUEST;
+    }
+    else
+#endif
+    {
+      sm->state = STATE_CHECK_HEADER_END;
+    }
+    ++parsed;
+  }
+  else if (COMPARE_ENGINE_ONGOING == result)
+  {
+    CompareEngine_Increment(&(sm->shared.parse.compareEntity));
+    ++parsed;
+  }
+  else
+  {
+    tErrorInfo info;
+
+    info.status = HTTP_VERSION_NOT_IMPLEMENTED;
+    Utils_MarkError(conn, info);
+  }
+
+  return parsed;
+}
+
+static unsigned int CheckHeaderEndState(
+    void *const conn,
+    const char *data,
+    unsigned int length)
+{
+  tuCHttpServerState *const sm = conn;
+  unsigned int parsed;
+  tCompareEngineResult result;
+
+  if (1U == Utils_OnInitialization(conn))
+  {
+    CompareEngine_Init(&(sm->shared.parse.compareEntity));
+  }
+
+  result =
       CompareEngine_Compare(&(sm->shared.parse.compareEntity), *data,
-      &HTTP_VERSION);
+      &CRLFwL);
+
+  if (COMPARE_ENGINE_MATCH == result)
+  {
+#if HTTP_TRACING
+    Utils_Trace(sm, HTTP_TRACE_HEADERS, 0U, 0UL);
+#endif
+    sm->state = STATE_ANALYZE_ENTITY;
+    parsed = 1U;
+  }
+  else if (COMPARE_ENGINE_ONGOING == result)
+  {
+    CompareEngine_Increment(&(sm->shared.parse.compareEntity));
+    parsed = 1U;
+  }
+  else
+  {
+    /* Given back if the name turns out to be a hot header */
+    sm->shared.parse.headerEntity.nameIdx =
+        sm->shared.parse.parameterEntity.bufferIdx;
+    ParameterEngine_AddParameterName(&(sm->shared.parse.parameterEntity));
+    sm->state = STATE_PARSE_PARAMETER_NAME;
+    parsed = 0U;
+  }
+
+  return parsed;
+}
+
+static unsigned int ParseParameterNameState(
+    void *const conn,
+    const char *data,
+    unsigned int length)
+{
+  tuCHttpServerState *const sm = conn;
+  tParameterEntity *const pe = &(sm->shared.parse.parameterEntity);
+  tHeaderEntity *const he = &(sm->shared.parse.headerEntity);
+  unsigned int parsed = 0U;
+
+  /* All bytes of the header name in a single call */
+  while (parsed < length && STATE_PARSE_PARAMETER_NAME == sm->state)
+  {
+    if (':' == data[parsed])
+    {
+      he->header = (PARAMETER_ENGINE_OK ==
+          ParameterEngine_AddParameterCharacter(pe, '\0')) ?
+          Utils_HotHeader(&((*pe->buffer)[he->nameIdx])) : 0U;
+      if (0U != he->header)
+      {
+        /* Decoded into headers, name and slot are reused */
+        ParameterEngine_Rewind(pe, he->nameIdx);
+        sm->state = STATE_PARSE_HEADER_VALUE;
+      }
+      else
+      {
+        ParameterEngine_AddParameterValue(pe);
+        sm->state = STATE_PARSE_PARAMETER_VALUE;
+      }
+      ++parsed;
+    }
+    else
+    {
+#if HTTP_ERROR_ON_TOO_MANY_PARAMETERS
+      tParameterEngineResult paramResult =
+#endif
+      ParameterEngine_AddParameterCharacter(&(sm->shared.
+              parse.parameterEntity), data[parsed]);
+
+#if HTTP_ERROR_ON_TOO_MANY_PARAMETERS
+      if (PARAMETER_ENGINE_OK == paramResult)
+      {
+        ++parsed;
+      }
+      else
+      {
+        tErrorInfo info;
+
+        info.status = HTTP_REQUEST_HEADER_FIELDS_TOO_LARGE;
+        Utils_MarkError(conn, info);
+      }
+#else
+      ++parsed;
+#endif
+    }
+  }
+
+  return parsed;
+}
+
+static unsigned int ParseParameterValueState(
+    void *const conn,
+    const char *data,
+    unsigned int length)
+{
+  tuCHttpServerState *const sm = conn;
+  unsigned int parsed = 0U;
+  tCompareEngineResult result;
+
+  if (1U == Utils_OnInitialization(conn))
+  {
+    CompareEngine_Init(&(sm->shared.parse.compareEntity));
+  }
+
+  /* All bytes of the header value in a single call */
+  while (parsed < length && STATE_PARSE_PARAMETER_VALUE == sm->state)
+  {
+    result =
+        CompareEngine_Compare(&(sm->shared.parse.compareEntity), data[parsed],
+        &CRLFwL);
+
+    if (COMPARE_ENGINE_MATCH == result)
+    {
+      ParameterEngine_AddParameterCharacter(&(sm->shared.
+              parse.parameterEntity), '\0');
+      sm->state = STATE_CHECK_HEADER_END;
+      ++parsed;
+    }
+    else if (COMPARE_ENGINE_ONGOING == result)
+    {
+      CompareEngine_Increment(&(sm->shared.parse.compareEntity));
+      ++parsed;
+    }
+    else if (' ' == data[parsed] || '\t' == data[parsed])
+    {
+      /* Ignore Linear White Space */
+      ++parsed;
+    }
+    else
+    {
+#if HTTP_ERROR_ON_TOO_MANY_PARAMETERS
+      tParameterEngineResult paramResult =
+#endif
+      ParameterEngine_AddParameterCharacter(&(sm->shared.
+              parse.parameterEntity), data[parsed]);
+#if HTTP_ERROR_ON_TOO_MANY_PARAMETERS
+      if (PARAMETER_ENGINE_OK == paramResult)
+      {
+        ++parsed;
+      }
+      else
+      {
+        tErrorInfo info;
+
+        info.status = HTTP_REQUEST_HEADER_FIELDS_TOO_LARGE;
+        Utils_MarkError(conn, info);
+      }
+#else
+      ++parsed;
+#endif
+    }
+  }
+
+  return parsed;
+}
+
+static unsigned int ParseHeaderValueState(
+    void *const conn,
+    const char *data,
+    unsigned int length)
+{
+  tuCHttpServerState *const sm = conn;
+  unsigned int parsed = 0U;
+  tCompareEngineResult result;
+
+  if (1U == Utils_OnInitialization(conn))
+  {
+    CompareEngine_Init(&(sm->shared.parse.compareEntity));
+    Utils_HeaderBegin(sm);
+  }
+
+  /* All bytes of the header value in a single call */
+  while (parsed < length && STATE_PARSE_HEADER_VALUE == sm->state)
+  {
+    result =
+        CompareEngine_Compare(&(sm->shared.parse.compareEntity), data[parsed],
+        &CRLFwL);
+
+    if (COMPARE_ENGINE_MATCH == result)
+    {
+      sm->state = STATE_CHECK_HEADER_END;
+      Utils_HeaderEnd(sm);
+      ++parsed;
+    }
+    else if (COMPARE_ENGINE_ONGOING == result)
+    {
+      CompareEngine_Increment(&(sm->shared.parse.compareEntity));
+      ++parsed;
+    }
+    else if (' ' == data[parsed] || '\t' == data[parsed])
+    {
+      /* Ignore Linear White Space */
+      ++parsed;
+    }
+    else if (1U == Utils_HeaderCharacter(sm, data[parsed]))
+    {
+      ++parsed;
+    }
+  }
+
+  return parsed;
+}
+
+static unsigned int AnalyzeEntityState(
+    void *const conn,
+    const char *data,
+    unsigned int length)
+{
+  tuCHttpServerState *const sm = conn;
+  const tHttpHeaders *const headers = &(sm->headers);
+
+  if (0U != (HTTP_EXPECT_OTHER & headers->expect))
+  {
+    tErrorInfo info;
+
+    info.status = HTTP_STATUS_EXPECTATION_FAILED;
+    Utils_MarkError(conn, info);
+    return 0U;
+  }
+
+  /* Decided before the response, its header tells the client */
+  if (0U != (HTTP_CONNECTION_CLOSE & headers->connection))
+  {
+    sm->close = 1U;
+  }
+#if HTTP_KEEP_ALIVE_MAX_REQUESTS
+  ++(sm->requests);
+  if (HTTP_KEEP_ALIVE_MAX_REQUESTS <= sm->requests)
+  {
+    sm->close = 1U;
+  }
+#endif
+
+  if (HTTP_MEDIA_FORM_URLENCODED != headers->media)
+  {
+    sm->state = STATE_CALL_RESOURCE;
+    if (0U != (HTTP_HEADER_TRANSFER_ENCODING & headers->present))
+    {
+      /* Chunked body is not decoded, next request cannot be found */
+      sm->close = 1U;
+    }
+    else if (0UL < headers->contentLength)
+    {
+      /* Body no resource reads, skipped to find the next request */
+      sm->contentLength = (unsigned int) headers->contentLength;
+      if (sm->contentLength == headers->contentLength)
+      {
+        sm->state = STATE_SKIP_ENTITY;
+      }
+      else
+      {
+        sm->close = 1U;
+      }
+    }
+  }
+  else if (0U != (HTTP_HEADER_CONTENT_LENGTH & headers->present))
+  {
+    sm->contentLength = (unsigned int) headers->contentLength;
+    if (0U < sm->contentLength && sm->contentLength == headers->contentLength)
+    {
+      ParameterEngine_AddParameterName(&(sm->shared.parse.parameterEntity));
+      sm->state = STATE_PARSE_URL_ENCODED_ENTITY_NAME;
+    }
+    else
+    {
+      tErrorInfo info;
+
+      info.status = HTTP_BAD_REQUEST;
+      Utils_MarkError(conn, info);
+    }
+  }
+  else
+  {
+    tErrorInfo info;
+
+    info.status = HTTP_LENGTH_REQUIRED;
+    Utils_MarkError(conn, info);
+  }
+
+  if (0U != (HTTP_EXPECT_CONTINUE & headers->expect))
+  {
+    if (STATE_PARSE_URL_ENCODED_ENTITY_NAME == sm->state)
+    {
+      /* Client holds the body back until it is accepted */
+      Utils_ExpectContinue(sm);
+    }
+    else if (STATE_SKIP_ENTITY == sm->state)
+    {
+      const tResourceEntry *resource = &((*sm->resources)[sm->resourceIdx]);
+      tErrorInfo info;
+
+      /* No 100 Continue for a body nobody reads, the final status goes
+       * out instead; the client may still send the body or not, so the
+       * connection closes after the response. The resource may still
+       * refuse the request as it would before a form body */
+      info.status = (NULL == resource->expect) ?
+          HTTP_STATUS_CONTINUE : resource->expect(sm);
+      if (HTTP_STATUS_CONTINUE == info.status)
+      {
+        sm->state = STATE_CALL_RESOURCE;
+        sm->close = 1U;
+      }
+      else
+      {
+        Utils_MarkError(conn, info);
+      }
+    }
+  }
+  return 0U;
+}
+
+static unsigned int ParseUrlEncodedEntityName(
+    void *const conn,
+    const char *data,
+    unsigned int length)
+{
+  tuCHttpServerState *const sm = conn;
+  unsigned int parsed = 0U;
+
+  /* All bytes of the name in a single call */
+  while (parsed < length && STATE_PARSE_URL_ENCODED_ENTITY_NAME == sm->state)
+  {
+    if (1U == sm->contentLength)
+    {
+      ParameterEngine_AddParameterCharacter(&(sm->shared.
+              parse.parameterEntity), data[parsed]);
+      ParameterEngine_AddParameterCharacter(&(sm->shared.
+              parse.parameterEntity), '\0');
+      sm->state = STATE_CALL_RESOURCE;
+    }
+    else if ('=' == data[parsed])
+    {
+      ParameterEngine_AddParameterCharacter(&(sm->shared.
+              parse.parameterEntity), '\0');
+      ParameterEngine_AddParameterValue(&(sm->shared.parse.parameterEntity));
+      sm->contentLength--;
+      sm->state = STATE_PARSE_URL_ENCODED_ENTITY_VALUE;
+    }
+    else
+    {
+      ParameterEngine_AddParameterCharacter(&(sm->shared.
+              parse.parameterEntity), data[parsed]);
+      sm->contentLength--;
+    }
+    ++parsed;
+  }
+
+  return parsed;
+}
+
+static unsigned int ParseUrlEncodedEntityValue(
+    void *const conn,
+    const char *data,
+    unsigned int length)
+{
+  tuCHttpServerState *const sm = conn;
+  unsigned int parsed = 0U;
+
+  /* All bytes of the value in a single call */
+  while (parsed < length && STATE_PARSE_URL_ENCODED_ENTITY_VALUE == sm->state)
+  {
+    if (1U == sm->contentLength)
+    {
+      ParameterEngine_AddParameterCharacter(&(sm->shared.
+              parse.parameterEntity), data[parsed]);
+      ParameterEngine_AddParameterCharacter(&(sm->shared.
+              parse.parameterEntity), '\0');
+      sm->state = STATE_CALL_RESOURCE;
+    }
+    else if ('&' == data[parsed])
+    {
+      ParameterEngine_AddParameterCharacter(&(sm->shared.
+              parse.parameterEntity), '\0');
+      ParameterEngine_AddParameterName(&(sm->shared.parse.parameterEntity));
+      sm->contentLength--;
+      sm->state = STATE_PARSE_URL_ENCODED_ENTITY_NAME;
+    }
+    else
+    {
+      ParameterEngine_AddParameterCharacter(&(sm->shared.
+              parse.parameterEntity), data[parsed]);
+      sm->contentLength--;
+    }
+    ++parsed;
+  }
+
+  return parsed;
+}
+
+static unsigned int SkipEntityState(
+    void *const conn,
+    const char *data,
+    unsigned int length)
+{
+  tuCHttpServerState *const sm = conn;
+  unsigned int parsed = (length < sm->contentLength) ?
+      length : sm->contentLength;
+
+  sm->contentLength -= parsed;
+  if (0U == sm->contentLength)
+  {
+    sm->state = STATE_CALL_RESOURCE;
+  }
+
+  return parsed;
+}
+
+static unsigned int CallResourceState(
+    void *const conn,
+    const char *data,
+    unsigned int length)
+{
+  tuCHttpServerState *const sm = conn;
+  tResponseEntity *const re = &(sm->shared.content.responseEntity);
+
+  if (1U == Utils_OnInitialization(conn))
+  {
+#if HTTP_BUFFER_STATISTICS
+    tHttpBufferStatistics sample = { 0UL, 0UL, 0UL, 0UL, 0UL };
+    const tParameterEntity *pe = &(sm->shared.parse.parameterEntity);
+
+    /* Last look at parameters before response area takes their place */
+    sample.parametersPeak = pe->bufferIdx;
+    sample.slotsPeak = pe->parameterIdx;
+    sample.truncations = pe->truncated;
+    Utils_BufferAccount(sm, &sample);
+#endif
+    ResponseEngine_Init(re, sm);
+#if HTTP_METRICS
+    if (NULL != sm->metrics && sm->resourceIdx < sm->metrics->resourcesLength)
+    {
+      HTTP_ATOMIC_ADD(sm->metrics->resources[sm->resourceIdx], 1UL);
+    }
+#endif
+  }
+
+#if HTTP_DEFERRED_RESOURCES
+  if (NULL != sm->defer &&
+      1U == sm->defer(conn, &((*sm->resources)[sm->resourceIdx])))
+  {
+    sm->state = STATE_DEFERRED_RESOURCE;
+    return 0U;
+  }
+#endif
+
+  Utils_RunResource(sm);
+  return 0U;
+}
+
+#if HTTP_DEFERRED_RESOURCES
+static unsigned int DeferredResourceState(
+    void *const conn,
+    const char *data,
+    unsigned int length)
+{
+  /* Suspended until Http_RunDeferred - input is not consumed */
+  return 0U;
+}
+#endif
+
+#if HTTP_RESOURCE_CONTINUATION
+static unsigned int ContinueResourceState(
+    void *const conn,
+    const char *data,
+    unsigned int length)
+{
+  /* Suspended until Http_Continue - input is not consumed */
+  return 0U;
+}
+#endif
+
+static unsigned int CallErrorCallbackState(
+    void *const conn,
+    const char *data,
+    unsigned int length)
+{
+  tuCHttpServerState *const sm = conn;
+
+  if (1U == Utils_OnInitialization(conn))
+  {
+    ResponseEngine_Init(&(sm->shared.content.responseEntity), sm);
+  }
+
+  /* Rest of the stream cannot be trusted */
+  sm->close = 1U;
+  sm->onError(conn, &(sm->shared.content.errorInfo));
+  ResponseEngine_Release(&(sm->shared.content.responseEntity));
+  sm->state = STATE_CONNECTION_CLOSED;
+  return length;
+}
+
+static unsigned int ConnectionClosedState(
+    void *const conn,
+    const char *data,
+    unsigned int length)
+{
+  /* Input pipelined after the last response is never parsed */
+  return length;
+}
+
+#if HTTP_ADMISSION_CONTROL
+static unsigned int RejectRequestState(
+    void *const conn,
+    const char *data,
+    unsigned int length)
+{
+  tuCHttpServerState *const sm = conn;
+  tResponseEntity *const re = &(sm->shared.content.responseEntity);
+
+#if HTTP_TRACING
+  Utils_Trace(sm, HTTP_TRACE_ERROR, 0U, 503UL);
+#endif
+#if HTTP_METRICS
+  if (NULL != sm->metrics)
+  {
+    HTTP_ATOMIC_ADD(sm->metrics->statuses[HTTP_STATUS_SERVICE_UNAVAILABLE],
+        1UL);
+  }
+#endif
+  /* Single region, so a single send when it fits HTTP_BUFFER_LENGTH */
+  ResponseEngine_Init(re, sm);
+  re->send(re, SERVICE_UNAVAILABLE.str, SERVICE_UNAVAILABLE.length);
+  re->flush(re);
+  ResponseEngine_Release(re);
+  sm->state = STATE_DISCARD_REQUEST;
+  return 0U;
+}
+
+static unsigned int DiscardRequestState(
+    void *const conn,
+    const char *data,
+    unsigned int length)
+{
+  /* Headers and body of rejected request are never parsed */
+  return length;
+}
+#endif
+
+/*****************************************************************************/
+/* Dispatcher                                                                */
+/*****************************************************************************/
+
+static unsigned int Utils_Dispatch(
+    tuCHttpServerState *const sm,
+    const char *data,
+    unsigned int length)
+{
+  /* Every state has this single call site, so the compiler inlines them
+   * into one function and the switch becomes a jump table */
+  switch (sm->state)
+  {
+    case STATE_INIT_SEARCH_METHOD:
+      return InitSearchMethodState(sm, data, length);
+    case STATE_PARSE_METHOD:
+      return ParseMethodState(sm, data, length);
+    case STATE_POST_METHOD:
+      return PostMethodState(sm, data, length);
+    case STATE_DETECT_URI:
+      return DetectUriState(sm, data, length);
+    case STATE_PARSE_ABS_PATH_RESOURCE:
+      return ParseAbsPathResourceState(sm, data, length);
+    case STATE_INITIALIZE_PARAMETER_ENGINE:
+      return InitializeParameterEngine(sm, data, length);
+    case STATE_PARSE_RESOURCE_ENDING:
+      return ParseResourceEnding(sm, data, length);
+    case STATE_PARSE_URL_ENCODED_FORM_NAME:
+      return ParseUrlEncodedFormName(sm, data, length);
+    case STATE_PARSE_URL_ENCODED_FORM_VALUE:
+      return ParseUrlEncodedFormValue(sm, data, length);
+    case STATE_PARSE_HTTP_VERSION:
+      return ParseHttpVersion(sm, data, length);
+    case STATE_CHECK_HEADER_END:
+      return CheckHeaderEndState(sm, data, length);
+    case STATE_PARSE_PARAMETER_NAME:
+      return ParseParameterNameState(sm, data, length);
+    case STATE_PARSE_PARAMETER_VALUE:
+      return ParseParameterValueState(sm, data, length);
+    case STATE_PARSE_HEADER_VALUE:
+      return ParseHeaderValueState(sm, data, length);
+    case STATE_ANALYZE_ENTITY:
+      return AnalyzeEntityState(sm, data, length);
+    case STATE_PARSE_URL_ENCODED_ENTITY_NAME:
+      return ParseUrlEncodedEntityName(sm, data, length);
+    case STATE_PARSE_URL_ENCODED_ENTITY_VALUE:
+      return ParseUrlEncodedEntityValue(sm, data, length);
+    case STATE_SKIP_ENTITY:
+      return SkipEntityState(sm, data, length);
+    case STATE_CALL_RESOURCE:
+      return CallResourceState(sm, data, length);
+    case STATE_CALL_ERROR_CALLBACK:
+      return CallErrorCallbackState(sm, data, length);
+    case STATE_CONNECTION_CLOSED:
+      return ConnectionClosedState(sm, data, length);
+#if HTTP_DEFERRED_RESOURCES
+    case STATE_DEFERRED_RESOURCE:
+      return DeferredResourceState(sm, data, length);
+#endif
+#if HTTP_RESOURCE_CONTINUATION
+    case STATE_CONTINUE_RESOURCE:
+      return ContinueResourceState(sm, data, length);
+#endif
+#if HTTP_ADMISSION_CONTROL
+    case STATE_REJECT_REQUEST:
+      return RejectRequestState(sm, data, length);
+    case STATE_DISCARD_REQUEST:
+      return DiscardRequestState(sm, data, length);
+#endif
+    default:
+      return 0U;
+  }
+}
+
+/*****************************************************************************/
+/* Local functions (definitions)                                             */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/* Search engine                                                             */
+/*****************************************************************************/
+
+static void SearchEngine_Init(
+    tSearchEntity *const se,
+    const void *array,
+    unsigned int length,
+    tGetElementByIdxCallback getElementByIdx,
+    char *buffer,
+    unsigned char bufferLength)
+{
+  se->array = array;
+  se->buffer = buffer;
+  se->compareIdx = 0U;
+  se->bufferIdx = 0U;
+  se->left = 0U;
+  se->right = length - 1;
+  se->length = length;
+  se->getElementByIdx = getElementByIdx;
+  se->bufferLength = bufferLength;
+}
+
+static void SearchEngine_Reset(
+    tSearchEntity *const se)
+{
+  se->compareIdx = 0U;
+}
+
+static int SearchEngine_Finished(
+    tSearchEntity *const se)
+{
+  int result = 0;
+
+  if (se->left == se->right)
+  {
+    result = 1;
+  }
+  return result;
+}
+
+static int SearchEngine_Compare(
+    char a,
+    char b)
+{
+  int result;
+
+  if (a > b)
+  {
+    result = 1;
+  }
+  else if (a < b)
+  {
+    result = -1;
+  }
+  else
+  {
+    result = 0;
+  }
+  return result;
+}
+
+static int SearchEngine_CopyInput(
+    tSearchEntity *const se,
+    char input)
+{
+  unsigned int result = 0;
+
+  if (se->bufferIdx < se->bufferLength)
+  {
+    se->buffer[se->bufferIdx] = input;
+    ++(se->bufferIdx);
+    result = 1;
+  }
+
+  return result;
+}
+
+static tSearchEngineResult SearchEngine_Search(
+    tSearchEntity *const se,
+    char input,
+    unsigned int *idx)
+{
+  tSearchEngineResult result = SEARCH_ENGINE_ONGOING;
+
+  if (1 != SearchEngine_CopyInput(se, input))
+  {
+    result = SEARCH_ENGINE_BUFFER_EXCEEDED;
+  }
+  else
+  {
+    do
+    {
+      const tStringWithLength *resWithLength;
+
+      *idx = ((se->right - se->left) >> 1) + se->left;
+      resWithLength = (se->getElementByIdx) (se->array, *idx);
+
+      if (se->compareIdx >= resWithLength->length)
+      {
+        if (1 == SearchEngine_Finished(se))
+        {
+          result = SEARCH_ENGINE_NOT_FOUND;
+        }
+        else
+        {
+          SearchEngine_Reset(se);
+        }
+      }
+      else
+      {
+        const char *input = se->buffer + se->compareIdx;
+        const char *resource = resWithLength->str + se->compareIdx;
+        int comparation = SearchEngine_Compare(*input, *resource);
+
+        if (0 == comparation)
+        {
+          ++(se->compareIdx);
+
+          if (resWithLength->length == se->compareIdx)
+          {
+            result = SEARCH_ENGINE_FOUND;
+          }
+        }
+        else
+        {
+          se->compareIdx = 0u;
+          if (1 == SearchEngine_Finished(se))
+          {
+            result = SEARCH_ENGINE_NOT_FOUND;
+          }
+          else if (0 < comparation)
+          {
+            se->left = *idx + 1;
+          }
+          else if (*idx == se->left)
+          {
+            /* Nothing left below, right bound would pass the left one */
+            result = SEARCH_ENGINE_NOT_FOUND;
+          }
+          else
+          {
+            se->right = *idx - 1;
+          }
+        }
+      }
+    }                           /* Process all available chars */
+    while ((se->compareIdx < se->bufferIdx) &&
+        SEARCH_ENGINE_ONGOING == result);
+  }
 
-  if (COMPARE_ENGINE_MATCH == result)
+  return result;
+}
+
+static void CompareEngine_Init(
+    tCompareEntity *const ce)
+{
+  ce->compareIdx = 0U;
+}
+
+static tCompareEngineResult CompareEngine_Compare(
+    tCompareEntity *const ce,
+    char input,
+    const tStringWithLength *pattern)
+{
+  tCompareEngineResult result;
+
+  if (pattern->length <= ce->compareIdx)
   {
-    sm->state = &CheckHeaderEndState;
-    parsed = 1U;
+    result = COMPARE_ENGINE_NOT_MATCH;
   }
-  else if (COMPARE_ENGINE_ONGOING == result)
+  else if (pattern->str[ce->compareIdx] == input)
   {
-    CompareEngine_Increment(&(sm->shared.parse.compareEntity));
-    parsed = 1U;
+    result = COMPARE_ENGINE_ONGOING;
+
+    /* Check if all characters are processed */
+    if ((pattern->length - 1) == ce->compareIdx)
+    {
+      result = COMPARE_ENGINE_MATCH;
+    }
   }
   else
   {
-    tErrorInfo info;
-
-    info.status = HTTP_VERSION_NOT_IMPLEMENTED;
-    Utils_MarkError(conn, info);
-    parsed = 0U;
+    result = COMPARE_ENGINE_NOT_MATCH;
   }
 
-  return parsed;
+  return result;
 }
 
-static unsigned int CheckHeaderEndState(
-    void *const conn,
-    const char *data,
-    unsigned int length)
+static void CompareEngine_Increment(
+    tCompareEntity *const ce)
 {
-  tuCHttpServerState *const sm = conn;
-  unsigned int parsed;
-  tCompareEngineResult result;
+  ++(ce->compareIdx);
+}
 
-  if (1U == Utils_OnInitialization(conn))
-  {
-    CompareEngine_Init(&(sm->shared.parse.compareEntity));
-  }
+static void ResponseEngine_Init(
+    tResponseEntity * const re,
+    void *server)
+{
+  re->server = server;
+  re->send = &ResponseEntity_SendBuffered;
+  re->flush = &ResponseEntity_FlushBuffered;
+  re->type = TRANSFER_TYPE_DEFAULT;
+  re->bufferIdx = 0U;
+  re->bufferStart = 0U;
+  re->head = 0U;
+  re->headerEnd = 0U;
+  if (HTTP_HEAD == ((const tuCHttpServerState *) server)->method)
+  {
+    /* Whatever the resource or error callback renders, only its header
+     * is sent */
+    re->head = 1U;
+    re->send = &ResponseEntity_SendHead;
+  }
+#if HTTP_METRICS
+  re->commits = 0U;
+#endif
+#if HTTP_BUFFER_STATISTICS
+  re->bytes = 0UL;
+#endif
+#if HTTP_ZERO_COPY_RESPONSE || (1 < HTTP_RESPONSE_BUFFERS)
+  re->buffer = NULL;
+  re->bufferLength = 0U;
+#else
+  re->bufferLength = HTTP_BUFFER_LENGTH;
+#endif
+}
 
-  result =
-      CompareEngine_Compare(&(sm->shared.parse.compareEntity), *data,
-      &CRLFwL);
+static void ResponseEngine_SendHeader(
+    tResponseEntity * const re)
+{
+  const tuCHttpServerState *server = re->server;
 
-  if (COMPARE_ENGINE_MATCH == result)
-  {
-    sm->state = &AnalyzeEntityState;
-    parsed = 1U;
-  }
-  else if (COMPARE_ENGINE_ONGOING == result)
+  re->send(re, CONNECTION[server->close].str,
+      CONNECTION[server->close].length);
+  if (TRANSFER_TYPE_LENGTH_BASED == re->type)
   {
-    CompareEngine_Increment(&(sm->shared.parse.compareEntity));
-    parsed = 1U;
+    /* Body follows in the same buffer, the callback flushes both */
+    re->send(re, CRLF, 2);
+    return;
   }
-  else
+
+  re->send(re, "Transfer-Encoding: chunked\r\n", 28);
+  re->send(re, CRLF, 2);
+  re->flush(re);
+
+  /* HEAD keeps dropping the body, so it gets no chunk framing either */
+  if (0U == re->head)
   {
-    ParameterEngine_AddParameterName(&(sm->shared.parse.parameterEntity));
-    sm->state = &ParseParameterNameState;
-    parsed = 0U;
+    re->send = &ResponseEntity_SendChunked;
+    re->flush = &ResponseEntity_FlushChunked;
+    re->bufferStart = CHUNK_PREFIX_LENGTH;
+    re->bufferIdx = CHUNK_PREFIX_LENGTH;
   }
-
-  return parsed;
 }
 
-static unsigned int ParseParameterNameState(
-    void *const conn,
-    const char *data,
+static unsigned int ResponseEntity_SendBuffered(
+    void *const ptr,
+    const void *data,
     unsigned int length)
 {
-  tuCHttpServerState *const sm = conn;
-  unsigned int parsed;
+  tResponseEntity *const re = ptr;
+  const char *text = data;
+  unsigned int sent = 0U;
 
-  if (':' == *data)
-  {
-    ParameterEngine_AddParameterCharacter(&(sm->shared.parse.parameterEntity),
-        '\0');
-    ParameterEngine_AddParameterValue(&(sm->shared.parse.parameterEntity));
-    sm->state = &ParseParameterValueState;
-    parsed = 1U;
-  }
-  else
+  while (length)
   {
-#if HTTP_ERROR_ON_TOO_MANY_PARAMETERS
-    tParameterEngineResult paramResult =
-#endif
-    ParameterEngine_AddParameterCharacter(&(sm->shared.
-            parse.parameterEntity), *data);
-
-#if HTTP_ERROR_ON_TOO_MANY_PARAMETERS
-    if (PARAMETER_ENGINE_OK == paramResult)
+    ResponseEngine_Acquire(re);
+    if (re->bufferIdx < re->bufferLength)
     {
-      parsed = 1U;
+      re->buffer[re->bufferIdx] = *text;
+      ++text;
+      --length;
+      ++(re->bufferIdx);
+      ++sent;
     }
     else
     {
-      tErrorInfo info;
-
-      info.status = HTTP_REQUEST_HEADER_FIELDS_TOO_LARGE;
-      Utils_MarkError(conn, info);
-      parsed = 0U;
+      ResponseEngine_Commit(re, 0U);
     }
-#else
-    parsed = 1U;
-#endif
   }
 
-  return parsed;
+  return sent;
 }
 
-static unsigned int ParseParameterValueState(
-    void *const conn,
-    const char *data,
-    unsigned int length)
+static void ResponseEntity_FlushBuffered(
+    void *const ptr)
 {
-  tuCHttpServerState *const sm = conn;
-  unsigned int parsed;
-  tCompareEngineResult result;
+  tResponseEntity *const re = ptr;
 
-  if (1U == Utils_OnInitialization(conn))
+  if (0U < re->bufferIdx)
   {
-    CompareEngine_Init(&(sm->shared.parse.compareEntity));
+    ResponseEngine_Commit(re, 0U);
   }
+}
 
-  result =
-      CompareEngine_Compare(&(sm->shared.parse.compareEntity), *data,
-      &CRLFwL);
+static unsigned int ResponseEntity_SendHead(
+    void *const ptr,
+    const void *data,
+    unsigned int length)
+{
+  tResponseEntity *const re = ptr;
+  const char *text = data;
+  unsigned int header = 0U;
 
-  if (COMPARE_ENGINE_MATCH == result)
-  {
-    ParameterEngine_AddParameterCharacter(&(sm->shared.parse.parameterEntity),
-        '\0');
-    sm->state = &CheckHeaderEndState;
-    parsed = 1U;
-  }
-  else if (COMPARE_ENGINE_ONGOING == result)
-  {
-    CompareEngine_Increment(&(sm->shared.parse.compareEntity));
-    parsed = 1U;
-  }
-  else
+  /* Header passes up to its empty line, everything after is dropped */
+  while (header < length && sizeof(HEADER_END) - 1U > re->headerEnd)
   {
-    if (' ' == *data || '\t' == *data)
+    if (HEADER_END[re->headerEnd] == text[header])
     {
-      /* Ignore Linear White Space */
-      parsed = 1U;
+      ++(re->headerEnd);
     }
     else
     {
-#if HTTP_ERROR_ON_TOO_MANY_PARAMETERS
-      tParameterEngineResult paramResult =
-#endif
-      ParameterEngine_AddParameterCharacter(&(sm->shared.
-              parse.parameterEntity), *data);
-#if HTTP_ERROR_ON_TOO_MANY_PARAMETERS
-      if (PARAMETER_ENGINE_OK == paramResult)
-      {
-        parsed = 1U;
-      }
-      else
-      {
-        tErrorInfo info;
-
-        info.status = HTTP_REQUEST_HEADER_FIELDS_TOO_LARGE;
-        Utils_MarkError(conn, info);
-        parsed = 0U;
-      }
-#else
-      parsed = 1u;
-#endif
+      re->headerEnd = (HEADER_END[0] == text[header]) ? 1U : 0U;
     }
+    ++header;
+  }
+  if (0U < header)
+  {
+    ResponseEntity_SendBuffered(re, text, header);
   }
 
-  return parsed;
+  return length;
 }
 
-static unsigned int AnalyzeEntityState(
-    void *const conn,
-    const char *data,
+static unsigned int ResponseEntity_SendChunked(
+    void *const ptr,
+    const void *data,
     unsigned int length)
 {
-  tuCHttpServerState *const sm = conn;
-  const char *content = Http_HelperGetParameter(sm, "Content-Type");
-  const char *contentLength = Http_HelperGetParameter(sm, "Content-Length");
+  tResponseEntity *const re = ptr;
+  const char *text = data;
+  unsigned int sent = 0U;
 
-  if (NULL == content)
-  {
-    sm->state = &CallResourceState;
-  }
-  else if (0 ==
-      Utils_SearchNullTerminatedPattern("application/x-www-form-urlencoded",
-          content))
+  while (length)
   {
-    if (NULL != contentLength)
+    ResponseEngine_Acquire(re);
+    if (re->bufferIdx < (re->bufferLength - CHUNK_SUFFIX_LENGTH))
     {
-      sm->contentLength = Utils_AtoiNullTerminated(contentLength);
-      if (0U < sm->contentLength)
-      {
-        ParameterEngine_AddParameterName(&(sm->shared.parse.parameterEntity));
-        sm->state = &ParseUrlEncodedEntityName;
-      }
-      else
-      {
-        tErrorInfo info;
-
-        info.status = HTTP_BAD_REQUEST;
-        Utils_MarkError(conn, info);
-      }
+      re->buffer[re->bufferIdx] = *text;
+      ++text;
+      --length;
+      ++(re->bufferIdx);
+      ++sent;
     }
     else
     {
-      tErrorInfo info;
-
-      info.status = HTTP_LENGTH_REQUIRED;
-      Utils_MarkError(conn, info);
+      ResponseEngine_Commit(re, ResponseEngine_FrameChunk(re));
     }
   }
-  else
-  {
-    sm->state = &CallResourceState;
-  }
-  return 0U;
+
+  return sent;
 }
 
-static unsigned int ParseUrlEncodedEntityName(
-    void *const conn,
-    const char *data,
-    unsigned int length)
+static void ResponseEntity_FlushChunked(
+    void *const ptr)
 {
-  tuCHttpServerState *const sm = conn;
-  unsigned int parsed;
+  tResponseEntity *const re = ptr;
+  unsigned int start;
+
+  ResponseEngine_Acquire(re);
+  start = ResponseEngine_FrameChunk(re);
+
+  /* last-chunk shares the region with the remaining data */
+  re->buffer[re->bufferIdx++] = '0';
+  re->buffer[re->bufferIdx++] = '\r';
+  re->buffer[re->bufferIdx++] = '\n';
+  re->buffer[re->bufferIdx++] = '\r';
+  re->buffer[re->bufferIdx++] = '\n';
+  ResponseEngine_Commit(re, start);
+}
 
-  if (1U == sm->contentLength)
-  {
-    ParameterEngine_AddParameterCharacter(&(sm->shared.parse.parameterEntity),
-        *data);
-    ParameterEngine_AddParameterCharacter(&(sm->shared.parse.parameterEntity),
-        '\0');
-    sm->state = &CallResourceState;
-    parsed = 1U;
-  }
-  else if ('=' == *data)
+static void ResponseEngine_Acquire(
+    tResponseEntity * const re)
+{
+#if HTTP_ZERO_COPY_RESPONSE
+  tuCHttpServerState *server = re->server;
+
+  if (NULL == re->buffer)
   {
-    ParameterEngine_AddParameterCharacter(&(sm->shared.parse.parameterEntity),
-        '\0');
-    ParameterEngine_AddParameterValue(&(sm->shared.parse.parameterEntity));
-    sm->contentLength--;
-    sm->state = &ParseUrlEncodedEntityValue;
-    parsed = 1U;
+    if (NULL != server->acquire)
+    {
+      re->buffer = server->acquire(re->server, &(re->bufferLength));
+    }
+    if (NULL == re->buffer)
+    {
+      /* Port is out of regions - output is copied by the send callback */
+      re->buffer = re->fallback;
+      re->bufferLength = sizeof(re->fallback);
+    }
+    re->bufferIdx = re->bufferStart;
   }
-  else
+#elif 1 < HTTP_RESPONSE_BUFFERS
+  tuCHttpServerState *server = re->server;
+
+  if (NULL == re->buffer)
   {
-    ParameterEngine_AddParameterCharacter(&(sm->shared.parse.parameterEntity),
-        *data);
-    sm->contentLength--;
-    parsed = 1U;
+    /* All slots are being transmitted - wait for completion */
+    while (HTTP_RESPONSE_BUFFERS ==
+        (unsigned char) (server->ring.committed - server->ring.released))
+    {
+      HTTP_WAIT_FOR_BUFFER(re->server);
+    }
+    re->buffer = server->ring.buffer[server->ring.head];
+    re->bufferLength = HTTP_BUFFER_LENGTH;
+    re->bufferIdx = re->bufferStart;
   }
-
-  return parsed;
+#endif
 }
 
-static unsigned int ParseUrlEncodedEntityValue(
-    void *const conn,
-    const char *data,
-    unsigned int length)
+static void ResponseEngine_Commit(
+    tResponseEntity * const re,
+    unsigned int start)
 {
-  tuCHttpServerState *const sm = conn;
-  unsigned int parsed;
+  tuCHttpServerState *server = re->server;
 
-  if (1U == sm->contentLength)
+#if HTTP_TRACING
+  Utils_Trace(server, HTTP_TRACE_SEND, 0U, re->bufferIdx - start);
+#endif
+#if HTTP_BUFFER_STATISTICS
+  re->bytes += re->bufferIdx - start;
+#endif
+#if HTTP_METRICS
+  ++(re->commits);
+  if (NULL != server->metrics)
   {
-    ParameterEngine_AddParameterCharacter(&(sm->shared.parse.parameterEntity),
-        *data);
-    ParameterEngine_AddParameterCharacter(&(sm->shared.parse.parameterEntity),
-        '\0');
-    sm->state = &CallResourceState;
-    parsed = 1U;
+    HTTP_ATOMIC_ADD(server->metrics->sends, 1UL);
+    HTTP_ATOMIC_ADD(server->metrics->bytesOut, re->bufferIdx - start);
   }
-  else if ('&' == *data)
+#endif
+#if HTTP_ZERO_COPY_RESPONSE
+  if (re->fallback == re->buffer)
   {
-    ParameterEngine_AddParameterCharacter(&(sm->shared.parse.parameterEntity),
-        '\0');
-    ParameterEngine_AddParameterName(&(sm->shared.parse.parameterEntity));
-    sm->contentLength--;
-    sm->state = &ParseUrlEncodedEntityName;
-    parsed = 1U;
+    server->send(re->server, re->buffer + start, re->bufferIdx - start);
   }
   else
   {
-    ParameterEngine_AddParameterCharacter(&(sm->shared.parse.parameterEntity),
-        *data);
-    sm->contentLength--;
-    parsed = 1U;
+    server->commit(re->server, re->buffer + start, re->bufferIdx - start);
   }
-
-  return parsed;
+  re->buffer = NULL;
+#elif 1 < HTTP_RESPONSE_BUFFERS
+  /* Slot is handed over to the transport until Http_OutputComplete */
+  ++(server->ring.committed);
+  server->ring.head = (unsigned char) ((server->ring.head + 1U) %
+      HTTP_RESPONSE_BUFFERS);
+  server->send(re->server, re->buffer + start, re->bufferIdx - start);
+  re->buffer = NULL;
+#else
+  server->send(re->server, re->buffer + start, re->bufferIdx - start);
+#endif
+  re->bufferIdx = re->bufferStart;
 }
 
-static unsigned int CallResourceState(
-    void *const conn,
-    const char *data,
-    unsigned int length)
+static void ResponseEngine_Release(
+    tResponseEntity * const re)
 {
-  tuCHttpServerState *const sm = conn;
+#if HTTP_ZERO_COPY_RESPONSE || HTTP_METRICS || HTTP_BUFFER_STATISTICS
+  tuCHttpServerState *server = re->server;
+#endif
+#if HTTP_BUFFER_STATISTICS
+  tHttpBufferStatistics sample = { 0UL, 0UL, 0UL, 0UL, 0UL };
 
-  if (1U == Utils_OnInitialization(conn))
+  sample.responsePeak = re->bytes;
+  Utils_BufferAccount(server, &sample);
+#endif
+
+#if HTTP_METRICS
+  if (NULL != server->metrics)
   {
-    ResponseEngine_Init(&(sm->shared.content.responseEntity), sm);
-  }
+    unsigned int bucket = 0U;
+    unsigned int bound = 1U;
 
-  (*sm->resources)[sm->resourceIdx].callback(conn);
-  /* End of parsing request */
-  sm->state = &InitSearchMethodState;
-  return 0U;
+    while (HTTP_METRICS_SEND_BUCKETS - 1U > bucket && re->commits > bound)
+    {
+      ++bucket;
+      bound <<= 1;
+    }
+    HTTP_ATOMIC_ADD(server->metrics->sendBuckets[bucket], 1UL);
+  }
+#endif
+#if HTTP_ZERO_COPY_RESPONSE
+  if (NULL != re->buffer && re->fallback != re->buffer)
+  {
+    server->commit(re->server, re->buffer, 0U);
+  }
+  re->buffer = NULL;
+#elif 1 < HTTP_RESPONSE_BUFFERS
+  /* Slot was not committed, it is reused by the next response */
+  re->buffer = NULL;
+#endif
 }
 
-static unsigned int CallErrorCallbackState(
-    void *const conn,
-    const char *data,
-    unsigned int length)
+static unsigned int ResponseEngine_FrameChunk(
+    tResponseEntity * const re)
 {
-  tuCHttpServerState *const sm = conn;
+  unsigned int start = re->bufferStart;
 
-  if (1U == Utils_OnInitialization(conn))
+  if (re->bufferStart < re->bufferIdx)
   {
-    ResponseEngine_Init(&(sm->shared.content.responseEntity), sm);
+    char buf[CHUNK_PREFIX_LENGTH - 1U];
+    unsigned int len =
+        Utils_Uitoh(re->bufferIdx - re->bufferStart, buf, sizeof(buf));
+    unsigned int i;
+
+    /* chunk-size is placed right before the data */
+    start = re->bufferStart - 2U - len;
+    for (i = 0U; i < len; i++)
+    {
+      re->buffer[start + i] = buf[i];
+    }
+    re->buffer[re->bufferStart - 2U] = '\r';
+    re->buffer[re->bufferStart - 1U] = '\n';
+    re->buffer[re->bufferIdx++] = '\r';
+    re->buffer[re->bufferIdx++] = '\n';
   }
 
-  sm->onError(conn, &(sm->shared.content.errorInfo));
-  sm->state = &InitSearchMethodState;
-  return length;
+  return start;
 }
 
-/*****************************************************************************/
-/* Local functions (definitions)                                             */
-/*****************************************************************************/
-
-/*****************************************************************************/
-/* Search engine                                                             */
-/*****************************************************************************/
-
-static void SearchEngine_Init(
-    tSearchEntity *const se,
-    const void *array,
-    unsigned int length,
-    tGetElementByIdxCallback getElementByIdx,
-    char *buffer,
-    unsigned char bufferLength)
+static const tStringWithLength *Utils_GetMethodByIdx(
+    const void *arr,
+    unsigned int idx)
 {
-  se->array = array;
-  se->buffer = buffer;
-  se->compareIdx = 0U;
-  se->bufferIdx = 0U;
-  se->left = 0U;
-  se->right = length - 1;
-  se->length = length;
-  se->getElementByIdx = getElementByIdx;
-  se->bufferLength = bufferLength;
+  const tStringWithLength (
+      *methods)[] = arr;
+
+  return &((*methods)[idx]);
 }
 
-static void SearchEngine_Reset(
-    tSearchEntity *const se)
+static const tStringWithLength *Utils_GetResourceByIdx(
+    const void *arr,
+    unsigned int idx)
 {
-  se->compareIdx = 0U;
+  const tResourceEntry (
+      *resources)[] = arr;
+
+  return &(((*resources)[idx]).name);
 }
 
-static int SearchEngine_Finished(
-    tSearchEntity *const se)
+static void Utils_MarkError(
+    void *const conn,
+    tErrorInfo info)
 {
-  int result = 0;
+  tuCHttpServerState *const sm = conn;
 
-  if (se->left == se->right)
+#if HTTP_TRACING
+  Utils_Trace(sm, HTTP_TRACE_ERROR, 0U,
+      (unsigned long) Utils_AtoiNullTerminated(statuscodes[info.status][0]));
+#endif
+#if HTTP_METRICS
+  if (NULL != sm->metrics)
   {
-    result = 1;
+    HTTP_ATOMIC_ADD(sm->metrics->errors[info.status], 1UL);
   }
-  return result;
+#endif
+  sm->shared.content.errorInfo = info;
+  sm->state = STATE_CALL_ERROR_CALLBACK;
 }
 
-static int SearchEngine_Compare(
-    char a,
-    char b)
+static void Utils_RunResource(
+    tuCHttpServerState *const sm)
 {
-  int result;
+#if HTTP_PROFILING
+  unsigned long start = (NULL != sm->profile) ? HTTP_CLOCK() : 0UL;
+#endif
+#if HTTP_LATENCY_HISTOGRAMS
+  tHttpLatency *latency = NULL;
+  unsigned long entry = 0UL;
 
-  if (a > b)
+  if (NULL != sm->latencies &&
+      sm->resourceIdx < sm->latencies->resourcesLength)
   {
-    result = 1;
+    latency = &(sm->latencies->resources[sm->resourceIdx]);
+    entry = HTTP_CLOCK();
   }
-  else if (a < b)
+#endif
+#if HTTP_RESOURCE_CONTINUATION
+  sm->yielded = 0U;
+#endif
+#if HTTP_TRACING
+  Utils_Trace(sm, HTTP_TRACE_HANDLER_START, 0U, sm->resourceIdx);
+#endif
+  (*sm->resources)[sm->resourceIdx].callback(sm);
+#if HTTP_PROFILING
+  if (NULL != sm->profile && NULL != sm->profile->resources &&
+      sm->resourceIdx < sm->profile->resourcesLength)
   {
-    result = -1;
+    Utils_ProfileAccount(&(sm->profile->resources[sm->resourceIdx]), start);
+  }
+#endif
+#if HTTP_LATENCY_HISTOGRAMS
+  if (NULL != latency)
+  {
+    unsigned long now = HTTP_CLOCK();
+
+    Http_HistogramRecord(&(latency->handler), now - entry);
+#if HTTP_RESOURCE_CONTINUATION
+    if (!sm->yielded)
+#endif
+    {
+      /* Final flush is done by the callback that did not yield */
+      Http_HistogramRecord(&(latency->request), now - sm->requestStart);
+    }
+  }
+#endif
+#if HTTP_TRACING
+#if HTTP_RESOURCE_CONTINUATION
+  Utils_Trace(sm, HTTP_TRACE_HANDLER_END, 0U, sm->yielded);
+#else
+  Utils_Trace(sm, HTTP_TRACE_HANDLER_END, 0U, 0UL);
+#endif
+#endif
+#if HTTP_RESOURCE_CONTINUATION
+  if (sm->yielded)
+  {
+    /* Response in progress - engine keeps its buffer until next slice */
+    sm->state = STATE_CONTINUE_RESOURCE;
   }
   else
+#endif
   {
-    result = 0;
+#if HTTP_RESOURCE_CONTINUATION
+    sm->cursor = 0UL;
+#endif
+    ResponseEngine_Release(&(sm->shared.content.responseEntity));
+    /* End of parsing request */
+    sm->state = (0U == sm->close) ?
+        STATE_INIT_SEARCH_METHOD : STATE_CONNECTION_CLOSED;
   }
-  return result;
 }
 
-static int SearchEngine_CopyInput(
-    tSearchEntity *const se,
-    char input)
+static void Utils_ExpectContinue(
+    tuCHttpServerState *const sm)
 {
-  unsigned int result = 0;
+  const tResourceEntry *resource = &((*sm->resources)[sm->resourceIdx]);
+  tErrorInfo info;
 
-  if (se->bufferIdx < se->bufferLength)
+  info.status = (NULL == resource->expect) ?
+      HTTP_STATUS_CONTINUE : resource->expect(sm);
+  if (HTTP_STATUS_CONTINUE == info.status)
   {
-    se->buffer[se->bufferIdx] = input;
-    ++(se->bufferIdx);
-    result = 1;
+    tResponseEntity *const re = &(sm->shared.content.responseEntity);
+    /* Response engine shares the area, parsing of the body resumes */
+    const tParsePhaseArea parse = sm->shared.parse;
+
+#if HTTP_METRICS
+    if (NULL != sm->metrics)
+    {
+      HTTP_ATOMIC_ADD(sm->metrics->statuses[HTTP_STATUS_CONTINUE], 1UL);
+    }
+#endif
+    ResponseEngine_Init(re, sm);
+    re->send(re, CONTINUE.str, CONTINUE.length);
+    re->flush(re);
+    ResponseEngine_Release(re);
+    sm->shared.parse = parse;
+  }
+  else
+  {
+    /* Body is never read, the connection closes after the rejection */
+    Utils_MarkError(sm, info);
   }
+}
 
-  return result;
+static void Utils_ResetHeaders(
+    tHttpHeaders *const headers)
+{
+  headers->contentLength = 0UL;
+  headers->contentType = NULL;
+  headers->host = NULL;
+  headers->ifNoneMatch = NULL;
+  headers->range = NULL;
+  headers->present = 0U;
+  headers->media = HTTP_MEDIA_NONE;
+  headers->connection = 0U;
+  headers->encodings = 0U;
+  headers->expect = 0U;
+  headers->chunked = 0U;
 }
 
-static tSearchEngineResult SearchEngine_Search(
-    tSearchEntity *const se,
-    char input,
-    unsigned int *idx)
+static unsigned short Utils_HotHeader(
+    const char *name)
 {
-  tSearchEngineResult result = SEARCH_ENGINE_ONGOING;
+  unsigned int i;
 
-  if (1 != SearchEngine_CopyInput(se, input))
+  for (i = 0U; i < sizeof(hotHeaders) / sizeof(hotHeaders[0]); i++)
   {
-    result = SEARCH_ENGINE_BUFFER_EXCEEDED;
+    if (0U == Utils_SearchNullTerminatedPattern(hotHeaders[i], name))
+    {
+      return (unsigned short) (1U << i);
+    }
   }
-  else
+  return 0U;
+}
+
+static const char *Utils_KeptHeader(
+    tuCHttpServerState *const sm,
+    unsigned short header)
+{
+  switch (header)
   {
-    do
-    {
-      const tStringWithLength *resWithLength;
+    case HTTP_HEADER_CONTENT_TYPE:
+      return sm->headers.contentType;
+    case HTTP_HEADER_HOST:
+      return sm->headers.host;
+    case HTTP_HEADER_IF_NONE_MATCH:
+      return sm->headers.ifNoneMatch;
+    case HTTP_HEADER_RANGE:
+      return sm->headers.range;
+    default:
+      return NULL;
+  }
+}
 
-      *idx = ((se->right - se->left) >> 1) + se->left;
-      resWithLength = (se->getElementByIdx) (se->array, *idx);
+static void Utils_HeaderBegin(
+    tuCHttpServerState *const sm)
+{
+  tHeaderEntity *const he = &(sm->shared.parse.headerEntity);
+  tHttpHeaders *const headers = &(sm->headers);
+  const char *value = NULL;
 
-      if (se->compareIdx >= resWithLength->length)
-      {
-        if (1 == SearchEngine_Finished(se))
-        {
-          result = SEARCH_ENGINE_NOT_FOUND;
-        }
-        else
-        {
-          SearchEngine_Reset(se);
-        }
-      }
-      else
-      {
-        const char *input = se->buffer + se->compareIdx;
-        const char *resource = resWithLength->str + se->compareIdx;
-        int comparation = SearchEngine_Compare(*input, *resource);
+  HeaderEngine_Init(he);
+  if (HTTP_HEADER_CONTENT_LENGTH == he->header &&
+      0U != (HTTP_HEADER_CONTENT_LENGTH & headers->present))
+  {
+    he->repeated = 1U;
+    he->previousLength = headers->contentLength;
+  }
+  headers->present |= he->header;
+  if (0U != (HEADERS_KEPT & he->header))
+  {
+    value = ParameterEngine_AddString(&(sm->shared.parse.parameterEntity));
+  }
 
-        if (0 == comparation)
-        {
-          ++(se->compareIdx);
+  /* Repeated header - the last one counts, Content-Length has to repeat
+   * the same value or the body could be framed two ways */
+  switch (he->header)
+  {
+    case HTTP_HEADER_CONTENT_LENGTH:
+      headers->contentLength = 0UL;
+      break;
+    case HTTP_HEADER_CONTENT_TYPE:
+      headers->contentType = value;
+      break;
+    case HTTP_HEADER_TRANSFER_ENCODING:
+      headers->chunked = 0U;
+      break;
+    case HTTP_HEADER_HOST:
+      headers->host = value;
+      break;
+    case HTTP_HEADER_IF_NONE_MATCH:
+      headers->ifNoneMatch = value;
+      break;
+    case HTTP_HEADER_RANGE:
+      headers->range = value;
+      break;
+    default:
+      break;
+  }
+}
 
-          if (resWithLength->length == se->compareIdx)
-          {
-            result = SEARCH_ENGINE_FOUND;
-          }
-        }
-        else
-        {
-          se->compareIdx = 0u;
-          if (1 == SearchEngine_Finished(se))
-          {
-            result = SEARCH_ENGINE_NOT_FOUND;
-          }
-          else if (0 < comparation)
-          {
-            se->left = *idx + 1;
-          }
-          else if (0 > comparation)
-          {
-            se->right = *idx - 1;
-          }
-        }
-      }
-    }                           /* Process all available chars */
-    while ((se->compareIdx < se->bufferIdx) &&
-        SEARCH_ENGINE_ONGOING == result);
+static unsigned char Utils_HeaderCharacter(
+    tuCHttpServerState *const sm,
+    char ch)
+{
+  tHeaderEntity *const he = &(sm->shared.parse.headerEntity);
+  tErrorInfo info;
+
+  if (HTTP_HEADER_CONTENT_LENGTH == he->header)
+  {
+    unsigned long digit = (unsigned long) (ch - '0');
+
+    if ('0' <= ch && '9' >= ch &&
+        sm->headers.contentLength <= (~0UL - digit) / 10UL)
+    {
+      sm->headers.contentLength = sm->headers.contentLength * 10UL + digit;
+      he->tokenLength = 1U;     /* Has a digit */
+      return 1U;
+    }
+    /* Signs, lists and overflowing lengths alike */
+    info.status = HTTP_BAD_REQUEST;
+    Utils_MarkError(sm, info);
+    return 0U;
   }
 
-  return result;
+  if (0U != (HEADERS_TOKENIZED & he->header) &&
+      1U == HeaderEngine_AddCharacter(he, ch))
+  {
+    Utils_HeaderElement(sm);
+  }
+  if (0U != (HEADERS_KEPT & he->header))
+  {
+#if HTTP_ERROR_ON_TOO_MANY_PARAMETERS
+    if (PARAMETER_ENGINE_OK !=
+        ParameterEngine_AddParameterCharacter(&(sm->shared.
+                parse.parameterEntity), ch))
+    {
+      info.status = HTTP_REQUEST_HEADER_FIELDS_TOO_LARGE;
+      Utils_MarkError(sm, info);
+      return 0U;
+    }
+#else
+    ParameterEngine_AddParameterCharacter(&(sm->shared.parse.parameterEntity),
+        ch);
+#endif
+  }
+  return 1U;
 }
 
-static void CompareEngine_Init(
-    tCompareEntity *const ce)
+static void Utils_HeaderElement(
+    tuCHttpServerState *const sm)
 {
-  ce->compareIdx = 0U;
+  tHeaderEntity *const he = &(sm->shared.parse.headerEntity);
+  tHttpHeaders *const headers = &(sm->headers);
+  const unsigned char known = (HEADER_VALUE_EMPTY != he->value &&
+      HEADER_VALUE_UNKNOWN != he->value) ? 1U : 0U;
+
+  switch (he->header)
+  {
+    case HTTP_HEADER_CONNECTION:
+      headers->connection |= known ? he->value : 0U;
+      break;
+    case HTTP_HEADER_ACCEPT_ENCODING:
+      headers->encodings |= (known && 0U == he->rejected) ? he->value : 0U;
+      break;
+    case HTTP_HEADER_EXPECT:
+      headers->expect |= known ? he->value :
+          (HEADER_VALUE_UNKNOWN == he->value) ? HTTP_EXPECT_OTHER : 0U;
+      break;
+    case HTTP_HEADER_TRANSFER_ENCODING:
+      if (HEADER_VALUE_EMPTY != he->value)
+      {
+        /* Only the last coding frames the body */
+        headers->chunked = known;
+      }
+      break;
+    case HTTP_HEADER_CONTENT_TYPE:
+      if (0U == he->elements)
+      {
+        headers->media = known ? he->value : HTTP_MEDIA_OTHER;
+      }
+      break;
+    default:
+      break;
+  }
+  HeaderEngine_NextElement(he);
 }
 
-static tCompareEngineResult CompareEngine_Compare(
-    tCompareEntity *const ce,
-    char input,
-    const tStringWithLength *pattern)
+static void Utils_HeaderEnd(
+    tuCHttpServerState *const sm)
 {
-  tCompareEngineResult result;
+  tHeaderEntity *const he = &(sm->shared.parse.headerEntity);
 
-  if (pattern->length <= ce->compareIdx)
+  if (0U != (HEADERS_TOKENIZED & he->header))
   {
-    result = COMPARE_ENGINE_NOT_MATCH;
+    HeaderEngine_Finish(he);
+    Utils_HeaderElement(sm);
   }
-  else if (pattern->str[ce->compareIdx] == input)
+  if (0U != (HEADERS_KEPT & he->header))
   {
-    result = COMPARE_ENGINE_ONGOING;
-
-    /* Check if all characters are processed */
-    if ((pattern->length - 1) == ce->compareIdx)
-    {
-      result = COMPARE_ENGINE_MATCH;
-    }
+    ParameterEngine_AddParameterCharacter(&(sm->shared.parse.parameterEntity),
+        '\0');
   }
-  else
+  if (HTTP_HEADER_CONTENT_LENGTH == he->header && (0U == he->tokenLength ||
+          (0U != he->repeated &&
+              he->previousLength != sm->headers.contentLength)))
   {
-    result = COMPARE_ENGINE_NOT_MATCH;
-  }
+    tErrorInfo info;
 
-  return result;
+    info.status = HTTP_BAD_REQUEST;
+    Utils_MarkError(sm, info);
+  }
 }
 
-static void CompareEngine_Increment(
-    tCompareEntity *const ce)
-{
-  ++(ce->compareIdx);
+#if HTTP_TRACING
+static void Utils_Trace(
+    tuCHttpServerState *const sm,
+    tHttpTraceType type,
+    unsigned char detail,
+    unsigned long arg)
+{
+  tHttpTrace *const trace = sm->trace;
+  tHttpTraceEvent *event;
+  unsigned long position;
+
+  if (NULL == trace)
+  {
+    return;
+  }
+
+  /* Slot is reserved first - deferred resources record from other
+   * threads into the ring of their loop */
+  position = HTTP_ATOMIC_ADD(trace->head, 1UL) - 1UL;
+  event = &(trace->events[position & trace->mask]);
+  event->time = HTTP_CLOCK();
+  event->arg = arg;
+  event->connection = sm->traceId;
+  event->type = (unsigned char) type;
+  event->detail = detail;
+  /* Published last, Http_TraceCopy skips the slot until then */
+  HTTP_ATOMIC_STORE(event->sequence, position + 1UL);
 }
+#endif
 
-static void ResponseEngine_Init(
-    tResponseEntity * const re,
-    void *server)
+#if HTTP_PROFILING
+static void Utils_ProfileAccount(
+    tHttpProfileCounter *counter,
+    unsigned long start)
 {
-  re->server = server;
-  re->send = &ResponseEntity_SendBuffered;
-  re->flush = &ResponseEntity_FlushBuffered;
-  re->type = TRANSFER_TYPE_DEFAULT;
-  re->bufferIdx = 0U;
+  /* Unsigned difference survives counter wrap-around */
+  HTTP_ATOMIC_ADD(counter->time, HTTP_CLOCK() - start);
+  HTTP_ATOMIC_ADD(counter->calls, 1UL);
 }
+#endif
 
-static void ResponseEngine_SendHeader(
-    tResponseEntity * const re)
+#if HTTP_LATENCY_HISTOGRAMS || HTTP_BUFFER_STATISTICS
+static void Utils_AtomicMax(
+    unsigned long *counter,
+    unsigned long value)
 {
-  if (TRANSFER_TYPE_DEFAULT == re->type ||
-      TRANSFER_TYPE_CHUNKED == re->type)
-  {
-    re->send(re, "Transfer-Encoding: chunked\r\n", 28);
-  }
-
-  re->send(re, CRLF, 2);
-  re->flush(re);
+  unsigned long seen = 0UL;
 
-  if (TRANSFER_TYPE_DEFAULT == re->type ||
-      TRANSFER_TYPE_CHUNKED == re->type)
+  /* Failed exchange reloads seen, a larger value wins over this one */
+  while (seen < value && 0 == HTTP_ATOMIC_CAS(*counter, seen, value))
   {
-    re->send = &ResponseEntity_SendChunked;
-    re->flush = &ResponseEntity_FlushChunked;
   }
 }
+#endif
 
-static unsigned int ResponseEntity_SendBuffered(
-    void *const ptr,
-    const void *data,
-    unsigned int length)
+#if HTTP_BUFFER_STATISTICS
+static void Utils_BufferAccount(
+    tuCHttpServerState *const sm,
+    const tHttpBufferStatistics *sample)
 {
-  tResponseEntity *const re = ptr;
-  tuCHttpServerState *server = re->server;
-  const char *text = data;
-  unsigned int sent = 0U;
-
-  while (length)
+  Http_BufferStatisticsMerge(&(sm->buffers), sample);
+#if HTTP_METRICS
+  if (NULL != sm->metrics)
   {
-    if (re->bufferIdx < HTTP_BUFFER_LENGTH)
-    {
-      re->buffer[re->bufferIdx] = *text;
-      ++text;
-      --length;
-      ++(re->bufferIdx);
-      ++sent;
-    }
-    else
-    {
-      server->send(re->server, re->buffer, HTTP_BUFFER_LENGTH);
-      re->bufferIdx = 0U;
-    }
+    Http_BufferStatisticsMerge(&(sm->metrics->buffers), sample);
   }
-
-  return sent;
+#endif
 }
+#endif
 
-static void ResponseEntity_FlushBuffered(
-    void *const ptr)
+#if HTTP_METRICS
+static unsigned long Utils_MetricsSum(
+    const tHttpMetrics *metrics,
+    const unsigned long *counter)
 {
-  tResponseEntity *const re = ptr;
-  tuCHttpServerState *server = re->server;
+  /* Same counter of every metrics in the ring */
+  const unsigned long offset =
+      (unsigned long) ((const char *) counter - (const char *) metrics);
+  const tHttpMetrics *m = metrics;
+  unsigned long sum = 0UL;
 
-  if (0U < re->bufferIdx)
+  do
   {
-    server->send(re->server, re->buffer, re->bufferIdx);
-    re->bufferIdx = 0U;
+    sum += *((const unsigned long *) ((const char *) m + offset));
+    m = m->next;
   }
+  while (NULL != m && metrics != m);
+
+  return sum;
 }
 
-static unsigned int ResponseEntity_SendChunked(
-    void *const ptr,
-    const void *data,
-    unsigned int length)
+#if HTTP_BUFFER_STATISTICS
+static unsigned long Utils_MetricsMax(
+    const tHttpMetrics *metrics,
+    const unsigned long *counter)
 {
-  tResponseEntity *const re = ptr;
-  tuCHttpServerState *server = re->server;
-  const char *text = data;
-  unsigned int sent = 0U;
+  const unsigned long offset =
+      (unsigned long) ((const char *) counter - (const char *) metrics);
+  const tHttpMetrics *m = metrics;
+  unsigned long max = 0UL;
 
-  while (length)
+  do
   {
-    if (re->bufferIdx < HTTP_BUFFER_LENGTH)
-    {
-      re->buffer[re->bufferIdx] = *text;
-      ++text;
-      --length;
-      ++(re->bufferIdx);
-      ++sent;
-    }
-    else
-    {
-      char buf[5];
-      unsigned int len = Utils_Uitoh(HTTP_BUFFER_LENGTH, buf, 5);
+    unsigned long value =
+        *((const unsigned long *) ((const char *) m + offset));
 
-      server->send(re->server, buf, len);
-      server->send(re->server, CRLF, 2);
-      server->send(re->server, re->buffer, HTTP_BUFFER_LENGTH);
-      server->send(re->server, CRLF, 2);
-      re->bufferIdx = 0U;
+    if (value > max)
+    {
+      max = value;
     }
+    m = m->next;
   }
+  while (NULL != m && metrics != m);
 
-  return sent;
+  return max;
 }
+#endif
 
-static void ResponseEntity_FlushChunked(
-    void *const ptr)
+static unsigned long Utils_MetricsSumResource(
+    const tHttpMetrics *metrics,
+    unsigned int idx)
 {
-  tResponseEntity *const re = ptr;
-  tuCHttpServerState *server = re->server;
-  char buf[5];
-  unsigned int len;
+  const tHttpMetrics *m = metrics;
+  unsigned long sum = 0UL;
 
-  if (0U < re->bufferIdx)
+  do
   {
-    len = Utils_Uitoh(re->bufferIdx, buf, 5);
-    server->send(re->server, buf, len);
-    server->send(re->server, CRLF, 2);
-    server->send(re->server, re->buffer, re->bufferIdx);
-    server->send(re->server, CRLF, 2);
-    re->bufferIdx = 0U;
+    if (idx < m->resourcesLength)
+    {
+      sum += m->resources[idx];
+    }
+    m = m->next;
   }
-  len = Utils_Uitoh(0U, buf, 5);
-  server->send(re->server, buf, len);
-  server->send(re->server, CRLF, 2);
-  server->send(re->server, CRLF, 2);
-}
-
-static const tStringWithLength *Utils_GetMethodByIdx(
-    const void *arr,
-    unsigned int idx)
-{
-  const tStringWithLength (
-      *methods)[] = arr;
-
-  return &((*methods)[idx]);
-}
-
-static const tStringWithLength *Utils_GetResourceByIdx(
-    const void *arr,
-    unsigned int idx)
-{
-  const tResourceEntry (
-      *resources)[] = arr;
+  while (NULL != m && metrics != m);
 
-  return &(((*resources)[idx]).name);
+  return sum;
 }
 
-static void Utils_MarkError(
+static void Utils_MetricsSample(
     void *const conn,
-    tErrorInfo info)
+    const char *name,
+    const char *label,
+    unsigned int labelLength,
+    unsigned long value)
 {
-  tuCHttpServerState *const sm = conn;
+  char buf[24];
+  unsigned int len = Utils_Uitoa(value, buf, sizeof(buf));
 
-  sm->shared.content.errorInfo = info;
-  sm->state = &CallErrorCallbackState;
+  /* Labelled name ends with an open label value */
+  Http_SendNullTerminatedPortWrapper(conn, name);
+  if (NULL != label)
+  {
+    Http_SendPortWrapper(conn, label, labelLength);
+    Http_SendPortWrapper(conn, "\"}", 2U);
+  }
+  Http_SendPortWrapper(conn, SP.str, SP.length);
+  Http_SendPortWrapper(conn, buf, len);
+  Http_SendPortWrapper(conn, "\n", 1U);
 }
+#endif
 
 static unsigned char Utils_OnInitialization(
     void *const conn)
@@ -1508,6 +3686,7 @@ static unsigned int Utils_SearchNullTerminatedPattern(
   return ret;
 }
 
+#if HTTP_TRACING
 static int Utils_AtoiNullTerminated(
     const char *str)
 {
@@ -1535,6 +3714,7 @@ static int Utils_AtoiNullTerminated(
   }
   return result * multiplier;
 }
+#endif
 
 static unsigned int Utils_Uitoh(
     unsigned int num,
@@ -1589,6 +3769,38 @@ static unsigned int Utils_Uitoh(
   return idx;
 }
 
+static unsigned int Utils_Uitoa(
+    unsigned long num,
+    char *buffer,
+    unsigned int bufferLength)
+{
+  char digits[24];
+  unsigned int count = 0U;
+  unsigned int idx = 0U;
+
+  /* Least significant first, then reversed into the buffer */
+  do
+  {
+    digits[count] = (char) ('0' + (num % 10UL));
+    ++count;
+    num /= 10UL;
+  }
+  while (0UL != num && count < sizeof(digits));
+
+  while (0U < count && idx + 1U < bufferLength)
+  {
+    --count;
+    buffer[idx] = digits[count];
+    ++idx;
+  }
+  if (0U < bufferLength)
+  {
+    buffer[idx] = '\0';
+  }
+
+  return idx;
+}
+
 static void ParameterEngine_Init(
     tParameterEntity *const pe,
     char (*buffer)[],
@@ -1602,6 +3814,11 @@ static void ParameterEngine_Init(
   pe->parameters = parameters;
   pe->bufferLength = bufferLength;
   pe->parameterLength = parameterLength;
+#if HTTP_BUFFER_STATISTICS
+  pe->truncated = 0U;
+#endif
+  /* List ends at the first empty name, previous request left its own */
+  (*pe->parameters)[0][0] = NULL;
 }
 
 static tParameterEngineResult ParameterEngine_AddParameterName(
@@ -1612,10 +3829,14 @@ static tParameterEngineResult ParameterEngine_AddParameterName(
   if (pe->parameterIdx < pe->parameterLength)
   {
     (*pe->parameters)[pe->parameterIdx][0] = &((*pe->buffer)[pe->bufferIdx]);
+    (*pe->parameters)[pe->parameterIdx][1] = NULL;
     result = PARAMETER_ENGINE_OK;
   }
   else
   {
+#if HTTP_BUFFER_STATISTICS
+    pe->truncated = 1U;
+#endif
     result = PARAMETER_ENGINE_SLOTS_FULL;
   }
 
@@ -1631,6 +3852,10 @@ static tParameterEngineResult ParameterEngine_AddParameterValue(
   {
     (*pe->parameters)[pe->parameterIdx][1] = &((*pe->buffer)[pe->bufferIdx]);
     ++(pe->parameterIdx);
+    if (pe->parameterIdx < pe->parameterLength)
+    {
+      (*pe->parameters)[pe->parameterIdx][0] = NULL;
+    }
     result = PARAMETER_ENGINE_OK;
   }
   else
@@ -1657,6 +3882,9 @@ static tParameterEngineResult ParameterEngine_AddParameterCharacter(
   {
     (*pe->buffer)[pe->bufferIdx] = '\0';
     ++(pe->bufferIdx);
+#if HTTP_BUFFER_STATISTICS
+    pe->truncated = 1U;
+#endif
     result = PARAMETER_ENGINE_BUFFER_FULL;
   }
   else
@@ -1667,6 +3895,136 @@ static tParameterEngineResult ParameterEngine_AddParameterCharacter(
   return result;
 }
 
+static const char *ParameterEngine_AddString(
+    tParameterEntity *const pe)
+{
+  /* Value without a slot, its owner keeps the pointer */
+  return (pe->bufferIdx < pe->bufferLength) ?
+      &((*pe->buffer)[pe->bufferIdx]) : NULL;
+}
+
+static void ParameterEngine_Rewind(
+    tParameterEntity *const pe,
+    unsigned int bufferIdx)
+{
+  /* Drop the name added last, its slot ends the list again */
+  pe->bufferIdx = bufferIdx;
+  if (pe->parameterIdx < pe->parameterLength)
+  {
+    (*pe->parameters)[pe->parameterIdx][0] = NULL;
+  }
+}
+
+static void HeaderEngine_Init(
+    tHeaderEntity *const he)
+{
+  he->elements = 0U;
+  he->tokenLength = 0U;
+  he->value = HEADER_VALUE_EMPTY;
+  he->inParameters = 0U;
+  he->rejected = 0U;
+  he->repeated = 0U;
+}
+
+static unsigned char HeaderEngine_AddCharacter(
+    tHeaderEntity *const he,
+    char ch)
+{
+  unsigned char element = 0U;
+
+  if (',' == ch)
+  {
+    HeaderEngine_EndToken(he);
+    element = 1U;
+  }
+  else if (';' == ch)
+  {
+    HeaderEngine_EndToken(he);
+    he->inParameters = 1U;
+  }
+  else if (he->tokenLength < HTTP_HEADER_TOKEN_LENGTH)
+  {
+    he->token[he->tokenLength] = ch;
+    ++(he->tokenLength);
+  }
+  else
+  {
+    /* Too long for any known token */
+    he->tokenLength = HTTP_HEADER_TOKEN_LENGTH + 1U;
+  }
+
+  return element;
+}
+
+static void HeaderEngine_Finish(
+    tHeaderEntity *const he)
+{
+  HeaderEngine_EndToken(he);
+}
+
+static void HeaderEngine_NextElement(
+    tHeaderEntity *const he)
+{
+  ++(he->elements);
+  he->tokenLength = 0U;
+  he->value = HEADER_VALUE_EMPTY;
+  he->inParameters = 0U;
+  he->rejected = 0U;
+}
+
+static void HeaderEngine_EndToken(
+    tHeaderEntity *const he)
+{
+  unsigned int i;
+
+  if (HTTP_HEADER_TOKEN_LENGTH < he->tokenLength)
+  {
+    if (0U == he->inParameters)
+    {
+      he->value = HEADER_VALUE_UNKNOWN;
+    }
+  }
+  else if (0U == he->inParameters)
+  {
+    he->token[he->tokenLength] = '\0';
+    if (0U < he->tokenLength)
+    {
+      he->value = HEADER_VALUE_UNKNOWN;
+      for (i = 0U; i < sizeof(headerTokens) / sizeof(headerTokens[0]); i++)
+      {
+        if (he->header == headerTokens[i].header &&
+            0U == Utils_SearchNullTerminatedPattern(headerTokens[i].token,
+                he->token))
+        {
+          he->value = headerTokens[i].value;
+          break;
+        }
+      }
+    }
+  }
+  else
+  {
+    const char *q = he->token;
+
+    /* Quality 0, 0. or 0.000 - not acceptable */
+    he->token[he->tokenLength] = '\0';
+    if ('q' == Utils_ToLowerCase(q[0]) && '=' == q[1] && '0' == q[2])
+    {
+      q += 3;
+      if ('.' == *q)
+      {
+        ++q;
+        while ('0' == *q)
+        {
+          ++q;
+        }
+      }
+      he->rejected = ('\0' == *q) ? 1U : he->rejected;
+    }
+  }
+  he->tokenLength = 0U;
+}
+
 static void Utils_PrintParameter(
     void *const conn,
     const char *format,
@@ -0,0 +1,251 @@
+/*
+ uchttptimer.c
+
+ MIT License
+
+ Copyright (c) 2026 uChttpserver contributors
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+  Created on: Oct 18, 2026
+      Author: uChttpserver contributors
+ */
+
+/*****************************************************************************/
+/* Includes                                                                  */
+/*****************************************************************************/
+
+#include "uchttptimer.h"
+
+#include <limits.h>
+#include <stddef.h>
+
+/*****************************************************************************/
+/* Defines                                                                   */
+/*****************************************************************************/
+
+#define LEVEL_MASK ((unsigned long) HTTP_TIMER_SLOTS - 1UL)
+#define LEVEL_SHIFT(level) ((level) * HTTP_TIMER_LEVEL_BITS)
+#define WHEEL_RANGE (1UL << LEVEL_SHIFT(HTTP_TIMER_LEVELS))
+
+/*****************************************************************************/
+/* Local functions (declarations)                                            */
+/*****************************************************************************/
+
+static void TimerWheel_Insert(
+    tHttpTimerWheel *const wheel,
+    tHttpTimer *const timer);
+static void TimerWheel_Cascade(
+    tHttpTimerWheel *const wheel,
+    unsigned int level);
+static void TimerList_Init(
+    tHttpTimerLink *const head);
+static void TimerList_Append(
+    tHttpTimerLink *const head,
+    tHttpTimerLink *const link);
+static void TimerList_Unlink(
+    tHttpTimerLink *const link);
+static void TimerList_Move(
+    tHttpTimerLink *const from,
+    tHttpTimerLink *const to);
+
+/*****************************************************************************/
+/* Global functions                                                          */
+/*****************************************************************************/
+
+void HttpTimer_InitializeWheel(
+    tHttpTimerWheel *const wheel,
+    unsigned long now)
+{
+  unsigned int level;
+  unsigned int slot;
+
+  wheel->now = now;
+  for (level = 0U; level < HTTP_TIMER_LEVELS; level++)
+  {
+    for (slot = 0U; slot < HTTP_TIMER_SLOTS; slot++)
+    {
+      TimerList_Init(&(wheel->slots[level][slot]));
+    }
+  }
+}
+
+void HttpTimer_Initialize(
+    tHttpTimer *const timer,
+    tHttpTimerCallback callback,
+    void *context)
+{
+  timer->link.next = NULL;
+  timer->link.prev = NULL;
+  timer->expires = 0UL;
+  timer->callback = callback;
+  timer->context = context;
+}
+
+void HttpTimer_Schedule(
+    tHttpTimerWheel *const wheel,
+    tHttpTimer *const timer,
+    unsigned long ticks)
+{
+  HttpTimer_Cancel(timer);
+  if (ticks >= WHEEL_RANGE)
+  {
+    ticks = WHEEL_RANGE - 1UL;
+  }
+  timer->expires = wheel->now + ticks;
+  TimerWheel_Insert(wheel, timer);
+}
+
+void HttpTimer_Cancel(
+    tHttpTimer *const timer)
+{
+  if (NULL != timer->link.next)
+  {
+    TimerList_Unlink(&(timer->link));
+  }
+}
+
+unsigned char HttpTimer_IsPending(
+    const tHttpTimer *timer)
+{
+  return (NULL != timer->link.next) ? 1U : 0U;
+}
+
+void HttpTimer_Advance(
+    tHttpTimerWheel *const wheel,
+    unsigned long now)
+{
+  /* Wrap-safe "now is not before wheel->now" */
+  while (0UL == ((now - wheel->now) & ~(ULONG_MAX >> 1)))
+  {
+    unsigned int slot = (unsigned int) (wheel->now & LEVEL_MASK);
+    tHttpTimerLink expired;
+
+    if (0U == slot)
+    {
+      /* Level 0 wrapped - bring next span of far timers closer */
+      TimerWheel_Cascade(wheel, 1U);
+    }
+
+    TimerList_Init(&expired);
+    TimerList_Move(&(wheel->slots[0][slot]), &expired);
+    ++(wheel->now);
+
+    /* Callback may cancel any other expired timer, take one at a time */
+    while (&expired != expired.next)
+    {
+      tHttpTimer *const timer = (tHttpTimer *) expired.next;
+
+      TimerList_Unlink(&(timer->link));
+      timer->callback(timer);
+    }
+  }
+}
+
+/*****************************************************************************/
+/* Local functions (definitions)                                             */
+/*****************************************************************************/
+
+static void TimerWheel_Insert(
+    tHttpTimerWheel *const wheel,
+    tHttpTimer *const timer)
+{
+  unsigned long delta = timer->expires - wheel->now;
+  unsigned int level = 0U;
+
+  /* Lowest level whose span still covers the delay */
+  while (level < (HTTP_TIMER_LEVELS - 1U) &&
+      delta >= (1UL << LEVEL_SHIFT(level + 1U)))
+  {
+    ++level;
+  }
+
+  TimerList_Append(&(wheel->slots[level][(timer->expires >>
+              LEVEL_SHIFT(level)) & LEVEL_MASK]), &(timer->link));
+}
+
+static void TimerWheel_Cascade(
+    tHttpTimerWheel *const wheel,
+    unsigned int level)
+{
+  unsigned int slot;
+  tHttpTimerLink pending;
+
+  if (HTTP_TIMER_LEVELS <= level)
+  {
+    return;
+  }
+
+  slot = (unsigned int) ((wheel->now >> LEVEL_SHIFT(level)) & LEVEL_MASK);
+  if (0U == slot)
+  {
+    /* Upper levels refill this one first */
+    TimerWheel_Cascade(wheel, level + 1U);
+  }
+
+  TimerList_Init(&pending);
+  TimerList_Move(&(wheel->slots[level][slot]), &pending);
+  while (&pending != pending.next)
+  {
+    tHttpTimer *const timer = (tHttpTimer *) pending.next;
+
+    TimerList_Unlink(&(timer->link));
+    TimerWheel_Insert(wheel, timer);
+  }
+}
+
+static void TimerList_Init(
+    tHttpTimerLink *const head)
+{
+  head->next = head;
+  head->prev = head;
+}
+
+static void TimerList_Append(
+    tHttpTimerLink *const head,
+    tHttpTimerLink *const link)
+{
+  link->next = head;
+  link->prev = head->prev;
+  head->prev->next = link;
+  head->prev = link;
+}
+
+static void TimerList_Unlink(
+    tHttpTimerLink *const link)
+{
+  link->prev->next = link->next;
+  link->next->prev = link->prev;
+  link->next = NULL;
+  link->prev = NULL;
+}
+
+static void TimerList_Move(
+    tHttpTimerLink *const from,
+    tHttpTimerLink *const to)
+{
+  if (from->next != from)
+  {
+    to->next = from->next;
+    to->prev = from->prev;
+    to->next->prev = to;
+    to->prev->next = to;
+    TimerList_Init(from);
+  }
+}
@@ -47,3 +47,35 @@ void Http_ErrorPort(
   fprintf(stdout, "Error %u occured\n", errorInfo->status);
   fflush(stdout);
 }
+
+#if HTTP_ZERO_COPY_RESPONSE
+/* Transmit region of the transport, e.g. payload of a network buffer */
+static char transmitRegion[HTTP_BUFFER_LENGTH];
+
+char *Http_AcquirePort(
+    void *const conn,
+    unsigned int *length)
+{
+  *length = sizeof(transmitRegion);
+  return transmitRegion;
+}
+
+void Http_CommitPort(
+    void *const conn,
+    const char *data,
+    unsigned int length)
+{
+  fwrite(data, 1, length, stdout);
+  fflush(stdout);
+}
+#endif
+
+#if 1 < HTTP_RESPONSE_BUFFERS
+/* With response ring Http_SendPort only starts the transfer (e.g. DMA),
+ * transfer complete interrupt hands the slot back to the engine         */
+void Http_TransferCompletePort(
+    tuCHttpServerState *const sm)
+{
+  Http_OutputComplete(sm);
+}
+#endif
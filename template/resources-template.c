@@ -29,6 +29,9 @@
 
 #include "resources-template.h"
 
+#include <stdio.h>
+#include <string.h>
+
 /*****************************************************************************/
 /* Resource callbacks                                                        */
 /* - of course it could be global, it's up to your needs                     */
@@ -78,75 +81,80 @@ const tResourceEntry resources[] = {
 /*   of microcontroller environment usually suffers lack of memory           */
 /*****************************************************************************/
 static tHttpStatusCode FaviconCallback(
-    void *const a)
+    void *const conn)
 {
   return HTTP_STATUS_OK;
 }
 
 static tHttpStatusCode IndexCallback(
-    void *const a)
+    void *const conn)
 {
-  const char *helloWorld = "Hello world";
-  const void *const *parameters = { (const void *) &helloWorld };
-
-  /* FIXME connection struct */
-  Http_HelperSendStatusLine(&connection, HTTP_STATUS_OK);
-  Http_HelperSendHeaderLine(&connection, "Content-Type", "text/html");
-  Http_HelperSendHeaderLine(&connection, "Connection", "close");
-  Http_HelperSendCRLF(&connection);
-  Http_HelperSendMessageBodyParametered(&connection,
+  static const char page[] =
       "<html>" "<head>" "<meta http-equiv=\"Refresh\" content=\"1\" />"
       "</head>" "<body>" "<h1>Welcome to uCHttpServer!</h1>"
-      "%s from uCHttpServer!" "</body>" "</html>", parameters);
-  Http_HelperFlush(&connection);
+      "%s from uCHttpServer!" "</body>" "</html>";
+  const char *helloWorld = "Hello world";
+  const void *const parameters[] = { helloWorld };
+  char length[12];
+
+  /* Length known in advance frames the body, %s gives way to the text */
+  sprintf(length, "%u",
+      (unsigned int) (sizeof(page) - 1U - 2U + strlen(helloWorld)));
+
+  Http_HelperSetResponseStatus(conn, HTTP_STATUS_OK);
+  Http_HelperSetResponseHeader(conn, "Content-Type", "text/html");
+  Http_HelperSetResponseHeader(conn, "Content-Length", length);
+  Http_HelperSendHeader(conn);
+  Http_HelperSendMessageBodyParametered(conn, page, parameters);
+  Http_HelperFlush(conn);
 
   return HTTP_STATUS_OK;
 }
 
 static tHttpStatusCode AaaCallback(
-    void *const a)
+    void *const conn)
 {
   return HTTP_STATUS_OK;
 }
 
 static tHttpStatusCode AbaCallback(
-    void *const a)
+    void *const conn)
 {
   return HTTP_STATUS_OK;
 }
 
 static tHttpStatusCode AbbCallback(
-    void *const a)
+    void *const conn)
 {
   return HTTP_STATUS_OK;
 }
 
 static tHttpStatusCode AbcCallback(
-    void *const a)
+    void *const conn)
 {
   return HTTP_STATUS_OK;
 }
 
 static tHttpStatusCode BbbCallback(
-    void *const a)
+    void *const conn)
 {
   return HTTP_STATUS_OK;
 }
 
 static tHttpStatusCode CbbCallback(
-    void *const a)
+    void *const conn)
 {
   return HTTP_STATUS_OK;
 }
 
 static tHttpStatusCode CccCallback(
-    void *const a)
+    void *const conn)
 {
   return HTTP_STATUS_OK;
 }
 
 static tHttpStatusCode CeeeCallback(
-    void *const a)
+    void *const conn)
 {
   return HTTP_STATUS_OK;
 }
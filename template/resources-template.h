@@ -32,8 +32,6 @@
 
 #include "uchttpserver.h"
 
-extern tuCHttpServerState connection;
-
 extern const tResourceEntry resources[];
 
 #endif /* RESOURCES_TEMPLATE_H_ */
@@ -38,6 +38,109 @@
 #define HTTP_BUFFER_LENGTH (256)
 #endif
 
+#ifndef HTTP_ZERO_COPY_RESPONSE
+#define HTTP_ZERO_COPY_RESPONSE (0)
+#endif
+
+#ifndef HTTP_RESPONSE_BUFFERS
+#define HTTP_RESPONSE_BUFFERS (1)
+#endif
+
+#ifndef HTTP_WAIT_FOR_BUFFER
+#define HTTP_WAIT_FOR_BUFFER(conn)
+#endif
+
+#ifndef HTTP_DEFERRED_RESOURCES
+#define HTTP_DEFERRED_RESOURCES (0)
+#endif
+
+/* Profile and statistics counters are also updated by resources deferred
+ * to other threads - such ports map these to relaxed atomics. ADD yields
+ * the new value, CAS reloads expected when counter differs */
+#ifndef HTTP_ATOMIC_ADD
+#define HTTP_ATOMIC_ADD(counter, value) ((counter) += (value))
+#endif
+
+#ifndef HTTP_ATOMIC_CAS
+#define HTTP_ATOMIC_CAS(counter, expected, desired) \
+  (((counter) == (expected)) ? ((counter) = (desired), 1) : \
+      ((expected) = (counter), 0))
+#endif
+
+/* Trace ring publishes a slot by its sequence word - STORE releases what
+ * was written before it, LOAD acquires what is read after it */
+#ifndef HTTP_ATOMIC_STORE
+#define HTTP_ATOMIC_STORE(target, value) ((target) = (value))
+#endif
+
+#ifndef HTTP_ATOMIC_LOAD
+#define HTTP_ATOMIC_LOAD(source) (source)
+#endif
+
+/* Resource callbacks may yield and be continued by the port in slices */
+#ifndef HTTP_RESOURCE_CONTINUATION
+#define HTTP_RESOURCE_CONTINUATION (0)
+#endif
+
+/* Admission callback decides on each request right after its request line */
+#ifndef HTTP_ADMISSION_CONTROL
+#define HTTP_ADMISSION_CONTROL (0)
+#endif
+
+/* Seconds advertised to rejected clients */
+#ifndef HTTP_RETRY_AFTER
+#define HTTP_RETRY_AFTER "1"
+#endif
+
+/* Requests served on one connection before the response says close,
+ * 0 - unlimited */
+#ifndef HTTP_KEEP_ALIVE_MAX_REQUESTS
+#define HTTP_KEEP_ALIVE_MAX_REQUESTS (0)
+#endif
+
+/* Time and calls accounted per parser state and per resource callback */
+#ifndef HTTP_PROFILING
+#define HTTP_PROFILING (0)
+#endif
+
+/* Free running counter read by profiling, as unsigned long - e.g. DWT
+ * CYCCNT on Cortex-M, rdtsc on x86, clock_gettime elsewhere */
+#ifndef HTTP_CLOCK
+#define HTTP_CLOCK() (0UL)
+#endif
+
+/* Request lifecycle events recorded in a ring, time stamps from HTTP_CLOCK */
+#ifndef HTTP_TRACING
+#define HTTP_TRACING (0)
+#endif
+
+/* Request, status, byte and connection counters, see Http_MetricsResource */
+#ifndef HTTP_METRICS
+#define HTTP_METRICS (0)
+#endif
+
+/* Log-linear latency histograms per resource, in HTTP_CLOCK units */
+#ifndef HTTP_LATENCY_HISTOGRAMS
+#define HTTP_LATENCY_HISTOGRAMS (0)
+#endif
+
+/* Buckets per power of two as bits, relative error is 2^-bits */
+#ifndef HTTP_LATENCY_SUB_BITS
+#define HTTP_LATENCY_SUB_BITS (4U)
+#endif
+
+/* Powers of two above the linear range, longer times share last bucket;
+ * with HTTP_LATENCY_SUB_BITS below the width of unsigned long */
+#ifndef HTTP_LATENCY_MAGNITUDES
+#define HTTP_LATENCY_MAGNITUDES (27U)
+#endif
+
+/* Peak use of parameter, search and response buffers, see
+ * Http_HelperGetBufferStatistics */
+#ifndef HTTP_BUFFER_STATISTICS
+#define HTTP_BUFFER_STATISTICS (0)
+#endif
+
 #ifndef HTTP_PARAMETERS_BUFFER_LENGTH
 #define HTTP_PARAMETERS_BUFFER_LENGTH (640)
 #endif
@@ -50,4 +153,14 @@
 #define HTTP_ERROR_ON_TOO_MANY_PARAMETERS (0)
 #endif
 
+/* Timer wheel - slots per level (log2) and levels, range is 2^(bits*levels)
+ * ticks and must fit in unsigned long */
+#ifndef HTTP_TIMER_LEVEL_BITS
+#define HTTP_TIMER_LEVEL_BITS (6)
+#endif
+
+#ifndef HTTP_TIMER_LEVELS
+#define HTTP_TIMER_LEVELS (4)
+#endif
+
 #endif /* UCHTTPOPTION_H_ */
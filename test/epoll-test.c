@@ -0,0 +1,386 @@
+/*
+ epoll-test.c
+
+ MIT License
+
+ Copyright (c) 2026 uChttpserver contributors
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+  Created on: Oct 18, 2026
+      Author: uChttpserver contributors
+ */
+
+/*****************************************************************************/
+/* Includes                                                                  */
+/*****************************************************************************/
+
+#include "epoll-port.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+/*****************************************************************************/
+/* Defines                                                                   */
+/*****************************************************************************/
+
+/* Low priority list outlives three polls, each serves LOW_TURNS of it */
+#define TEST_CLIENTS (4U * HTTP_EPOLL_LOW_TURNS)
+
+/* Polls of 10 ms given to the loop before a response counts as lost */
+#define TEST_POLLS (200U)
+
+/*****************************************************************************/
+/* Type definitions                                                          */
+/*****************************************************************************/
+
+typedef struct TestClient
+{
+  int fd;
+  unsigned int received;         /* Bytes of responses */
+  unsigned int expected;         /* Responses due */
+} tTestClient;
+
+/*****************************************************************************/
+/* Local functions (declarations)                                            */
+/*****************************************************************************/
+
+static tHttpStatusCode Test_Bulk(
+    void *const conn);
+
+static int Test_Connect(
+    unsigned short port);
+static int Test_Request(
+    tTestClient *const client,
+    const char *data);
+static int Test_Serve(
+    tHttpEpollServer *const server,
+    tTestClient *clients,
+    unsigned int length);
+static tTestClient *Test_Owner(
+    const tHttpEpollConnection *const c,
+    tTestClient *clients,
+    unsigned int length);
+static int Test_Churn(
+    unsigned short port,
+    tHttpEpollServer *const server,
+    tTestClient *clients);
+static int Test_Idle(
+    unsigned short port,
+    tHttpEpollServer *const server);
+
+/*****************************************************************************/
+/* Local variables and constants                                             */
+/*****************************************************************************/
+
+static const tResourceEntry resources[] = {
+  { STRING_WITH_LENGTH("/bulk"), &Test_Bulk, 0U, HTTP_PRIORITY_BULK },
+};
+
+/* Resource, and so the ready list, is known once the request line is */
+static const char requestLine[] = "GET /bulk HTTP/1.1\r\n";
+static const char requestEnd[] = "\r\n";
+
+static const char response[] = "HTTP/1.1 200 OK\r\n"
+    "Content-Type: text/plain\r\nContent-Length: 2\r\n"
+    "Connection: keep-alive\r\n\r\nok";
+
+/* Connection state is too large for the stack */
+static tHttpEpollConnection pool[TEST_CLIENTS];
+
+/*****************************************************************************/
+/* Entry point                                                               */
+/*****************************************************************************/
+
+int main(
+    void)
+{
+  tHttpEpollServer server;
+  tTestClient clients[TEST_CLIENTS];
+  struct sockaddr_in address;
+  socklen_t addressLength = sizeof(address);
+  int listenFd = HttpLinux_Listen(0U, 0);
+  int result;
+  unsigned int i;
+
+  if (0 > listenFd ||
+      0 > getsockname(listenFd, (struct sockaddr *) &address,
+          &addressLength) ||
+      0 > HttpEpoll_Initialize(&server, listenFd, pool, TEST_CLIENTS,
+          &resources, sizeof(resources) / sizeof(resources[0])))
+  {
+    perror("epoll-test");
+    return EXIT_FAILURE;
+  }
+
+  result = Test_Churn(ntohs(address.sin_port), &server, clients);
+  printf("%s low priority ready list survives pool churn (%u connections)\n",
+      (0 == result) ? "PASS" : "FAIL", TEST_CLIENTS);
+  if (0 == result)
+  {
+    result = Test_Idle(ntohs(address.sin_port), &server);
+    printf("%s idle connection makes room in a full pool\n",
+        (0 == result) ? "PASS" : "FAIL");
+  }
+
+  for (i = 0U; i < TEST_CLIENTS; i++)
+  {
+    if (0 <= clients[i].fd)
+    {
+      close(clients[i].fd);
+    }
+  }
+  HttpEpoll_Close(&server);
+  return (0 == result) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*****************************************************************************/
+/* Local functions (definitions)                                             */
+/*****************************************************************************/
+
+static tHttpStatusCode Test_Bulk(
+    void *const conn)
+{
+  Http_HelperSetResponseStatus(conn, HTTP_STATUS_OK);
+  Http_HelperSendContent(conn, "text/plain", "ok", 2U);
+
+  return HTTP_STATUS_OK;
+}
+
+static int Test_Connect(
+    unsigned short port)
+{
+  struct sockaddr_in address;
+  int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+  memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  address.sin_port = htons(port);
+
+  /* Handshake is done by the kernel, accept is left to the loop */
+  if (0 > fd ||
+      0 > connect(fd, (struct sockaddr *) &address, sizeof(address)) ||
+      0 > fcntl(fd, F_SETFL, O_NONBLOCK))
+  {
+    if (0 <= fd)
+    {
+      close(fd);
+    }
+    return -1;
+  }
+
+  return fd;
+}
+
+static int Test_Request(
+    tTestClient *const client,
+    const char *data)
+{
+  const size_t length = strlen(data);
+
+  if ((ssize_t) length != send(client->fd, data, length, MSG_NOSIGNAL))
+  {
+    return -1;
+  }
+  if (requestEnd == data)
+  {
+    ++(client->expected);
+  }
+
+  return 0;
+}
+
+static int Test_Serve(
+    tHttpEpollServer *const server,
+    tTestClient *clients,
+    unsigned int length)
+{
+  unsigned int polls;
+
+  for (polls = 0U; polls < TEST_POLLS; polls++)
+  {
+    unsigned int waiting = 0U;
+    unsigned int i;
+
+    HttpEpoll_Poll(server, 10);
+    for (i = 0U; i < length; i++)
+    {
+      char data[256];
+      ssize_t received;
+
+      if (0 > clients[i].fd)
+      {
+        continue;
+      }
+      while (0 < (received = recv(clients[i].fd, data, sizeof(data), 0)))
+      {
+        clients[i].received += (unsigned int) received;
+      }
+      if (clients[i].received < clients[i].expected * (sizeof(response) -
+          1U))
+      {
+        ++waiting;
+      }
+    }
+    if (0U == waiting)
+    {
+      return 0;
+    }
+  }
+
+  return -1;
+}
+
+static tTestClient *Test_Owner(
+    const tHttpEpollConnection *const c,
+    tTestClient *clients,
+    unsigned int length)
+{
+  struct sockaddr_in peer;
+  socklen_t peerLength = sizeof(peer);
+  unsigned int i;
+
+  if (0 > getpeername(c->fd, (struct sockaddr *) &peer, &peerLength))
+  {
+    return NULL;
+  }
+  for (i = 0U; i < length; i++)
+  {
+    struct sockaddr_in local;
+    socklen_t localLength = sizeof(local);
+
+    if (0 <= clients[i].fd &&
+        0 == getsockname(clients[i].fd, (struct sockaddr *) &local,
+            &localLength) &&
+        local.sin_port == peer.sin_port)
+    {
+      return &(clients[i]);
+    }
+  }
+
+  return NULL;
+}
+
+static int Test_Churn(
+    unsigned short port,
+    tHttpEpollServer *const server,
+    tTestClient *clients)
+{
+  const tHttpEpollConnection *queued;
+  tTestClient *victim;
+  struct linger reset = { 1, 0 };
+  unsigned int i;
+
+  /* Pool is full and every connection is inside a bulk request, so the
+   * rest of it is queued on the lowest ready list */
+  for (i = 0U; i < TEST_CLIENTS; i++)
+  {
+    clients[i].fd = Test_Connect(port);
+    clients[i].received = 0U;
+    clients[i].expected = 0U;
+    if (0 > clients[i].fd || 0 > Test_Request(&(clients[i]), requestLine))
+    {
+      return -1;
+    }
+  }
+  for (i = 0U; i < TEST_POLLS && (TEST_CLIENTS != server->active ||
+      HTTP_PRIORITY_BULK != pool[TEST_CLIENTS - 1U].priority); i++)
+  {
+    HttpEpoll_Poll(server, 10);
+  }
+
+  for (i = 0U; i < TEST_CLIENTS; i++)
+  {
+    if (0 > Test_Request(&(clients[i]), requestEnd))
+    {
+      return -1;
+    }
+  }
+  HttpEpoll_Poll(server, 100);
+
+  /* Low turns ran out with most of the list left, pick an entry the next
+   * two polls do not reach and that still has others queued behind it */
+  queued = server->readyHead[HTTP_PRIORITY_BULK];
+  for (i = 0U; NULL != queued && i < 2U * HTTP_EPOLL_LOW_TURNS; i++)
+  {
+    queued = queued->readyNext;
+  }
+  if (NULL == queued || NULL == queued->readyNext)
+  {
+    return -1;
+  }
+  victim = Test_Owner(queued, clients, TEST_CLIENTS);
+  if (NULL == victim)
+  {
+    return -1;
+  }
+
+  /* Reset arrives as EPOLLHUP, slot is released while still queued */
+  setsockopt(victim->fd, SOL_SOCKET, SO_LINGER, &reset, sizeof(reset));
+  close(victim->fd);
+  HttpEpoll_Poll(server, 100);
+
+  /* New client takes the released slot, its first input must not cut
+   * the connections queued behind the stale entry off the list */
+  victim->fd = Test_Connect(port);
+  victim->received = 0U;
+  victim->expected = 0U;
+  if (0 > victim->fd || 0 > Test_Request(victim, requestLine) ||
+      0 > Test_Request(victim, requestEnd))
+  {
+    return -1;
+  }
+
+  return Test_Serve(server, clients, TEST_CLIENTS);
+}
+
+static int Test_Idle(
+    unsigned short port,
+    tHttpEpollServer *const server)
+{
+  tTestClient client;
+  int result;
+
+  /* Every connection of the pool waits for its next request */
+  if (TEST_CLIENTS != server->active)
+  {
+    return -1;
+  }
+
+  client.fd = Test_Connect(port);
+  client.received = 0U;
+  client.expected = 0U;
+  if (0 > client.fd || 0 > Test_Request(&client, requestLine) ||
+      0 > Test_Request(&client, requestEnd))
+  {
+    return -1;
+  }
+  result = Test_Serve(server, &client, 1U);
+  close(client.fd);
+
+  return result;
+}
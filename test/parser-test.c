@@ -0,0 +1,793 @@
+/*
+ parser-test.c
+
+ MIT License
+
+ Copyright (c) 2026 uChttpserver contributors
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+  Created on: Oct 18, 2026
+      Author: uChttpserver contributors
+ */
+
+/*****************************************************************************/
+/* Includes                                                                  */
+/*****************************************************************************/
+
+#include "uchttpserver.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*****************************************************************************/
+/* Defines                                                                   */
+/*****************************************************************************/
+
+#define TEST_OUTPUT_LENGTH (4096U)
+
+/* Responses of the test resources, chunk size given in hex */
+#define TEST_OK_HEADER "HTTP/1.1 200 OK\r\n" \
+  "Connection: keep-alive\r\nTransfer-Encoding: chunked\r\n\r\n"
+#define TEST_OK(size, body) TEST_OK_HEADER size "\r\n" body "\r\n0\r\n\r\n"
+#define TEST_CLOSED(size, body) "HTTP/1.1 200 OK\r\n" \
+  "Connection: close\r\nTransfer-Encoding: chunked\r\n\r\n" \
+  size "\r\n" body "\r\n0\r\n\r\n"
+#define TEST_CONTINUE "HTTP/1.1 100 Continue\r\n\r\n"
+#define TEST_ERROR_HEADER(status) "HTTP/1.1 " status "\r\n" \
+  "Content-Length: 5\r\n\r\n"
+#define TEST_ERROR(status) TEST_ERROR_HEADER(status) "error"
+
+/* Body of /large, longer than any buffer the response is rendered into */
+#define TEST_TEN "0123456789"
+#define TEST_HUNDRED TEST_TEN TEST_TEN TEST_TEN TEST_TEN TEST_TEN TEST_TEN \
+  TEST_TEN TEST_TEN TEST_TEN TEST_TEN
+#define TEST_LARGE TEST_HUNDRED TEST_HUNDRED TEST_HUNDRED TEST_HUNDRED \
+  TEST_HUNDRED TEST_HUNDRED
+
+/* Pipelined after the request that reaches the keep-alive cap, never
+ * answered */
+#define TEST_LATE "GET /echo?c=3 HTTP/1.1\r\n\r\n"
+
+/*****************************************************************************/
+/* Type definitions                                                          */
+/*****************************************************************************/
+
+typedef struct TestConnection
+{
+  char output[TEST_OUTPUT_LENGTH];
+  unsigned int length;
+#if HTTP_ZERO_COPY_RESPONSE
+  char region[HTTP_BUFFER_LENGTH];      /* Transmit buffer of the port */
+  unsigned int regions;         /* See transmits */
+  unsigned int acquired;
+  unsigned char misplaced;      /* Commit outside the region */
+#endif
+#if 1 < HTTP_RESPONSE_BUFFERS
+  const char *transfer[HTTP_RESPONSE_BUFFERS];  /* Slots being sent */
+  unsigned int transferLength[HTTP_RESPONSE_BUFFERS];
+  unsigned int transfers;
+#endif
+} tTestConnection;
+
+typedef struct TestCase
+{
+  const char *name;
+  const char *input;            /* Whole connection, may be pipelined */
+  const char *expected;         /* Everything sent back */
+  unsigned char framed;         /* By length only, chunks would follow the
+                                   size of the buffer rendered into */
+} tTestCase;
+
+#if HTTP_KEEP_ALIVE_MAX_REQUESTS
+typedef struct TestCapCase
+{
+  const char *name;
+  const char *request;          /* Repeated up to the cap, then TEST_LATE */
+  const char *kept;             /* Answer to the requests before the last */
+  const char *closed;           /* Answer to the last one */
+  unsigned char framed;
+} tTestCapCase;
+#endif
+
+/*****************************************************************************/
+/* Local functions (declarations)                                            */
+/*****************************************************************************/
+
+static unsigned int Test_Send(
+    void *const conn,
+    const char *data,
+    unsigned int length);
+static void Test_Output(
+    tTestConnection *const tc,
+    const char *data,
+    unsigned int length);
+#if 1 < HTTP_RESPONSE_BUFFERS
+static void Test_Complete(
+    void *const conn);
+#endif
+static void Test_Error(
+    void *const conn,
+    const tErrorInfo *errorInfo);
+static tHttpStatusCode Test_Echo(
+    void *const conn);
+static tHttpStatusCode Test_Headers(
+    void *const conn);
+static tHttpStatusCode Test_Length(
+    void *const conn);
+static tHttpStatusCode Test_Content(
+    void *const conn);
+static tHttpStatusCode Test_Large(
+    void *const conn);
+static tHttpStatusCode Test_Accept(
+    void *const conn);
+static tHttpStatusCode Test_Refuse(
+    void *const conn);
+#if HTTP_ZERO_COPY_RESPONSE
+static char *Test_Acquire(
+    void *const conn,
+    unsigned int *length);
+static void Test_Commit(
+    void *const conn,
+    const char *data,
+    unsigned int length);
+#endif
+
+static void Test_Print(
+    const char *label,
+    const char *data,
+    unsigned int length);
+static int Test_Run(
+    const tTestCase *test,
+    unsigned int fragment,
+    unsigned int transmit);
+static unsigned int Test_Variants(
+    const tTestCase *test,
+    unsigned int *runs);
+#if HTTP_KEEP_ALIVE_MAX_REQUESTS
+static int Test_Cap(
+    const tTestCapCase *cap,
+    tTestCase *test);
+#endif
+
+/*****************************************************************************/
+/* Local variables and constants                                             */
+/*****************************************************************************/
+
+/* Sorted by name, as the resource search expects */
+static const tResourceEntry resources[] = {
+  { STRING_WITH_LENGTH("/content"), &Test_Content },
+  { STRING_WITH_LENGTH("/echo"), &Test_Echo },
+  { STRING_WITH_LENGTH("/guarded"), &Test_Echo, 0U, HTTP_PRIORITY_DEFAULT,
+      &Test_Refuse },
+  { STRING_WITH_LENGTH("/headers"), &Test_Headers },
+  { STRING_WITH_LENGTH("/large"), &Test_Large },
+  { STRING_WITH_LENGTH("/length"), &Test_Length },
+  { STRING_WITH_LENGTH("/other"), &Test_Echo, 0U, HTTP_PRIORITY_DEFAULT,
+      &Test_Accept },
+};
+
+/* Input delivered per Http_Input call, 0 - whole case at once */
+static const unsigned int fragments[] = { 0U, 1U, 7U };
+
+/* Acquire gives a region every n-th call: 1 - always, 0 - no transmit
+ * buffer attached, 2 - every other call NULL */
+#if HTTP_ZERO_COPY_RESPONSE
+static const unsigned int transmits[] = { 1U, 0U, 2U };
+#else
+static const unsigned int transmits[] = { 0U };
+#endif
+
+#if HTTP_KEEP_ALIVE_MAX_REQUESTS
+/* Expectations of the other cases keep every connection alive, these are
+ * repeated up to whatever cap the build has */
+static const tTestCapCase capCases[] = {
+  {
+    "request reaching the cap closes the connection",
+    "GET /echo?a=1 HTTP/1.1\r\n\r\n",
+    TEST_OK("15", "a=1 b=(null) c=(null)"),
+    TEST_CLOSED("15", "a=1 b=(null) c=(null)")
+  },
+  {
+    "requests with a form body count towards the cap",
+    "POST /echo HTTP/1.1\r\n"
+    "Content-Type: application/x-www-form-urlencoded\r\n"
+    "Content-Length: 3\r\n\r\nb=2",
+    TEST_OK("15", "a=(null) b=2 c=(null)"),
+    TEST_CLOSED("15", "a=(null) b=2 c=(null)")
+  },
+  {
+    "length framed response reaching the cap",
+    "GET /length HTTP/1.1\r\n\r\n",
+    "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n"
+    "Connection: keep-alive\r\n\r\nok",
+    "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n"
+    "Connection: close\r\n\r\nok",
+    1U
+  },
+};
+
+/* Cases repeated for the cap */
+static char capInput[TEST_OUTPUT_LENGTH];
+static char capExpected[TEST_OUTPUT_LENGTH];
+#else
+static const tTestCase cases[] = {
+  {
+    "resource ordered before the first entry is not found",
+    "GET /a HTTP/1.1\r\n\r\n",
+    TEST_ERROR("404 Not Found"),
+    1U
+  },
+  {
+    "parameters of a request do not outlive it",
+    "GET /echo?a=1&b=2&c=3 HTTP/1.1\r\n\r\n"
+    "GET /echo HTTP/1.1\r\n\r\n",
+    TEST_OK("B", "a=1 b=2 c=3")
+    TEST_OK("1A", "a=(null) b=(null) c=(null)")
+  },
+  {
+    "first query parameter is found",
+    "GET /echo?a=1 HTTP/1.1\r\n\r\n",
+    TEST_OK("15", "a=1 b=(null) c=(null)")
+  },
+  {
+    "query and form names are kept apart from the connection",
+    "POST /echo?a=1 HTTP/1.1\r\n"
+    "Content-Type: application/x-www-form-urlencoded\r\n"
+    "Content-Length: 7\r\n\r\nb=2&c=3"
+    "GET /echo?c=4 HTTP/1.1\r\n\r\n",
+    TEST_OK("B", "a=1 b=2 c=3")
+    TEST_OK("15", "a=(null) b=(null) c=4")
+  },
+  {
+    "pipelined requests are answered in order",
+    "GET /echo?a=1 HTTP/1.1\r\n\r\n"
+    "GET /other?b=2 HTTP/1.1\r\n\r\n"
+    "GET /echo?c=3 HTTP/1.1\r\n\r\n",
+    TEST_OK("15", "a=1 b=(null) c=(null)")
+    TEST_OK("15", "a=(null) b=2 c=(null)")
+    TEST_OK("15", "a=(null) b=(null) c=3")
+  },
+  {
+    "body of other media is skipped on a kept-alive connection",
+    "POST /echo?a=1 HTTP/1.1\r\n"
+    "Content-Type: application/octet-stream\r\n"
+    "Content-Length: 5\r\n\r\nb=2&c"
+    "GET /echo?b=3 HTTP/1.1\r\n\r\n",
+    TEST_OK("15", "a=1 b=(null) c=(null)")
+    TEST_OK("15", "a=(null) b=3 c=(null)")
+  },
+  {
+    "error ends the connection, what follows is not parsed",
+    "POST /nope HTTP/1.1\r\nContent-Length: 4\r\n\r\nGET "
+    "GET /echo?a=1 HTTP/1.1\r\n\r\n",
+    TEST_ERROR("404 Not Found"),
+    1U
+  },
+  {
+    "repeated headers - hot ones keep the last, lookup finds the first",
+    "GET /headers HTTP/1.1\r\nHost: first\r\nX-Test: 1\r\n"
+    "Host: second\r\nX-Test: 2\r\n\r\n",
+    TEST_OK("22", "length=(none) host=second x-test=1")
+  },
+  {
+    "identical repeated Content-Length",
+    "POST /headers HTTP/1.1\r\nContent-Length: 2\r\n"
+    "Content-Length: 2\r\n\r\nokGET /echo HTTP/1.1\r\n\r\n",
+    TEST_OK("22", "length=2 host=(null) x-test=(null)")
+    TEST_OK("1A", "a=(null) b=(null) c=(null)")
+  },
+  {
+    "differing repeated Content-Length is refused",
+    "POST /headers HTTP/1.1\r\nContent-Length: 2\r\n"
+    "Content-Length: 7\r\n\r\nokGET /echo HTTP/1.1\r\n\r\n",
+    TEST_ERROR("400 Bad Request"),
+    1U
+  },
+  {
+    "whitespace around header values",
+    "GET /headers HTTP/1.1\r\nHost:example\r\nX-Test:  \t spaced \t \r\n"
+    "Content-Length:\t0 \r\n\r\n",
+    TEST_OK("23", "length=0 host=example x-test=spaced")
+  },
+  {
+    "100 Continue before a body the resource accepts",
+    "POST /other HTTP/1.1\r\n"
+    "Content-Type: application/x-www-form-urlencoded\r\n"
+    "Expect: 100-continue\r\nContent-Length: 3\r\n\r\na=1",
+    TEST_CONTINUE TEST_OK("15", "a=1 b=(null) c=(null)")
+  },
+  {
+    "expectation refused by the resource",
+    "POST /guarded HTTP/1.1\r\n"
+    "Content-Type: application/x-www-form-urlencoded\r\n"
+    "Expect: 100-continue\r\nContent-Length: 3\r\n\r\na=1",
+    TEST_ERROR("413 Payload Too Large"),
+    1U
+  },
+  {
+    "expectation refused before a body that is skipped",
+    "POST /guarded HTTP/1.1\r\n"
+    "Content-Type: application/octet-stream\r\n"
+    "Expect: 100-continue\r\nContent-Length: 5\r\n\r\nhello"
+    "GET /echo HTTP/1.1\r\n\r\n",
+    TEST_ERROR("413 Payload Too Large"),
+    1U
+  },
+  {
+    "no 100 Continue before a body that is skipped",
+    "POST /echo?a=1 HTTP/1.1\r\n"
+    "Content-Type: application/octet-stream\r\n"
+    "Expect: 100-continue\r\nContent-Length: 5\r\n\r\nhello"
+    "GET /echo HTTP/1.1\r\n\r\n",
+    "HTTP/1.1 200 OK\r\nConnection: close\r\n"
+    "Transfer-Encoding: chunked\r\n\r\n"
+    "15\r\na=1 b=(null) c=(null)\r\n0\r\n\r\n"
+  },
+  {
+    "unknown expectation",
+    "POST /echo HTTP/1.1\r\nExpect: something\r\nContent-Length: 3\r\n\r\na=1",
+    TEST_ERROR("417 Expectation Failed"),
+    1U
+  },
+  {
+    "HEAD gets the header of GET without the body",
+    "HEAD /echo?a=1 HTTP/1.1\r\n\r\nGET /echo?a=1 HTTP/1.1\r\n\r\n",
+    TEST_OK_HEADER TEST_OK("15", "a=1 b=(null) c=(null)")
+  },
+  {
+    "Content-Length set by the resource replaces chunks",
+    "GET /length HTTP/1.1\r\n\r\nHEAD /length HTTP/1.1\r\n\r\n",
+    "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n"
+    "Connection: keep-alive\r\n\r\nok"
+    "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n"
+    "Connection: keep-alive\r\n\r\n",
+    1U
+  },
+  {
+    "content rendered in advance, GET and HEAD",
+    "GET /content HTTP/1.1\r\n\r\nHEAD /content HTTP/1.1\r\n\r\n",
+    "HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nContent-Length: 2\r\n"
+    "Connection: keep-alive\r\n\r\nok"
+    "HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nContent-Length: 2\r\n"
+    "Connection: keep-alive\r\n\r\n",
+    1U
+  },
+  {
+    "HEAD of an unknown resource gets the error header only",
+    "HEAD /nope HTTP/1.1\r\n\r\n",
+    TEST_ERROR_HEADER("404 Not Found"),
+    1U
+  },
+  {
+    "unknown method after HEAD gets its error in full",
+    "HEAD /echo HTTP/1.1\r\n\r\nHEAX /echo HTTP/1.1\r\n\r\n",
+    TEST_OK_HEADER TEST_ERROR("501 Not Implemented")
+  },
+  {
+    "response longer than the buffers it is rendered into",
+    "GET /large HTTP/1.1\r\n\r\nGET /large HTTP/1.1\r\n\r\n",
+    "HTTP/1.1 200 OK\r\nContent-Length: 600\r\n"
+    "Connection: keep-alive\r\n\r\n" TEST_LARGE
+    "HTTP/1.1 200 OK\r\nContent-Length: 600\r\n"
+    "Connection: keep-alive\r\n\r\n" TEST_LARGE,
+    1U
+  },
+};
+#endif
+
+/*****************************************************************************/
+/* Entry point                                                               */
+/*****************************************************************************/
+
+int main(
+    void)
+{
+  unsigned int failed = 0U;
+  unsigned int runs = 0U;
+  unsigned int i;
+
+#if HTTP_KEEP_ALIVE_MAX_REQUESTS
+  for (i = 0U; i < sizeof(capCases) / sizeof(capCases[0]); i++)
+  {
+    tTestCase test;
+
+    if (0 != Test_Cap(&capCases[i], &test))
+    {
+      printf("FAIL %s (cap too high for the test buffers)\n",
+          capCases[i].name);
+      ++failed;
+      continue;
+    }
+    failed += Test_Variants(&test, &runs);
+  }
+#else
+  for (i = 0U; i < sizeof(cases) / sizeof(cases[0]); i++)
+  {
+    failed += Test_Variants(&cases[i], &runs);
+  }
+#endif
+
+  printf("%u of %u cases failed\n", failed, runs);
+  return (0U == failed) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*****************************************************************************/
+/* Local functions (definitions)                                             */
+/*****************************************************************************/
+
+static unsigned int Test_Send(
+    void *const conn,
+    const char *data,
+    unsigned int length)
+{
+  tTestConnection *const tc = Http_HelperGetContext(conn);
+
+#if 1 < HTTP_RESPONSE_BUFFERS
+  /* Transfer only starts, the slot is read when it completes */
+  tc->transfer[tc->transfers] = data;
+  tc->transferLength[tc->transfers] = length;
+  if (HTTP_RESPONSE_BUFFERS == ++(tc->transfers))
+  {
+    /* Every slot is in flight, the oldest one finishes */
+    Test_Complete(conn);
+  }
+#else
+  Test_Output(tc, data, length);
+#endif
+
+  return length;
+}
+
+static void Test_Output(
+    tTestConnection *const tc,
+    const char *data,
+    unsigned int length)
+{
+  if (TEST_OUTPUT_LENGTH - tc->length < length)
+  {
+    length = TEST_OUTPUT_LENGTH - tc->length;
+  }
+  memcpy(tc->output + tc->length, data, length);
+  tc->length += length;
+}
+
+#if 1 < HTTP_RESPONSE_BUFFERS
+static void Test_Complete(
+    void *const conn)
+{
+  tTestConnection *const tc = Http_HelperGetContext(conn);
+  unsigned int i;
+
+  Test_Output(tc, tc->transfer[0], tc->transferLength[0]);
+  --(tc->transfers);
+  for (i = 0U; i < tc->transfers; i++)
+  {
+    tc->transfer[i] = tc->transfer[i + 1U];
+    tc->transferLength[i] = tc->transferLength[i + 1U];
+  }
+  Http_OutputComplete(conn);
+}
+#endif
+
+static void Test_Error(
+    void *const conn,
+    const tErrorInfo *errorInfo)
+{
+  /* As the ports answer, with a body HEAD must not get */
+  Http_HelperSetResponseStatus(conn, errorInfo->status);
+  Http_HelperSetResponseHeader(conn, "Content-Length", "5");
+  Http_HelperSend(conn, "\r\nerror", 7U);
+  Http_HelperFlush(conn);
+}
+
+static tHttpStatusCode Test_Echo(
+    void *const conn)
+{
+  static const char *const names[] = { "a", "b", "c" };
+  char body[256];
+  unsigned int i;
+
+  /* Parameters the request left, by name - (null) tells a missing one */
+  body[0] = '\0';
+  for (i = 0U; i < sizeof(names) / sizeof(names[0]); i++)
+  {
+    const char *value = Http_HelperGetParameter(conn, names[i]);
+
+    sprintf(body + strlen(body), "%s%s=%s", (0U < i) ? " " : "", names[i],
+        (NULL != value) ? value : "(null)");
+  }
+
+  Http_HelperSetResponseStatus(conn, HTTP_STATUS_OK);
+  Http_HelperSendHeader(conn);
+  Http_HelperSendMessageBody(conn, body);
+  Http_HelperFlush(conn);
+
+  return HTTP_STATUS_OK;
+}
+
+static tHttpStatusCode Test_Headers(
+    void *const conn)
+{
+  const tHttpHeaders *const headers = Http_HelperGetHeaders(conn);
+  const char *other = Http_HelperGetParameter(conn, "X-Test");
+  char body[256];
+
+  /* Decoded hot headers and a plain one kept as parameter */
+  if (0U != (HTTP_HEADER_CONTENT_LENGTH & headers->present))
+  {
+    sprintf(body, "length=%lu", headers->contentLength);
+  }
+  else
+  {
+    strcpy(body, "length=(none)");
+  }
+  sprintf(body + strlen(body), " host=%s x-test=%s",
+      (NULL != headers->host) ? headers->host : "(null)",
+      (NULL != other) ? other : "(null)");
+
+  Http_HelperSetResponseStatus(conn, HTTP_STATUS_OK);
+  Http_HelperSendHeader(conn);
+  Http_HelperSendMessageBody(conn, body);
+  Http_HelperFlush(conn);
+
+  return HTTP_STATUS_OK;
+}
+
+static tHttpStatusCode Test_Length(
+    void *const conn)
+{
+  Http_HelperSetResponseStatus(conn, HTTP_STATUS_OK);
+  Http_HelperSetResponseHeader(conn, "Content-Length", "2");
+  Http_HelperSendHeader(conn);
+  Http_HelperSendMessageBody(conn, "ok");
+  Http_HelperFlush(conn);
+
+  return HTTP_STATUS_OK;
+}
+
+static tHttpStatusCode Test_Content(
+    void *const conn)
+{
+  Http_HelperSetResponseStatus(conn, HTTP_STATUS_OK);
+  Http_HelperSendContent(conn, "text/plain", "ok", 2U);
+
+  return HTTP_STATUS_OK;
+}
+
+static tHttpStatusCode Test_Large(
+    void *const conn)
+{
+  static const char body[] = TEST_LARGE;
+
+  Http_HelperSetResponseStatus(conn, HTTP_STATUS_OK);
+  Http_HelperSetResponseHeader(conn, "Content-Length", "600");
+  Http_HelperSendHeader(conn);
+  Http_HelperSend(conn, body, sizeof(body) - 1U);
+  Http_HelperFlush(conn);
+
+  return HTTP_STATUS_OK;
+}
+
+static tHttpStatusCode Test_Accept(
+    void *const conn)
+{
+  return HTTP_STATUS_CONTINUE;
+}
+
+static tHttpStatusCode Test_Refuse(
+    void *const conn)
+{
+  return HTTP_STATUS_PAYLOAD_TOO_LARGE;
+}
+
+#if HTTP_ZERO_COPY_RESPONSE
+static char *Test_Acquire(
+    void *const conn,
+    unsigned int *length)
+{
+  tTestConnection *const tc = Http_HelperGetContext(conn);
+
+  if (0U != ++(tc->acquired) % tc->regions)
+  {
+    /* Port is out of regions */
+    return NULL;
+  }
+  *length = sizeof(tc->region);
+  return tc->region;
+}
+
+static void Test_Commit(
+    void *const conn,
+    const char *data,
+    unsigned int length)
+{
+  tTestConnection *const tc = Http_HelperGetContext(conn);
+
+  if (data < tc->region || data + length > tc->region + sizeof(tc->region))
+  {
+    tc->misplaced = 1U;
+    return;
+  }
+  /* Region is transmitted at once, the next acquire may reuse it */
+  Test_Output(tc, data, length);
+}
+#endif
+
+static void Test_Print(
+    const char *label,
+    const char *data,
+    unsigned int length)
+{
+  unsigned int i;
+
+  /* Line breaks escaped, a response is one line of the report */
+  printf("  %-9s", label);
+  for (i = 0U; i < length; i++)
+  {
+    if ('\r' == data[i])
+    {
+      fputs("\\r", stdout);
+    }
+    else if ('\n' == data[i])
+    {
+      fputs("\\n", stdout);
+    }
+    else
+    {
+      putchar(data[i]);
+    }
+  }
+  putchar('\n');
+}
+
+static int Test_Run(
+    const tTestCase *test,
+    unsigned int fragment,
+    unsigned int transmit)
+{
+  tuCHttpServerState sm;
+  tTestConnection tc;
+  const char *data = test->input;
+  unsigned int left = (unsigned int) strlen(test->input);
+
+  memset(&sm, 0, sizeof(sm));
+  tc.length = 0U;
+  Http_InitializeConnection(&sm, &Test_Send, &Test_Error, &resources,
+      sizeof(resources) / sizeof(resources[0]), &tc);
+#if HTTP_ZERO_COPY_RESPONSE
+  tc.regions = transmit;
+  tc.acquired = 0U;
+  tc.misplaced = 0U;
+  if (0U < transmit)
+  {
+    Http_InitializeTransmitBuffer(&sm, &Test_Acquire, &Test_Commit);
+  }
+#else
+  (void) transmit;
+#endif
+#if 1 < HTTP_RESPONSE_BUFFERS
+  tc.transfers = 0U;
+#endif
+
+  while (0U < left)
+  {
+    unsigned int length = (0U == fragment || left < fragment) ? left :
+        fragment;
+
+    Http_Input(&sm, data, length);
+    data += length;
+    left -= length;
+#if 1 < HTTP_RESPONSE_BUFFERS
+    /* Transport catches up between input steps */
+    while (0U < tc.transfers)
+    {
+      Test_Complete(&sm);
+    }
+#endif
+  }
+
+#if HTTP_ZERO_COPY_RESPONSE
+  if (tc.misplaced)
+  {
+    printf("FAIL %s (fragment %u, transmit %u) committed outside the "
+        "region\n", test->name, fragment, transmit);
+    return -1;
+  }
+#endif
+  if (strlen(test->expected) != tc.length ||
+      0 != memcmp(test->expected, tc.output, tc.length))
+  {
+    printf("FAIL %s (fragment %u, transmit %u)\n", test->name, fragment,
+        transmit);
+    Test_Print("expected", test->expected, (unsigned int) strlen(
+        test->expected));
+    Test_Print("sent", tc.output, tc.length);
+    return -1;
+  }
+
+  return 0;
+}
+
+static unsigned int Test_Variants(
+    const tTestCase *test,
+    unsigned int *runs)
+{
+  unsigned int failed = 0U;
+  unsigned int f;
+  unsigned int t;
+
+  for (f = 0U; f < sizeof(fragments) / sizeof(fragments[0]); f++)
+  {
+    for (t = 0U; t < sizeof(transmits) / sizeof(transmits[0]); t++)
+    {
+#if HTTP_ZERO_COPY_RESPONSE
+      /* Fallback buffer is smaller than a region */
+      if (1U != transmits[t] && 0U == test->framed)
+      {
+        continue;
+      }
+#endif
+      ++(*runs);
+      if (0 != Test_Run(test, fragments[f], transmits[t]))
+      {
+        ++failed;
+      }
+    }
+  }
+
+  return failed;
+}
+
+#if HTTP_KEEP_ALIVE_MAX_REQUESTS
+static int Test_Cap(
+    const tTestCapCase *cap,
+    tTestCase *test)
+{
+  const size_t request = strlen(cap->request);
+  size_t input = 0U;
+  size_t expected = 0U;
+  unsigned int i;
+
+  for (i = 1U; i <= (unsigned int) HTTP_KEEP_ALIVE_MAX_REQUESTS; i++)
+  {
+    const char *answer = ((unsigned int) HTTP_KEEP_ALIVE_MAX_REQUESTS == i) ?
+        cap->closed : cap->kept;
+
+    if (sizeof(capInput) < input + request + sizeof(TEST_LATE) ||
+        sizeof(capExpected) <= expected + strlen(answer))
+    {
+      return -1;
+    }
+    memcpy(capInput + input, cap->request, request);
+    input += request;
+    strcpy(capExpected + expected, answer);
+    expected += strlen(answer);
+  }
+  /* Connection is closing, this one must be discarded */
+  strcpy(capInput + input, TEST_LATE);
+
+  test->name = cap->name;
+  test->input = capInput;
+  test->expected = capExpected;
+  test->framed = cap->framed;
+  return 0;
+}
+#endif